@@ -0,0 +1,82 @@
+#ifndef BTAGEFFMAP_H
+#define BTAGEFFMAP_H
+//-----------------------------------------------------------------------------
+// b-tag efficiency map in (pT, |eta|, flavour) with a file cache.
+//
+// Jets are counted per bin and hadron flavour (b, c, light), all and those
+// passing the working point; the efficiency is the ratio. A map is built as
+// a by-product of a nominal pass and saved to a small binary file whose name
+// is the key: sample, working point and a hash of the binning. Every job
+// writes its own partial map (writePart); a separate step adds them up into
+// the cache file (mergeBTagEff), which later runs with the same key load.
+//
+// File layout (native endianness): "BTEFF1\0\0", sample length and
+// characters, working point (double), number of pT and |eta| edges (int32),
+// the edges (double), then tagged and all counts (double) per flavour,
+// |eta| bin and pT bin.
+//-----------------------------------------------------------------------------
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+class BTagEffMap
+{
+ public:
+  enum flavour { kB, kC, kLight, nFlavours };
+
+  BTagEffMap() : wp_(0) {}
+  BTagEffMap(const std::string& sample, double wp,
+             const std::vector<double>& ptEdges,
+             const std::vector<double>& etaEdges);
+  ~BTagEffMap() {}
+
+  /// Flavour index from NanoAOD Jet_hadronFlavour (5 b, 4 c, else light).
+  static flavour fromHadronFlavour(int hadronFlavour)
+  { return hadronFlavour == 5 ? kB : (hadronFlavour == 4 ? kC : kLight); }
+
+  /// Count one jet. Out of range pT or |eta| go to the edge bins.
+  void fill(double pt, double absEta, flavour f, bool tagged, double w=1);
+
+  /// Tagged fraction in the bin of the jet, 0 for an empty bin.
+  double efficiency(double pt, double absEta, flavour f) const;
+
+  /// Jets counted, all bins and flavours.
+  double entries() const;
+
+  /// Cache file of this key in directory dir.
+  std::string fileName(const std::string& dir) const;
+
+  /// Partial map of job in directory dir, merged into fileName(dir) later.
+  std::string partName(const std::string& dir, const std::string& job) const
+  { return fileName(dir) + "." + job; }
+
+  /// Save to fileName(dir), through a temporary file renamed at the end.
+  void write(const std::string& dir) const { save(fileName(dir)); }
+
+  /// Save to partName(dir, job), the same way.
+  void writePart(const std::string& dir, const std::string& job) const
+  { save(partName(dir, job)); }
+
+  /// Load fileName(dir) if it exists and has the same key; false otherwise
+  /// (the map is left untouched).
+  bool read(const std::string& dir);
+
+  /// Load the map saved in file path, with its key; false if it can't be
+  /// read (the map is left untouched).
+  bool load(const std::string& path);
+
+  /// Add the counts of a map with the same key.
+  void add(const BTagEffMap& other);
+
+ private:
+  std::string sample_;
+  double wp_;
+  std::vector<double> ptEdges_, etaEdges_;
+  std::vector<double> tagged_, all_;   // [flavour][eta][pt]
+
+  int index(double pt, double absEta, flavour f) const;
+  uint64_t binningHash() const;
+  void save(const std::string& path) const;
+};
+
+#endif
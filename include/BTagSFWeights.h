@@ -0,0 +1,47 @@
+#ifndef BTAGSFWEIGHTS_H
+#define BTAGSFWEIGHTS_H
+//-----------------------------------------------------------------------------
+// Per-event b-tag scale-factor weights (efficiency method).
+//
+//   w = prod_tagged SF  *  prod_untagged (1 - SF eff) / (1 - eff)
+//
+// for the nominal SF and SF +- its uncertainty. The jets of an event are
+// appended to flat arrays (efficiency, SF, SF uncertainty, tag flag). The
+// per-jet factors tag * SF + (1 - tag) * (1 - SF eff) / (1 - eff) of the
+// three weights are computed in a branch-free loop over these arrays, which
+// the compiler vectorizes (Makefile: -ftree-vectorize -fno-trapping-math), and multiplied in
+// blocks of 16 jets, each block adding one log to the weight (no log per
+// jet, no under/overflow of long products).
+//-----------------------------------------------------------------------------
+#include <vector>
+
+class BTagSFWeights
+{
+ public:
+  enum { kNominal, kUp, kDown, nWeights };
+
+  BTagSFWeights() { clear(); }
+  ~BTagSFWeights() {}
+
+  /// Start a new event.
+  void clear();
+
+  /// Append a jet: efficiency in MC, nominal SF, SF uncertainty, tagged.
+  void add(float eff, float sf, float sfUnc, bool tagged);
+
+  /// Compute the weights of the jets added since clear().
+  void compute();
+
+  int size() const { return (int)eff_.size(); }
+  /// log of weight k (after compute()).
+  double logWeight(int k) const { return logw_[k]; }
+  /// Weight k (after compute()).
+  double weight(int k) const;
+
+ private:
+  std::vector<float> eff_, sf_, unc_, tag_;
+  std::vector<double> factor_;   // nWeights rows of size() factors
+  double logw_[nWeights];
+};
+
+#endif
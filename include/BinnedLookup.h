@@ -0,0 +1,67 @@
+#ifndef BINNEDLOOKUP_H
+#define BINNEDLOOKUP_H
+//-----------------------------------------------------------------------------
+// Flat lookup table copied from a TH1 or TH2 (e.g. JES uncertainties).
+//
+// The bin contents, under- and overflow included, go into one contiguous
+// array at construction. A lookup is an index computation on each axis
+// (same formula as TAxis::FindBin for fixed bins, a binary search on the
+// edges for variable bins) and one load; no virtual call, no ROOT object.
+// value(x) == hist->GetBinContent(hist->FindBin(x)) for every x.
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <algorithm>
+#include "TH1.h"
+#include "TH2.h"
+
+class BinnedLookup
+{
+ public:
+  BinnedLookup() {}
+  /// One-dimensional table (x axis of hist).
+  explicit BinnedLookup(const TH1* hist);
+  /// Two-dimensional table (x and y axes of hist).
+  explicit BinnedLookup(const TH2* hist);
+
+  /// Content of the bin of x, 1-d table.
+  float value(double x) const
+  {
+    return values_[x_.bin(x)];
+  }
+
+  /// Content of the bin of (x, y), 2-d table.
+  float value(double x, double y) const
+  {
+    return values_[y_.bin(y) * (x_.nbins + 2) + x_.bin(x)];
+  }
+
+  /// out[i] = value(x[i]) for n values.
+  void values(const float* x, int n, float* out) const;
+  /// out[i] = value(x[i], y[i]) for n values.
+  void values(const float* x, const float* y, int n, float* out) const;
+
+  bool empty() const { return values_.empty(); }
+
+ private:
+  struct axis
+  {
+    int nbins;
+    double low, high;
+    std::vector<double> edges;   // empty for fixed bins
+
+    void set(const TAxis* a);
+
+    int bin(double x) const
+    {
+      if ( x < low ) return 0;
+      if ( !(x < high) ) return nbins + 1;  // NaN too, as TAxis::FindBin
+      if ( edges.empty() ) return 1 + int(nbins * (x - low) / (high - low));
+      return std::upper_bound(edges.begin(), edges.end(), x) - edges.begin();
+    }
+  };
+
+  axis x_, y_;
+  std::vector<float> values_;
+};
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef BOOTSTRAPHIST_H
+#define BOOTSTRAPHIST_H
+//-----------------------------------------------------------------------------
+// Poisson bootstrap replicas of fixed-binning histograms.
+//
+// Every event enters replica r with an integer weight drawn from Poisson(1).
+// The draws come from a counter-based generator keyed by (run, lumi, event,
+// r): no generator state, so an event gets the same replica weights whatever
+// the job splitting, event order or thread, and the replicas can be merged
+// like ordinary histograms. The spread of a quantity over the replicas
+// (e.g. an efficiency, a ratio of two bins) estimates its statistical
+// uncertainty.
+//
+// Storage is bin-major like MultiWeightHist but keeps sums of weights only
+// (no sumw2, the spread over the replicas is the uncertainty); the replica
+// weights of an event are computed once and kept as bytes.
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <stdint.h>
+#include "TH2D.h"
+#include "TString.h"
+#include "HistAccumulator.h"
+
+/// Poisson(1) weights of replicas 0..n-1 for one event.
+void poissonReplicaWeights(unsigned int run, unsigned int lumi, long event,
+                           int n, unsigned char* weights);
+
+class BootstrapHist
+{
+ public:
+  BootstrapHist() {}
+  ~BootstrapHist() {}
+
+  /// Book a histogram with nreplicas replicas, returns its handle.
+  int book(int nbins, double low, double high, int nreplicas);
+
+  int size() const { return (int)axes_.size(); }
+  int getnReplicas(int h) const { return nreplicas_[h]; }
+
+  /// Same binning as HistAccumulator::findBin (and TH1::FindFixBin).
+  inline int findBin(int h, double x) const
+  {
+    const HistAccumulator::axis& a = axes_[h];
+    if ( x < a.low ) return 0;
+    if ( !(x < a.high) ) return a.nbins + 1;
+    return 1 + int(a.nbins * (x - a.low) / a.width);
+  }
+
+  /// Fill replica r of histogram h with w * replicaWeights[r].
+  void fill(int h, double x, double w, const unsigned char* replicaWeights);
+
+  /// Zero all contents, keep the booking.
+  void reset();
+
+  /// Remove everything, bookings included.
+  void clear();
+
+  double getBinContent(int h, int bin, int r) const
+  { return sumw_[offsets_[h] + bin*nreplicas_[h] + r]; }
+
+  /// New TH2D (in the current directory): x is the histogram axis, y the
+  /// replica (bin r+1 holds replica r).
+  TH2D* makeTH2D(int h, const TString& name, const TString& title) const;
+
+ private:
+  std::vector<HistAccumulator::axis> axes_;
+  std::vector<int>    nreplicas_;
+  std::vector<size_t> offsets_;
+  std::vector<double> sumw_;
+};
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef CACHEDP4_H
+#define CACHEDP4_H
+
+#include <cmath>
+#include <algorithm>
+#include "TVector3.h"
+#include "TLorentzVector.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// CachedP4
+//
+// Light-weight four-vector used by the analysis objects in place of
+// TLorentzVector. The cartesian components are the state; pt, eta, phi and
+// mass are cached next to them and are refreshed only when the components
+// change (setPxPyPzE, setPtEtaPhiM, +=, -=), so the many kinematic reads done
+// per event cost a load instead of a sqrt/atan2/log.
+//
+// The class has no virtual table and no TObject base; it is standard layout
+// and trivially copyable. Use getTLorentzVector() / Vect() at interfaces that
+// still expect ROOT types.
+////////////////////////////////////////////////////////////////////////////////
+
+class CachedP4 {
+ public:
+    CachedP4() = default;
+
+    static CachedP4 fromPtEtaPhiM(const double pt, const double eta, const double phi, const double m){
+	CachedP4 p4;
+	p4.setPtEtaPhiM(pt, eta, phi, m);
+	return p4;
+    }
+
+    static CachedP4 fromPxPyPzE(const double px, const double py, const double pz, const double e){
+	CachedP4 p4;
+	p4.setPxPyPzE(px, py, pz, e);
+	return p4;
+    }
+
+    // Same conventions as TLorentzVector::SetPtEtaPhiM. The input pt, eta,
+    // phi and mass are cached as given, no need to recompute them.
+    void setPtEtaPhiM(double pt, const double eta, const double phi, const double m){
+	pt = std::fabs(pt);
+	_px = pt*std::cos(phi);
+	_py = pt*std::sin(phi);
+	_pz = pt*std::sinh(eta);
+	const double p2 = _px*_px + _py*_py + _pz*_pz;
+	_E  = m >= 0 ? std::sqrt(p2 + m*m) : std::sqrt(std::max(p2 - m*m, 0.));
+	_pt = pt;
+	_eta = eta;
+	_phi = phi;
+	_m = m;
+    }
+
+    void setPxPyPzE(const double px, const double py, const double pz, const double e){
+	_px = px;
+	_py = py;
+	_pz = pz;
+	_E  = e;
+	updateCache();
+    }
+
+    double Px() const { return _px; }
+    double Py() const { return _py; }
+    double Pz() const { return _pz; }
+    double E()  const { return _E; }
+    float Pt()  const { return _pt; }
+    float Eta() const { return _eta; }
+    float Phi() const { return _phi; }
+    float M()   const { return _m; }
+    double P()  const { return std::sqrt(_px*_px + _py*_py + _pz*_pz); }
+
+    TVector3 Vect() const { return TVector3(_px, _py, _pz); }
+    TLorentzVector getTLorentzVector() const { return TLorentzVector(_px, _py, _pz, _E); }
+
+    // Delta phi folded into [-pi, pi).
+    float DeltaPhi(const CachedP4 & other) const {
+	double dPhi = _phi - other._phi;
+	while(dPhi >= M_PI) dPhi -= 2.*M_PI;
+	while(dPhi < -M_PI) dPhi += 2.*M_PI;
+	return dPhi;
+    }
+
+    float DeltaR(const CachedP4 & other) const {
+	const double dEta = _eta - other._eta;
+	const double dPhi = DeltaPhi(other);
+	return std::sqrt(dEta*dEta + dPhi*dPhi);
+    }
+
+    // cos of the opening angle between the two three-momenta.
+    double CosTheta(const CachedP4 & other) const {
+	const double norm = std::sqrt((_px*_px + _py*_py + _pz*_pz)*(other._px*other._px + other._py*other._py + other._pz*other._pz));
+	if(norm <= 0) return 1.;
+	const double cosTheta = (_px*other._px + _py*other._py + _pz*other._pz)/norm;
+	return std::max(-1., std::min(1., cosTheta));
+    }
+
+    CachedP4 & operator+=(const CachedP4 & other){
+	setPxPyPzE(_px + other._px, _py + other._py, _pz + other._pz, _E + other._E);
+	return *this;
+    }
+
+    CachedP4 & operator-=(const CachedP4 & other){
+	setPxPyPzE(_px - other._px, _py - other._py, _pz - other._pz, _E - other._E);
+	return *this;
+    }
+
+    friend CachedP4 operator+(const CachedP4 & a, const CachedP4 & b){
+	return fromPxPyPzE(a._px + b._px, a._py + b._py, a._pz + b._pz, a._E + b._E);
+    }
+
+    friend CachedP4 operator-(const CachedP4 & a, const CachedP4 & b){
+	return fromPxPyPzE(a._px - b._px, a._py - b._py, a._pz - b._pz, a._E - b._E);
+    }
+
+ private:
+    // Conventions follow TLorentzVector: phi = 0 and eta = 0 for a null
+    // vector, eta = +-1e10 along the beam, negative mass for space-like.
+    void updateCache(){
+	const double pt2 = _px*_px + _py*_py;
+	_pt  = std::sqrt(pt2);
+	_phi = (_px == 0 && _py == 0) ? 0. : std::atan2(_py, _px);
+	if(_pt > 0)        _eta = std::asinh(_pz/_pt);
+	else if(_pz == 0)  _eta = 0.;
+	else               _eta = _pz > 0 ? 10e10 : -10e10;
+	const double m2 = _E*_E - pt2 - _pz*_pz;
+	_m = m2 < 0 ? -std::sqrt(-m2) : std::sqrt(m2);
+    }
+
+    double _px = 0., _py = 0., _pz = 0., _E = 0.;
+    float  _pt = 0., _eta = 0., _phi = 0., _m = 0.;
+};
+
+#endif
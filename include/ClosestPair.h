@@ -0,0 +1,78 @@
+#ifndef CLOSESTPAIR_H
+#define CLOSESTPAIR_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "CachedP4.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Closest-pair kernels for resonance-window cuts (e.g. the hadronic W).
+//
+// closestPairSum     : pair of values whose sum is closest to a target.
+//                      Sort + two pointers, O(n log n) instead of O(n^2).
+// closestPairInvMass : pair of jets whose invariant mass is closest to a
+//                      target, straight loop over a structure of arrays
+//                      (m^2 = m1^2 + m2^2 + 2(E1E2 - p1.p2), no temporaries).
+//
+// Both return 0 when fewer than two entries are given.
+////////////////////////////////////////////////////////////////////////////////
+
+struct jetSoA {
+    std::vector<float> px, py, pz, E, mass;
+
+    void clear(){
+	px.clear(); py.clear(); pz.clear(); E.clear(); mass.clear();
+    }
+
+    void add(const CachedP4 & p4){
+	px.push_back(p4.Px());
+	py.push_back(p4.Py());
+	pz.push_back(p4.Pz());
+	E.push_back(p4.E());
+	mass.push_back(p4.M());
+    }
+
+    int size() const {
+	return mass.size();
+    }
+};
+
+// scratch is a caller-owned buffer, reused to avoid allocating per call.
+inline float closestPairSum(const std::vector<float> & values, const float target, std::vector<float> & scratch){
+    if(values.size() < 2) return 0.;
+    scratch.assign(values.begin(), values.end());
+    std::sort(scratch.begin(), scratch.end());
+    int low = 0, high = scratch.size() - 1;
+    float bestSum = scratch[low] + scratch[high];
+    while(low < high){
+	const float sum = scratch[low] + scratch[high];
+	if(std::fabs(sum - target) < std::fabs(bestSum - target)) bestSum = sum;
+	if(sum < target) low++;
+	else if(sum > target) high--;
+	else break;
+    }
+    return bestSum;
+}
+
+inline float closestPairInvMass(const jetSoA & jets, const float target){
+    const int n = jets.size();
+    if(n < 2) return 0.;
+    const float * px = jets.px.data(), * py = jets.py.data(), * pz = jets.pz.data(), * E = jets.E.data(), * m = jets.mass.data();
+    float bestMass = 0., bestDiff = -1.;
+    for(int i = 0; i < n; i++){
+	const float m2i = m[i]*m[i];
+	for(int j = i+1; j < n; j++){
+	    const float m2 = m2i + m[j]*m[j] + 2.f*(E[i]*E[j] - px[i]*px[j] - py[i]*py[j] - pz[i]*pz[j]);
+	    const float mass = m2 > 0 ? std::sqrt(m2) : 0.f;
+	    const float diff = std::fabs(mass - target);
+	    if(bestDiff < 0 || diff < bestDiff){
+		bestDiff = diff;
+		bestMass = mass;
+	    }
+	}
+    }
+    return bestMass;
+}
+
+#endif
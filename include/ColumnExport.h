@@ -0,0 +1,69 @@
+#ifndef COLUMNEXPORT_H
+#define COLUMNEXPORT_H
+//-----------------------------------------------------------------------------
+// Columnar float32 export of per-event features.
+//
+// Every column goes to its own NumPy file <prefix>_<name>.npy (a 1-d '<f4'
+// array), so training code can memory-map a column with
+// numpy.load(path, mmap_mode='r') without ROOT. Rows are buffered and
+// appended chunk by chunk during the event loop; the npy header has a fixed
+// size and is rewritten with the final row count on close.
+// <prefix>_columns.txt lists the rows and the column names in order.
+// Values are exported at full float precision: a column of a Float16 ('f')
+// tree branch holds the value before the tree rounds it to 12 mantissa bits.
+//-----------------------------------------------------------------------------
+#include <string>
+#include <vector>
+#include <cstdio>
+
+class ColumnExporter
+{
+ public:
+  ColumnExporter(const std::string& prefix,
+                 const std::vector<std::string>& columns,
+                 int chunkRows=4096);
+  ~ColumnExporter();
+
+  /// Append one row (one value per column, in column order).
+  void fill(const float* values);
+
+  /// Flush the last chunk and finalize the headers (called by the
+  /// destructor if needed).
+  void close();
+
+  long rows() const { return rows_; }
+  int columns() const { return (int)names_.size(); }
+  /// File of column c.
+  std::string path(int c) const;
+
+ private:
+  std::string prefix_;
+  std::vector<std::string> names_;
+  std::vector<FILE*> files_;
+  std::vector<float> buffer_;   // column-major, chunkRows_ rows per column
+  int chunkRows_;
+  int buffered_;
+  long rows_;
+
+  void flush();
+};
+
+/// Read-only memory map of a 1-d float32 npy file.
+class NpyColumn
+{
+ public:
+  explicit NpyColumn(const std::string& path);
+  ~NpyColumn();
+
+  long size() const { return size_; }
+  const float* data() const { return data_; }
+  float operator[](long i) const { return data_[i]; }
+
+ private:
+  void* map_;
+  size_t mapSize_;
+  const float* data_;
+  long size_;
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef CUTGRIDSCAN_H
+#define CUTGRIDSCAN_H
+//-----------------------------------------------------------------------------
+// Single-pass scan of a grid of cut values.
+//
+// Two kinds of axes:
+//   object axes  - values that change the object definitions (jet pT
+//                  threshold, b-tag working point); the caller evaluates the
+//                  event once per combination of their values (an "outer"
+//                  cell) into a small feature record,
+//   cut axes     - event-level cuts "feature >= value"; one per feature.
+//
+// fill() puts the event weight in one bucket per outer cell (for each cut
+// axis, the number of grid values passed), independent of the grid size.
+// finalize() turns the buckets into suffix (reverse cumulative) sums along
+// every cut axis, after which each cell holds the yield passing all its
+// thresholds. Cost: events x outer cells + table size, instead of events x
+// grid points.
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <string>
+#include "TString.h"
+
+class CutGridScan
+{
+ public:
+  CutGridScan() : finalized_(false) {}
+  ~CutGridScan() {}
+
+  /// Axis changing the object definitions, returns its index.
+  int addObjectAxis(const std::string& name, const std::vector<double>& values);
+
+  /// Cut "feature >= value" over increasing values, returns the feature index.
+  int addCutAxis(const std::string& name, const std::vector<double>& values);
+
+  /// Allocate the table, after the axes are added.
+  void book();
+
+  /// Number of outer cells (product of the object axis sizes).
+  int nOuter() const { return nouter_; }
+
+  /// Outer cell of object axis indices idx[0..], first axis slowest.
+  int outerIndex(const std::vector<int>& idx) const;
+
+  /// Add an event evaluated in outer cell o with features[d] for cut axis d.
+  void fill(int o, const double* features, double w);
+
+  /// Cumulative sums along the cut axes. No fills afterwards.
+  void finalize();
+
+  /// Yield (and sum of squared weights) passing cut values idx[d] in outer
+  /// cell o, after finalize().
+  double getYield(int o, const std::vector<int>& idx) const;
+  double getSumw2(int o, const std::vector<int>& idx) const;
+
+  /// Sum of the weights given to outer cell 0 (the denominator of the
+  /// efficiencies), after finalize().
+  double getTotal() const { return sumw_.empty() ? 0 : sumw_[0]; }
+
+  /** Write into the current directory: TH1D name with one bin per grid point
+      (object axes then cut axes in booking order, last axis fastest),
+      name_total, and one TH1D name_<axis> holding the values of each axis.
+  */
+  void write(const TString& name) const;
+
+ private:
+  struct axis
+  {
+    std::string name;
+    std::vector<double> values;
+  };
+  std::vector<axis> objectAxes_;
+  std::vector<axis> cutAxes_;
+  int nouter_;
+  std::vector<int> strides_;    // per cut axis, in buckets
+  int ncells_;                  // buckets per outer cell
+  std::vector<double> sumw_;
+  std::vector<double> sumw2_;
+  bool finalized_;
+
+  int cell(int o, const std::vector<int>& idx) const;
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef DELTARINDEX_H
+#define DELTARINDEX_H
+//-----------------------------------------------------------------------------
+// Per-event eta-phi index for deltaR queries and one-to-one matching.
+//
+// Directions are kept sorted in eta, so a radius query is a binary search
+// on the eta window followed by a deltaR check (with phi wrap-around) on
+// the few entries inside it. Indices returned are the insertion order.
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <functional>
+#include "tnm.h"
+
+class DeltaRIndex
+{
+ public:
+  DeltaRIndex() {}
+  ~DeltaRIndex() {}
+
+  /// Remove all entries (keeps the storage).
+  void clear();
+
+  /// Add a direction, returns its index.
+  int add(double eta, double phi);
+
+  /// Sort the entries in eta. Call after the last add(), before queries.
+  void build();
+
+  int size() const { return (int)entries_.size(); }
+  double eta(int index) const { return eta_[index]; }
+  double phi(int index) const { return phi_[index]; }
+
+  /// Indices of all entries with deltaR < radius from (eta, phi).
+  void query(double eta, double phi, double radius,
+             std::vector<int>& found) const;
+
+  /// Index of the closest entry with deltaR < radius, -1 if none.
+  int nearest(double eta, double phi, double radius,
+              double* distance=0) const;
+
+ private:
+  struct entry
+  {
+    double eta;
+    double phi;
+    int index;
+    bool operator<(const entry& o) const { return eta < o.eta; }
+  };
+  std::vector<entry> entries_;
+  std::vector<double> eta_;
+  std::vector<double> phi_;
+};
+
+/// deltaR with phi folded into [0, pi].
+double deltaRWrapped(double eta1, double phi1, double eta2, double phi2);
+
+/** One-to-one matching of "from" to "to" entries: all pairs closer than
+    radius (and passing accept(from, to), if given) are taken in increasing
+    deltaR, skipping entries already used. Returns (from, to, deltaR).
+*/
+std::vector<matchedPair>
+matchOneToOne(const DeltaRIndex& from, const DeltaRIndex& to, double radius,
+              const std::function<bool(int, int)>& accept=nullptr);
+
+/// Same for ptThings, consistent with ptThing::matches(thing, drcut).
+std::vector<matchedPair>
+matchOneToOne(std::vector<ptThing>& v1, std::vector<ptThing>& v2,
+              double drcut=0.4);
+
+#endif
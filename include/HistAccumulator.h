@@ -0,0 +1,137 @@
+#ifndef HISTACCUMULATOR_H
+#define HISTACCUMULATOR_H
+//-----------------------------------------------------------------------------
+// Fixed-binning histogram storage.
+//
+// All histograms booked in one accumulator share contiguous sumw / sumw2
+// arrays (nbins + 2 slots each, under- and overflow included, same bin
+// numbering as TH1). Filling is a bin computation on a uniform axis and two
+// additions; TH1F objects are only created when the results are written.
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <atomic>
+#include <functional>
+#include "TH1F.h"
+#include "TString.h"
+
+class HistAccumulator
+{
+ public:
+  struct axis
+  {
+    int nbins;
+    double low;
+    double high;
+    double width;   // high - low
+  };
+
+  HistAccumulator() {}
+  ~HistAccumulator() {}
+
+  /// Book a histogram with a uniform axis, returns its handle.
+  int book(int nbins, double low, double high);
+
+  int size() const { return (int)axes_.size(); }
+  const axis& getAxis(int h) const { return axes_[h]; }
+
+  /// Bin number as TH1::FindFixBin (0 underflow, nbins+1 overflow / NaN),
+  /// with the same floating point expression so edges agree exactly.
+  inline int findBin(int h, double x) const
+  {
+    const axis& a = axes_[h];
+    if ( x < a.low ) return 0;
+    if ( !(x < a.high) ) return a.nbins + 1;
+    return 1 + int(a.nbins * (x - a.low) / a.width);
+  }
+
+  /// Same bookkeeping as TH1::Fill(x, w) with Sumw2 enabled.
+  inline void fill(int h, double x, double w)
+  {
+    int bin = findBin(h, x);
+    size_t slot = offsets_[h] + bin;
+    sumw_[slot]  += w;
+    sumw2_[slot] += w*w;
+    entries_[h]  += 1;
+    if ( bin == 0 || bin > axes_[h].nbins ) return;
+    double* stats = &stats_[4*h];
+    stats[0] += w;
+    stats[1] += w*w;
+    stats[2] += w*x;
+    stats[3] += w*x*x;
+  }
+
+  /** Fill histogram h with n (value, weight) pairs. Bin numbers are
+      computed for the whole block in one branch-free loop over the uniform
+      axis (vectorized), then scatter-added. Same result as n fill() calls.
+  */
+  void fillN(int h, int n, const double* x, const double* w);
+
+  /// Add the content of an accumulator with the same booking.
+  void add(const HistAccumulator& other);
+
+  /// Zero all contents, keep the booking.
+  void reset();
+
+  /// Remove everything, bookings included.
+  void clear();
+
+  /// Same booking, zero content.
+  HistAccumulator emptyCopy() const;
+
+  double getBinContent(int h, int bin) const { return sumw_[offsets_[h] + bin]; }
+  double getBinSumw2(int h, int bin) const { return sumw2_[offsets_[h] + bin]; }
+  double getEntries(int h) const { return entries_[h]; }
+  /// sumw, sumw2, sumwx, sumwx2 of the in-range fills (TH1::GetStats order).
+  const double* getStats(int h) const { return &stats_[4*h]; }
+
+  /// New TH1F (in the current directory) holding histogram h.
+  TH1F* makeTH1F(int h, const TString& name, const TString& title) const;
+
+ private:
+  std::vector<axis>   axes_;
+  std::vector<size_t> offsets_;
+  std::vector<double> sumw_;
+  std::vector<double> sumw2_;
+  std::vector<double> entries_;
+  std::vector<double> stats_;   // sumw, sumw2, sumwx, sumwx2 per histogram
+  std::vector<int>    bins_;    // fillN scratch
+};
+
+/** Deterministic reduction for parallel filling.
+
+    The event range is cut into a fixed number of slices, independent of
+    the number of threads. Workers take whole slices (atomic counter, no
+    locks) and fill each one, in event order, into that slice's own
+    accumulator; merge() then adds the slices in slice order. Every sum is
+    therefore evaluated in the same order for any number of workers, and
+    the merged result is bit-identical.
+*/
+class HistSlices
+{
+ public:
+  HistSlices(const HistAccumulator& booking, long nevents, int nslices=64);
+  ~HistSlices() {}
+
+  int size() const { return (int)slices_.size(); }
+  long begin(int s) const { return nevents_ * s / size(); }
+  long end(int s) const { return nevents_ * (s + 1) / size(); }
+  HistAccumulator& slice(int s) { return slices_[s]; }
+
+  /// Next slice to fill, -1 when all are taken. Thread safe.
+  int next() { int s = next_++; return s < size() ? s : -1; }
+
+  /// Fill all slices with nthreads workers calling
+  /// fillSlice(accumulator, firstEvent, lastEvent + 1).
+  void run(int nthreads,
+           const std::function<void(HistAccumulator&, long, long)>& fillSlice);
+
+  /// Add the slices to total, in slice order.
+  void merge(HistAccumulator& total) const;
+
+ private:
+  std::vector<HistAccumulator> slices_;
+  std::atomic<int> next_;
+  long nevents_;
+};
+
+#endif
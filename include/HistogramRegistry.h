@@ -0,0 +1,289 @@
+#ifndef HISTOGRAMREGISTRY_H
+#define HISTOGRAMREGISTRY_H
+
+#include <vector>
+#include <functional>
+#include "TDirectory.h"
+#include "TString.h"
+#include "HistAccumulator.h"
+#include "MultiWeightHist.h"
+#include "BootstrapHist.h"
+#include "QuantileSketch.h"
+#include "TVectorD.h"
+#include "tnm.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Declarative histogram booking.
+//
+// A histogram is a definition: name, title, binning, output directory, value
+// expression and optional selection and weight. Definitions are kept in
+// booking order and index the same HistAccumulator, so the per-event fill is
+// one loop over plain data (no TH1 objects until write()).
+//
+// Definitions without a value expression are filled by hand with
+// fill(handle, x, w) (e.g. from inside the selection).
+//
+// With setBlockSize(n) the per-event fill only evaluates and buffers the
+// (value, weight) pairs; every n events each histogram is filled from its
+// buffer with HistAccumulator::fillN. Contents are the same as with the
+// immediate fill. write() flushes the last, partial block.
+//
+// Systematic variations are an extra axis: setVariations() (before booking)
+// gives every definition one histogram per variation, and each fill goes to
+// the variation passed along. Variation v is written as name+suffix[v].
+//
+// Weight sets (LHE scale / PDF, parton shower weights) are another: with
+// addWeightSet() every definition also gets one copy per weight of the set,
+// filled by the nominal fills with weight*w[k], w being the event's weights
+// given to setWeights(). The value is evaluated once for all copies. A set is
+// written as one TH2D name_set (x, weight index) next to the nominal.
+// Poisson bootstrap replicas (setBootstrap()) are filled the same way, with
+// the event's replica weights, and written as name_bootstrap.
+//
+// With setSketches(k) the nominal values of every definition also go into a
+// quantile sketch (first pass for data-driven binnings): written as
+// name_sketch (serialized, mergeable) and name_sketchBinned, filled with
+// equal-population bins (same number as booked, no narrower than a quarter
+// of the booked bin width).
+////////////////////////////////////////////////////////////////////////////////
+
+template <class Event>
+class HistogramRegistry {
+ public:
+    typedef std::function<double(Event *)> valueFunc;
+    typedef std::function<bool(Event *)> selectFunc;
+
+    struct definition {
+	TString name, title;
+	int dir;
+	valueFunc value;
+	selectFunc select;
+	valueFunc weight;
+    };
+
+    // Suffixes of the variations, the first one being the nominal (usually "").
+    void setVariations(const std::vector<TString> & suffixes){
+	if(!_defs.empty() || suffixes.empty()) error("HistogramRegistry::setVariations - call once before booking");
+	_suffixes = suffixes;
+    }
+
+    // Weight set of nweights copies, call before booking.
+    int addWeightSet(const TString & name, const int nweights){
+	if(!_defs.empty()) error("HistogramRegistry::addWeightSet - call before booking");
+	weightSet set;
+	set.name = name;
+	set.nweights = nweights;
+	_weightSets.push_back(set);
+	return _weightSets.size() - 1;
+    }
+
+    // Weights of the current event for a set; the vector must stay valid until the fills are done.
+    void setWeights(const int set, const std::vector<float> & weights){
+	_weightSets[set].weights = weights.empty() ? nullptr : &weights[0];
+	_weightSets[set].n = weights.size();
+    }
+
+    // Bootstrap replicas of every definition, call before booking.
+    void setBootstrap(const int nreplicas){
+	if(!_defs.empty()) error("HistogramRegistry::setBootstrap - call before booking");
+	_nReplicas = nreplicas;
+    }
+
+    // Replica weights of the current event (see poissonReplicaWeights), valid until the fills are done.
+    void setReplicaWeights(const unsigned char * weights){
+	_replicaWeights = weights;
+    }
+
+    // Quantile sketch of every definition, call before booking.
+    void setSketches(const int k){
+	if(!_defs.empty()) error("HistogramRegistry::setSketches - call before booking");
+	_sketchK = k;
+    }
+
+    int book(int dir, const TString & name, const TString & title, int nbins, double low, double high,
+	     valueFunc value = nullptr, selectFunc select = nullptr, valueFunc weight = nullptr){
+	definition def = {name, title, dir, value, select, weight};
+	_defs.push_back(def);
+	for(unsigned v = 0; v < _suffixes.size(); v++) _hists.book(nbins, low, high);
+	for(auto & set : _weightSets) set.hists.book(nbins, low, high, set.nweights);
+	if(_nReplicas > 0) _bootstrap.book(nbins, low, high, _nReplicas);
+	if(_sketchK > 0) _sketches.push_back(QuantileSketch(_sketchK));
+	if(value) _autoFill.push_back(_defs.size() - 1);
+	return _defs.size() - 1;
+    }
+
+    // Value read from a variable that is set before each fill.
+    template <class T>
+    int book(int dir, const TString & name, const TString & title, int nbins, double low, double high,
+	     const T * source, selectFunc select = nullptr){
+	return book(dir, name, title, nbins, low, high, [source](Event *){ return (double)*source; }, select);
+    }
+
+    void clear(){
+	_defs.clear();
+	_autoFill.clear();
+	_hists.clear();
+	_weightSets.clear();
+	_bootstrap.clear();
+	_nReplicas = 0;
+	_sketches.clear();
+	_sketchK = 0;
+	_blockX.clear();
+	_blockW.clear();
+	_blockCount.clear();
+	_blockEvents = 0;
+    }
+
+    // Events per block, 0 fills immediately.
+    void setBlockSize(const int n){
+	flush();
+	_blockSize = n;
+    }
+
+    // Fill every definition with a value expression for this event.
+    void fill(Event * ev, const double weight, const int variation = 0){
+	const unsigned nAuto = _autoFill.size(), nVar = _suffixes.size();
+	if(_blockSize > 0 && _blockCount.size() != nAuto*nVar){
+	    flush();
+	    _blockX.assign(nAuto*nVar*_blockSize, 0.);
+	    _blockW.assign(nAuto*nVar*_blockSize, 0.);
+	    _blockCount.assign(nAuto*nVar, 0);
+	}
+	const bool copies = variation == 0 && (!_weightSets.empty() || _nReplicas > 0 || _sketchK > 0);
+	for(unsigned k = 0; k < nAuto; k++){
+	    const int h = _autoFill[k];
+	    const definition & def = _defs[h];
+	    if(def.select && !def.select(ev)) continue;
+	    const double x = def.value(ev);
+	    const double w = def.weight ? weight*def.weight(ev) : weight;
+	    if(copies) fillCopies(h, x, w);
+	    if(_blockSize == 0){
+		_hists.fill(h*nVar + variation, x, w);
+		continue;
+	    }
+	    const int buffer = k*nVar + variation;
+	    const int slot = buffer*_blockSize + _blockCount[buffer]++;
+	    _blockX[slot] = x;
+	    _blockW[slot] = w;
+	}
+	if(_blockSize > 0 && ++_blockEvents == _blockSize) flush();
+    }
+
+    // Fill the buffered block into the histograms. A buffer never holds more
+    // than _blockSize values: at most one per fill(event) call.
+    void flush(){
+	const unsigned nVar = _suffixes.size();
+	for(unsigned buffer = 0; buffer < _blockCount.size(); buffer++){
+	    if(_blockCount[buffer] == 0) continue;
+	    const int h = _autoFill[buffer/nVar]*nVar + buffer%nVar;
+	    _hists.fillN(h, _blockCount[buffer], &_blockX[buffer*_blockSize], &_blockW[buffer*_blockSize]);
+	    _blockCount[buffer] = 0;
+	}
+	_blockEvents = 0;
+    }
+
+    // Same, into a worker's private accumulator (see HistSlices), weight sets
+    // and replicas not included; the definitions are only read, the value
+    // expressions must not share state.
+    void fill(Event * ev, const double weight, HistAccumulator & target, const int variation = 0) const {
+	const int nVar = _suffixes.size();
+	for(const int h : _autoFill){
+	    const definition & def = _defs[h];
+	    if(def.select && !def.select(ev)) continue;
+	    const double w = def.weight ? weight*def.weight(ev) : weight;
+	    target.fill(h*nVar + variation, def.value(ev), w);
+	}
+    }
+
+    void fill(const int h, const double x, const double w, const int variation = 0){
+	_hists.fill(h*_suffixes.size() + variation, x, w);
+	if(variation == 0) fillCopies(h, x, w);
+    }
+
+    // Convert one variation to TH1F and write into dirs[def.dir], in booking order.
+    void write(const std::vector<TDirectory *> & dirs, const int variation = 0){
+	flush();
+	const int nVar = _suffixes.size();
+	const TString & suffix = _suffixes[variation];
+	for(unsigned h = 0; h < _defs.size(); h++){
+	    dirs[_defs[h].dir]->cd();
+	    TH1F * hist = _hists.makeTH1F(h*nVar + variation, _defs[h].name+suffix, _defs[h].title+suffix);
+	    hist->Write();
+	    delete hist;
+	    if(variation != 0) continue;
+	    for(const auto & set : _weightSets){
+		TH2D * hist2 = set.hists.makeTH2D(h, _defs[h].name+"_"+set.name, _defs[h].title+" "+set.name);
+		hist2->Write();
+		delete hist2;
+	    }
+	    if(_nReplicas > 0){
+		TH2D * hist2 = _bootstrap.makeTH2D(h, _defs[h].name+"_bootstrap", _defs[h].title+" bootstrap");
+		hist2->Write();
+		delete hist2;
+	    }
+	    if(_sketchK > 0) writeSketch(h);
+	}
+    }
+
+    int size() const { return _defs.size(); }
+    int nVariations() const { return _suffixes.size(); }
+    const TString & getSuffix(const int variation) const { return _suffixes[variation]; }
+    const definition & getDefinition(const int h) const { return _defs[h]; }
+    // Accumulator index of (definition h, variation v) is h*nVariations() + v.
+    const HistAccumulator & getHists() const { return _hists; }
+    HistAccumulator & getHists() { return _hists; }
+    int nWeightSets() const { return _weightSets.size(); }
+    const MultiWeightHist & getWeightSetHists(const int set) const { return _weightSets[set].hists; }
+    const TString & getWeightSetName(const int set) const { return _weightSets[set].name; }
+    int getWeightSetSize(const int set) const { return _weightSets[set].nweights; }
+    const BootstrapHist & getBootstrapHists() const { return _bootstrap; }
+    const QuantileSketch & getSketch(const int h) const { return _sketches[h]; }
+
+ private:
+    std::vector<definition> _defs;
+    std::vector<int> _autoFill;
+    std::vector<TString> _suffixes{""};
+    HistAccumulator _hists;
+
+    struct weightSet {
+	TString name;
+	int nweights = 0;
+	MultiWeightHist hists; // same handles as the definitions
+	const float * weights = nullptr;
+	int n = 0;
+    };
+    std::vector<weightSet> _weightSets;
+
+    int _nReplicas = 0;
+    BootstrapHist _bootstrap; // same handles as the definitions
+    const unsigned char * _replicaWeights = nullptr;
+
+    int _sketchK = 0;
+    std::vector<QuantileSketch> _sketches; // same handles as the definitions
+
+    // Weight sets, bootstrap replicas and sketches, nominal fills only.
+    void fillCopies(const int h, const double x, const double w){
+	for(auto & set : _weightSets) set.hists.fill(h, x, w, set.n, set.weights);
+	if(_nReplicas > 0) _bootstrap.fill(h, x, w, _replicaWeights);
+	if(_sketchK > 0) _sketches[h].add(x);
+    }
+
+    void writeSketch(const int h){
+	const QuantileSketch & sketch = _sketches[h];
+	const HistAccumulator::axis & a = _hists.getAxis(h*_suffixes.size());
+	std::vector<double> data = sketch.serialize();
+	TVectorD stored(data.size());
+	for(unsigned i = 0; i < data.size(); i++) stored[i] = data[i];
+	stored.Write(_defs[h].name+"_sketch");
+	std::vector<double> edges = sketch.suggestEdges(a.nbins, 0.25*a.width/a.nbins);
+	if(edges.size() < 2) return;
+	TH1F * hist = sketch.makeTH1F(_defs[h].name+"_sketchBinned", _defs[h].title+" equal population", edges);
+	hist->Write();
+	delete hist;
+    }
+    int _blockSize = 0, _blockEvents = 0;
+    std::vector<double> _blockX, _blockW;
+    std::vector<int> _blockCount;
+};
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef JETVARIATIONPROVIDER_H
+#define JETVARIATIONPROVIDER_H
+
+#include <vector>
+#include <string>
+#include "eventBuffer.h"
+#include "tnm.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// JetVariationProvider
+//
+// Varied jet pT and mass from the NanoAOD per-jet branches
+// (Jet_pt_jesTotalUp/Down, Jet_pt_jerUp/Down and the Jet_mass_* ones), for
+// on-the-fly JES/JER variations of the same entry.
+//
+// The buffer is decoded once per entry (eventBuffer::fillObjects); setEvent()
+// only invalidates the views, and a view is built the first time it is asked
+// for in that entry, so variations that are not run cost nothing and the
+// variations share one decode.
+//
+// The branches are relative to Jet_pt_nom / Jet_mass_nom, which include the
+// nominal JER smearing; the view applies the ratio varied / nom to Jet_pt and
+// Jet_mass, the nominal of this analysis, so that only the variation itself
+// is added.
+////////////////////////////////////////////////////////////////////////////////
+
+class JetVariationProvider {
+ public:
+    enum source { kJESUp, kJESDown, kJERUp, kJERDown, nSources };
+
+    struct view {
+	std::vector<float> pt, mass; // per entry of eventBuffer::Jet
+    };
+
+    // New entry: call after eventBuffer::fillObjects.
+    void setEvent(const eventBuffer * ev){
+	_ev = ev;
+	for(int s = 0; s < nSources; s++) _ready[s] = false;
+    }
+
+    const view & get(const source s){
+	if(!_ready[s]) build(s);
+	return _views[s];
+    }
+
+ private:
+    const eventBuffer * _ev = nullptr;
+    view _views[nSources];
+    bool _ready[nSources] = {false, false, false, false};
+
+    void build(const source s){
+	if(!_ev) error("JetVariationProvider::get - no event");
+	const std::vector<eventBuffer::Jet_s> & jets = _ev->Jet;
+	if(_ev->Jet_pt_jesTotalUp.size() != jets.size() || _ev->Jet_pt_nom.size() != jets.size())
+	    error("JetVariationProvider - no Jet_pt_jesTotal/jer branches in the input");
+	view & v = _views[s];
+	v.pt.resize(jets.size());
+	v.mass.resize(jets.size());
+	for(unsigned i = 0; i < jets.size(); i++){
+	    const eventBuffer::Jet_s & jet = jets[i];
+	    float pt = jet.pt_nom, mass = jet.mass_nom;
+	    switch(s){
+	    case kJESUp:   pt = jet.pt_jesTotalUp;   mass = jet.mass_jesTotalUp;   break;
+	    case kJESDown: pt = jet.pt_jesTotalDown; mass = jet.mass_jesTotalDown; break;
+	    case kJERUp:   pt = jet.pt_jerUp;        mass = jet.mass_jerUp;        break;
+	    case kJERDown: pt = jet.pt_jerDown;      mass = jet.mass_jerDown;      break;
+	    default: break;
+	    }
+	    v.pt[i]   = jet.pt_nom > 0 ? jet.pt * (pt / jet.pt_nom) : jet.pt;
+	    v.mass[i] = jet.mass_nom > 0 ? jet.mass * (mass / jet.mass_nom) : jet.mass;
+	}
+	_ready[s] = true;
+    }
+};
+
+#endif
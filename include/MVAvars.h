@@ -10,11 +10,105 @@
 #include "AngularVariables.h"
 #include "MVAvarsBase.h"
 
+// event variables, in the order of Recolabels
+#define MVAVARS_EVT(VAR) \
+    VAR(Reco_best_higgs_mass) \
+    VAR(Reco_dEta_fn) \
+    VAR(Evt_CSV_min) \
+    VAR(Evt_CSV_min_tagged) \
+    VAR(Evt_CSV_avg) \
+    VAR(Evt_CSV_avg_tagged) \
+    VAR(Evt_CSV_dev) \
+    VAR(Evt_CSV_dev_tagged) \
+    VAR(Evt_h0) \
+    VAR(Evt_h1) \
+    VAR(Evt_h2) \
+    VAR(Evt_h3) \
+    VAR(Evt_M_Total) \
+    VAR(Evt_M3) \
+    VAR(Evt_M3_oneTagged) \
+    VAR(Evt_HT) \
+    VAR(Evt_HT_wo_MET) \
+    VAR(Evt_HT_jets) \
+    VAR(Evt_HT_tags) \
+    VAR(Evt_MHT) \
+    VAR(Evt_MET) \
+    VAR(Evt_MTW) \
+    VAR(Evt_blr) \
+    VAR(Evt_blr_transformed) \
+    VAR(Evt_M_JetsAverage) \
+    VAR(Evt_Eta_JetsAverage) \
+    VAR(Evt_Pt_JetsAverage) \
+    VAR(Evt_E_JetsAverage) \
+    VAR(Evt_M_TaggedJetsAverage) \
+    VAR(Evt_Eta_TaggedJetsAverage) \
+    VAR(Evt_Pt_TaggedJetsAverage) \
+    VAR(Evt_E_TaggedJetsAverage) \
+    VAR(Evt_M_UntaggedJetsAverage) \
+    VAR(Evt_Eta_UntaggedJetsAverage) \
+    VAR(Evt_Pt_UntaggedJetsAverage) \
+    VAR(Evt_E_UntaggedJetsAverage) \
+    VAR(Evt_M2_closestTo125TaggedJets) \
+    VAR(Evt_M2_closestTo91TaggedJets) \
+    VAR(Evt_M2_TaggedJetsAverage) \
+    VAR(Evt_Dr_TaggedJetsAverage) \
+    VAR(Evt_Deta_TaggedJetsAverage) \
+    VAR(Evt_M2_minDrTaggedJets) \
+    VAR(Evt_Dr_minDrTaggedJets) \
+    VAR(Evt_Pt_minDrTaggedJets) \
+    VAR(Evt_Dr_maxDrTaggedJets) \
+    VAR(Evt_Dr_closestTo91TaggedJets) \
+    VAR(Evt_M2_JetsAverage) \
+    VAR(Evt_Dr_JetsAverage) \
+    VAR(Evt_Deta_JetsAverage) \
+    VAR(Evt_M2_minDrJets) \
+    VAR(Evt_Dr_minDrJets) \
+    VAR(Evt_Pt_minDrJets) \
+    VAR(Evt_Dr_maxDrJets) \
+    VAR(Evt_M2_UntaggedJetsAverage) \
+    VAR(Evt_Dr_UntaggedJetsAverage) \
+    VAR(Evt_Deta_UntaggedJetsAverage) \
+    VAR(Evt_M2_minDrUntaggedJets) \
+    VAR(Evt_Dr_minDrUntaggedJets) \
+    VAR(Evt_Pt_minDrUntaggedJets) \
+    VAR(Evt_Dr_maxDrUntaggedJets) \
+    VAR(Evt_Deta_maxDetaJetJet) \
+    VAR(Evt_Deta_maxDetaTagTag) \
+    VAR(Evt_Deta_maxDetaJetTag) \
+    VAR(Evt_Dr_minDrLepTag) \
+    VAR(Evt_Dr_minDrLepJet) \
+    VAR(Evt_M_minDrLepTag) \
+    VAR(Evt_M_minDrLepJet) \
+    VAR(Evt_aplanarity) \
+    VAR(Evt_aplanarity_jets) \
+    VAR(Evt_aplanarity_tags) \
+    VAR(Evt_sphericity) \
+    VAR(Evt_sphericity_jets) \
+    VAR(Evt_sphericity_tags) \
+    VAR(Evt_transverse_sphericity) \
+    VAR(Evt_transverse_sphericity_jets) \
+    VAR(Evt_transverse_sphericity_tags) \
+    VAR(Evt_JetPt_over_JetE) \
+    VAR(Evt_TaggedJetPt_over_TaggedJetE) \
+    VAR(Reco_WLep_E) \
+    VAR(Reco_WLep_Eta) \
+    VAR(Reco_WLep_Phi) \
+    VAR(Reco_WLep_Pt) \
+    VAR(Reco_WLep_Mass)
+
 // class to evaluate lepton plus jets BDT set
 class MVAvars : public MVAvarsBase
 {
 
   public:
+    // variable indices, positions in Recolabels
+    enum variable {
+#define MVAVARS_EVT_INDEX(name) name,
+        MVAVARS_EVT(MVAVARS_EVT_INDEX)
+#undef MVAVARS_EVT_INDEX
+        nVariables
+    };
+
     MVAvars(const char* era="2018");
     ~MVAvars();
 
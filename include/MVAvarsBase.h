@@ -29,8 +29,9 @@ class MVAvarsBase
 
 
     // return the variable names and their values for the last evaluated event
-    std::map<std::string, float>& GetVariables();
-    float* GetAdress(std::string variablelabel){return &variableMap[variablelabel];}
+    std::map<std::string, float> GetVariables();
+    // address of a variable, to bind it to the TMVA reader (the only lookup by name)
+    float* GetAdress(std::string variablelabel);
     void SetWP(double WP);
     void SetLooseWP(double WPLoose);
 
@@ -48,11 +49,6 @@ class MVAvarsBase
                                 const TLorentzVector &metP4,
                                 const std::vector<int> &jets_idx);
 
-    virtual std::map<std::string, TLorentzVector> GetVectors(   const TLorentzVector &selectedLeptonP4,
-                                                                const std::vector<TLorentzVector> &selectedJetP4,
-                                                                const TLorentzVector &metP4,
-                                                                const std::vector<int> &jets_idx);
-
     virtual bool SkipEvent( const std::vector<TLorentzVector> &selectedJetP4,
                             const std::vector<double> &selectedJetCSV,
                             const std::vector<int> &jets_idx);
@@ -74,7 +70,17 @@ class MVAvarsBase
     void ResetVariableMap();
 
   protected:
-    std::map<std::string, float> variableMap;
+    // call once Recolabels is set: one float per label, at its default
+    void InitVariables();
+    float GetDefault(const std::string& variablelabel) const;
+
+    // values by position in Recolabels, the derived classes index them with
+    // their variable enum; the reader holds pointers into it, so it is sized
+    // once and never reallocated
+    std::vector<float> variables;
+    std::vector<float> defaults;
+    // bound labels that are not Recolabels, left at their default
+    std::map<std::string, float> extraVariables;
     std::vector<std::string> Recolabels;
 
     double btagMcut = -99;
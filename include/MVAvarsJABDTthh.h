@@ -11,11 +11,81 @@
 // define unique indizes
 enum tHHIndexes {tHH_btoplep_idx, tHH_btophad_idx, tHH_h1dau1_idx, tHH_h1dau2_idx, tHH_h2dau3_idx, tHH_h2dau4_idx};
 
+// variables of the tHH hypothesis, in the order of Recolabels
+#define MVAVARS_JABDT_THH(VAR) \
+    VAR(Reco_tHH_btoplep_m) \
+    VAR(Reco_tHH_btoplep_pt) \
+    VAR(Reco_tHH_btoplep_phi) \
+    VAR(Reco_tHH_btoplep_eta) \
+    VAR(Reco_tHH_btoplep_idx) \
+    VAR(Reco_tHH_btoplep_w_dr) \
+    VAR(Reco_tHH_btophad_m) \
+    VAR(Reco_tHH_btophad_pt) \
+    VAR(Reco_tHH_btophad_phi) \
+    VAR(Reco_tHH_btophad_eta) \
+    VAR(Reco_tHH_btophad_idx) \
+    VAR(Reco_tHH_toplep_m) \
+    VAR(Reco_tHH_toplep_pt) \
+    VAR(Reco_tHH_toplep_phi) \
+    VAR(Reco_tHH_toplep_eta) \
+    VAR(Reco_tHH_h1_m) \
+    VAR(Reco_tHH_h1_pt) \
+    VAR(Reco_tHH_h1_phi) \
+    VAR(Reco_tHH_h1_eta) \
+    VAR(Reco_tHH_h1_dr) \
+    VAR(Reco_tHH_h2_m) \
+    VAR(Reco_tHH_h2_pt) \
+    VAR(Reco_tHH_h2_phi) \
+    VAR(Reco_tHH_h2_eta) \
+    VAR(Reco_tHH_h2_dr) \
+    VAR(Reco_tHH_h1dau1_m) \
+    VAR(Reco_tHH_h1dau1_pt) \
+    VAR(Reco_tHH_h1dau1_phi) \
+    VAR(Reco_tHH_h1dau1_eta) \
+    VAR(Reco_tHH_h1dau2_m) \
+    VAR(Reco_tHH_h1dau2_pt) \
+    VAR(Reco_tHH_h1dau2_phi) \
+    VAR(Reco_tHH_h1dau2_eta) \
+    VAR(Reco_tHH_h1dau1_idx) \
+    VAR(Reco_tHH_h1dau2_idx) \
+    VAR(Reco_tHH_h2dau3_m) \
+    VAR(Reco_tHH_h2dau3_pt) \
+    VAR(Reco_tHH_h2dau3_phi) \
+    VAR(Reco_tHH_h2dau3_eta) \
+    VAR(Reco_tHH_h2dau4_m) \
+    VAR(Reco_tHH_h2dau4_pt) \
+    VAR(Reco_tHH_h2dau4_phi) \
+    VAR(Reco_tHH_h2dau4_eta) \
+    VAR(Reco_tHH_h2dau3_idx) \
+    VAR(Reco_tHH_h2dau4_idx) \
+    VAR(Reco_JABDT_tHH_Jet_CSV_btophad) \
+    VAR(Reco_JABDT_tHH_Jet_CSV_btoplep) \
+    VAR(Reco_JABDT_tHH_Jet_CSV_h1dau1) \
+    VAR(Reco_JABDT_tHH_Jet_CSV_h1dau2) \
+    VAR(Reco_JABDT_tHH_Jet_CSV_h2dau3) \
+    VAR(Reco_JABDT_tHH_Jet_CSV_h2dau4) \
+    VAR(Reco_JABDT_tHH_log_toplep_m) \
+    VAR(Reco_JABDT_tHH_log_toplep_pt) \
+    VAR(Reco_JABDT_tHH_log_h1_pt) \
+    VAR(Reco_JABDT_tHH_log_h1_m) \
+    VAR(Reco_JABDT_tHH_log_h2_pt) \
+    VAR(Reco_JABDT_tHH_log_h2_m)
+
 // class to provide a variable container for ttH jet assignment hypothesis testing
 class MVAvarsJABDTthh : public MVAvarsBase
 {
 
   public:
+    // variable indices, positions in Recolabels
+    enum variable {
+#define MVAVARS_JABDT_THH_INDEX(name) name,
+        MVAVARS_JABDT_THH(MVAVARS_JABDT_THH_INDEX)
+#undef MVAVARS_JABDT_THH_INDEX
+        nVariables
+    };
+    // four-vectors of a permutation
+    enum p4Index {p4_leptonicW, p4_btoplep, p4_btophad, p4_h1dau1, p4_h1dau2, p4_h2dau3, p4_h2dau4, p4_toplep, p4_higg1, p4_higg2, nVectors};
+
     MVAvarsJABDTthh();
     ~MVAvarsJABDTthh();
 
@@ -25,15 +95,17 @@ class MVAvarsJABDTthh : public MVAvarsBase
                         const TLorentzVector &metP4,
                         const std::vector<int> &jets_idx);
 
-    std::map<std::string, TLorentzVector> GetVectors(   const TLorentzVector &selectedLeptonP4,
-                                                        const std::vector<TLorentzVector> &selectedJetP4,
-                                                        const TLorentzVector &metP4,
-                                                        const std::vector<int> &jets_idx);
+    // fills vectors for the permutation jets_idx
+    void GetVectors(    const TLorentzVector &selectedLeptonP4,
+                        const std::vector<TLorentzVector> &selectedJetP4,
+                        const TLorentzVector &metP4,
+                        const std::vector<int> &jets_idx);
 
     bool SkipEvent( const std::vector<TLorentzVector> &selectedJetP4,
                     const std::vector<double> &selectedJetCSV,
                     const std::vector<int> &jets_idx);
 
   private:
+    TLorentzVector vectors[nVectors];
 };
 #endif
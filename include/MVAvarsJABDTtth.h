@@ -11,11 +11,89 @@
 // define unique indizes
 enum ttHIndexes {ttH_btoplep_idx, ttH_whaddau1_idx, ttH_whaddau2_idx, ttH_btophad_idx, ttH_hdau1_idx, ttH_hdau2_idx};
 
+// variables of the ttH hypothesis, in the order of Recolabels
+#define MVAVARS_JABDT_TTH(VAR) \
+    VAR(Reco_ttH_btoplep_m) \
+    VAR(Reco_ttH_btoplep_pt) \
+    VAR(Reco_ttH_btoplep_phi) \
+    VAR(Reco_ttH_btoplep_eta) \
+    VAR(Reco_ttH_btoplep_idx) \
+    VAR(Reco_ttH_btoplep_w_dr) \
+    VAR(Reco_ttH_whad_m) \
+    VAR(Reco_ttH_whad_pt) \
+    VAR(Reco_ttH_whad_phi) \
+    VAR(Reco_ttH_whad_eta) \
+    VAR(Reco_ttH_whad_dr) \
+    VAR(Reco_ttH_whaddau_m1) \
+    VAR(Reco_ttH_whaddau_pt1) \
+    VAR(Reco_ttH_whaddau_phi1) \
+    VAR(Reco_ttH_whaddau_eta1) \
+    VAR(Reco_ttH_whaddau_idx1) \
+    VAR(Reco_ttH_whaddau_m2) \
+    VAR(Reco_ttH_whaddau_pt2) \
+    VAR(Reco_ttH_whaddau_phi2) \
+    VAR(Reco_ttH_whaddau_eta2) \
+    VAR(Reco_ttH_whaddau_idx2) \
+    VAR(Reco_ttH_btophad_m) \
+    VAR(Reco_ttH_btophad_pt) \
+    VAR(Reco_ttH_btophad_phi) \
+    VAR(Reco_ttH_btophad_eta) \
+    VAR(Reco_ttH_btophad_idx) \
+    VAR(Reco_ttH_tophad_m) \
+    VAR(Reco_ttH_tophad_pt) \
+    VAR(Reco_ttH_tophad_phi) \
+    VAR(Reco_ttH_tophad_eta) \
+    VAR(Reco_ttH_tophad_dr) \
+    VAR(Reco_ttH_toplep_m) \
+    VAR(Reco_ttH_toplep_pt) \
+    VAR(Reco_ttH_toplep_phi) \
+    VAR(Reco_ttH_toplep_eta) \
+    VAR(Reco_ttH_h_m) \
+    VAR(Reco_ttH_h_pt) \
+    VAR(Reco_ttH_h_phi) \
+    VAR(Reco_ttH_h_eta) \
+    VAR(Reco_ttH_h_dr) \
+    VAR(Reco_ttH_hdau_m1) \
+    VAR(Reco_ttH_hdau_pt1) \
+    VAR(Reco_ttH_hdau_phi1) \
+    VAR(Reco_ttH_hdau_eta1) \
+    VAR(Reco_ttH_hdau_m2) \
+    VAR(Reco_ttH_hdau_pt2) \
+    VAR(Reco_ttH_hdau_phi2) \
+    VAR(Reco_ttH_hdau_eta2) \
+    VAR(Reco_ttH_hdau_idx1) \
+    VAR(Reco_ttH_hdau_idx2) \
+    VAR(Reco_JABDT_ttH_log_whad_m) \
+    VAR(Reco_JABDT_ttH_Jet_CSV_btophad) \
+    VAR(Reco_JABDT_ttH_Jet_CSV_btoplep) \
+    VAR(Reco_JABDT_ttH_Jet_CSV_hdau1) \
+    VAR(Reco_JABDT_ttH_Jet_CSV_hdau2) \
+    VAR(Reco_JABDT_ttH_Jet_CSV_whaddau1) \
+    VAR(Reco_JABDT_ttH_Jet_CSV_whaddau2) \
+    VAR(Reco_JABDT_ttH_log_tophad_m__M__whad_m) \
+    VAR(Reco_JABDT_ttH_log_tophad_m) \
+    VAR(Reco_JABDT_ttH_log_tophad_pt) \
+    VAR(Reco_JABDT_ttH_log_toplep_m) \
+    VAR(Reco_JABDT_ttH_log_toplep_pt) \
+    VAR(Reco_JABDT_ttH_tophad_pt__P__toplep_pt__P__h_pt__DIV__Evt_HT__P__Evt_Pt_MET__P__Lep_Pt) \
+    VAR(Reco_JABDT_ttH_log_h_pt) \
+    VAR(Reco_JABDT_ttH_log_h_m)
+
 // class to provide a variable container for ttH jet assignment hypothesis testing
 class MVAvarsJABDTtth : public MVAvarsBase
 {
 
   public:
+    // variable indices, positions in Recolabels
+    enum variable {
+#define MVAVARS_JABDT_TTH_INDEX(name) name,
+        MVAVARS_JABDT_TTH(MVAVARS_JABDT_TTH_INDEX)
+#undef MVAVARS_JABDT_TTH_INDEX
+        nVariables
+    };
+    // four-vectors of a permutation
+    enum p4Index {p4_leptonicW, p4_btoplep, p4_btophad, p4_whaddau1, p4_whaddau2, p4_hdau1, p4_hdau2, p4_toplep, p4_whad, p4_tophad, p4_higg, nVectors};
+
     MVAvarsJABDTtth();
     ~MVAvarsJABDTtth();
 
@@ -25,15 +103,17 @@ class MVAvarsJABDTtth : public MVAvarsBase
                         const TLorentzVector &metP4,
                         const std::vector<int> &jets_idx);
 
-    std::map<std::string, TLorentzVector> GetVectors(   const TLorentzVector &selectedLeptonP4,
-                                                        const std::vector<TLorentzVector> &selectedJetP4,
-                                                        const TLorentzVector &metP4,
-                                                        const std::vector<int> &jets_idx);
+    // fills vectors for the permutation jets_idx
+    void GetVectors(    const TLorentzVector &selectedLeptonP4,
+                        const std::vector<TLorentzVector> &selectedJetP4,
+                        const TLorentzVector &metP4,
+                        const std::vector<int> &jets_idx);
 
     bool SkipEvent( const std::vector<TLorentzVector> &selectedJetP4,
                     const std::vector<double> &selectedJetCSV,
                     const std::vector<int> &jets_idx);
 
   private:
+    TLorentzVector vectors[nVectors];
 };
 #endif
@@ -0,0 +1,70 @@
+#ifndef MULTIWEIGHTHIST_H
+#define MULTIWEIGHTHIST_H
+//-----------------------------------------------------------------------------
+// Histograms filled with a vector of event weights.
+//
+// Each histogram holds nweights copies of the same uniform binning (e.g. the
+// LHE scale, LHE PDF or parton shower weights of NanoAOD). Storage is
+// bin-major: the nweights sums of one bin are contiguous, so a fill is one
+// bin computation followed by a linear, vectorizable pass over the weights,
+// touching only the cache lines of that bin.
+//-----------------------------------------------------------------------------
+#include <vector>
+#include "TH2D.h"
+#include "TString.h"
+#include "HistAccumulator.h"
+
+class MultiWeightHist
+{
+ public:
+  MultiWeightHist() {}
+  ~MultiWeightHist() {}
+
+  /// Book a histogram with nweights weighted copies, returns its handle.
+  int book(int nbins, double low, double high, int nweights);
+
+  int size() const { return (int)axes_.size(); }
+  int getnWeights(int h) const { return nweights_[h]; }
+  const HistAccumulator::axis& getAxis(int h) const { return axes_[h]; }
+
+  /// Same binning as HistAccumulator::findBin (and TH1::FindFixBin).
+  inline int findBin(int h, double x) const
+  {
+    const HistAccumulator::axis& a = axes_[h];
+    if ( x < a.low ) return 0;
+    if ( !(x < a.high) ) return a.nbins + 1;
+    return 1 + int(a.nbins * (x - a.low) / a.width);
+  }
+
+  /** Fill copy k of histogram h with weight w * weights[k]. Copies beyond
+      the n weights given (sample with fewer weights) are filled with w, the
+      nominal; weights beyond the booked number are ignored.
+  */
+  void fill(int h, double x, double w, int n, const float* weights);
+
+  /// Zero all contents, keep the booking.
+  void reset();
+
+  /// Remove everything, bookings included.
+  void clear();
+
+  double getBinContent(int h, int bin, int k) const
+  { return sumw_[offsets_[h] + bin*nweights_[h] + k]; }
+  double getBinSumw2(int h, int bin, int k) const
+  { return sumw2_[offsets_[h] + bin*nweights_[h] + k]; }
+  double getEntries(int h) const { return entries_[h]; }
+
+  /// New TH2D (in the current directory): x is the histogram axis, y the
+  /// weight index (bin k+1 holds copy k).
+  TH2D* makeTH2D(int h, const TString& name, const TString& title) const;
+
+ private:
+  std::vector<HistAccumulator::axis> axes_;
+  std::vector<int>    nweights_;
+  std::vector<size_t> offsets_;
+  std::vector<double> sumw_;
+  std::vector<double> sumw2_;
+  std::vector<double> entries_;
+};
+
+#endif
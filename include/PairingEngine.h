@@ -0,0 +1,158 @@
+#ifndef PAIRINGENGINE_H
+#define PAIRINGENGINE_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "CachedP4.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// PairingEngine
+//
+// Chi2 pairing of jets into two resonances (HH, ZZ, ZH, ...) in a single
+// pass. The kinematics of every jet pair (mass, pT, scalar pT) are computed
+// once per event, then every unordered pair of disjoint pairs is visited
+// exactly once and all registered hypotheses are evaluated on it together,
+// in both orientations (which pair is assigned to mother 1).
+//
+// A resonance term is (m_pair - M)^2 / sqrt(<pT> * res), <pT> being the
+// average pT of the two jets, as in the original motherReco/diMotherReco.
+// The terms are tabulated per pair and hypothesis, so a candidate costs two
+// additions per orientation.
+////////////////////////////////////////////////////////////////////////////////
+
+class PairingEngine {
+ public:
+    enum matchRequirement { kAny, kAllMatched, kNotAllMatched };
+
+    struct hypothesis {
+	float mass1, mass2;
+	float res1, res2;
+	matchRequirement match;
+    };
+
+    struct jetPair {
+	int i, j;
+	unsigned int mask;
+	bool matched;        // both jets matched
+	bool notMatched;     // neither jet matched
+	float mass, pt, halfScalarPt;
+    };
+
+    struct result {
+	float chi2 = cNoCandidate;
+	float mass1 = -1., mass2 = -1.;
+	float pt1 = -1., pt2 = -1.;
+	int pair1 = -1, pair2 = -1;
+    };
+
+    static constexpr float cNoCandidate = 99999999999.;
+    static const int cMaxJets = 32;
+
+    int addHypothesis(const float mass1, const float mass2, const float res1, const float res2, const matchRequirement match = kAny){
+	_hypotheses.push_back({mass1, mass2, res1, res2, match});
+	_results.resize(_hypotheses.size());
+	return _hypotheses.size() - 1;
+    }
+
+    // Build the pair table. isMatched(object) flags generator-matched jets.
+    template <class object, class matchFunc>
+	void setJets(std::vector<object*>* cont, matchFunc isMatched){
+	_pairs.clear();
+	const int nJets = std::min<int>(cont->size(), cMaxJets);
+	for(int ijet1 = 0; ijet1 < nJets; ijet1++){
+	    const CachedP4 & p1 = *cont->at(ijet1)->getp4();
+	    const bool matched1 = isMatched(cont->at(ijet1));
+	    for(int ijet2 = ijet1+1; ijet2 < nJets; ijet2++){
+		const CachedP4 & p2 = *cont->at(ijet2)->getp4();
+		const bool matched2 = isMatched(cont->at(ijet2));
+		const CachedP4 sum = p1 + p2;
+		jetPair pair;
+		pair.i = ijet1;
+		pair.j = ijet2;
+		pair.mask = (1u << ijet1) | (1u << ijet2);
+		pair.matched = matched1 && matched2;
+		pair.notMatched = !matched1 && !matched2;
+		pair.mass = sum.M();
+		pair.pt = sum.Pt();
+		pair.halfScalarPt = (p1.Pt() + p2.Pt())/2.;
+		_pairs.push_back(pair);
+	    }
+	}
+    }
+
+    const std::vector<jetPair>& getPairs() const {
+	return _pairs;
+    }
+
+    static float chi2Term(const jetPair & pair, const float mass, const float res){
+	const float dm = pair.mass - mass;
+	return dm*dm/std::sqrt(pair.halfScalarPt*res);
+    }
+
+    // Evaluate all hypotheses on every disjoint pair of pairs.
+    void solve(){
+	const int nPairs = _pairs.size();
+	const int nHyp = _hypotheses.size();
+	for(auto & res: _results) res = result();
+
+	_terms.resize(2*nHyp*nPairs);
+	for(int ih = 0; ih < nHyp; ih++){
+	    const hypothesis & hyp = _hypotheses[ih];
+	    float * term1 = &_terms[2*ih*nPairs];
+	    float * term2 = term1 + nPairs;
+	    for(int ip = 0; ip < nPairs; ip++){
+		term1[ip] = chi2Term(_pairs[ip], hyp.mass1, hyp.res1);
+		term2[ip] = (hyp.mass2 == hyp.mass1 && hyp.res2 == hyp.res1) ? term1[ip] : chi2Term(_pairs[ip], hyp.mass2, hyp.res2);
+	    }
+	}
+
+	for(int ip = 0; ip < nPairs; ip++){
+	    const jetPair & pairP = _pairs[ip];
+	    for(int iq = ip+1; iq < nPairs; iq++){
+		const jetPair & pairQ = _pairs[iq];
+		if(pairP.mask & pairQ.mask) continue;
+		const bool allMatched = pairP.matched && pairQ.matched;
+		for(int ih = 0; ih < nHyp; ih++){
+		    const matchRequirement match = _hypotheses[ih].match;
+		    if((match == kAllMatched && !allMatched) || (match == kNotAllMatched && allMatched)) continue;
+		    const float * term1 = &_terms[2*ih*nPairs];
+		    const float * term2 = term1 + nPairs;
+		    result & best = _results[ih];
+		    const float chi2PQ = term1[ip] + term2[iq];
+		    const float chi2QP = term1[iq] + term2[ip];
+		    if(best.chi2 > chi2PQ){
+			best.chi2 = chi2PQ;
+			best.pair1 = ip;
+			best.pair2 = iq;
+		    }
+		    if(best.chi2 > chi2QP){
+			best.chi2 = chi2QP;
+			best.pair1 = iq;
+			best.pair2 = ip;
+		    }
+		}
+	    }
+	}
+
+	for(auto & best: _results){
+	    if(best.pair1 < 0) continue;
+	    best.mass1 = _pairs[best.pair1].mass;
+	    best.mass2 = _pairs[best.pair2].mass;
+	    best.pt1   = _pairs[best.pair1].pt;
+	    best.pt2   = _pairs[best.pair2].pt;
+	}
+    }
+
+    const result & getResult(const int hypIndex) const {
+	return _results[hypIndex];
+    }
+
+ private:
+    std::vector<hypothesis> _hypotheses;
+    std::vector<result> _results;
+    std::vector<jetPair> _pairs;
+    std::vector<float> _terms;
+};
+
+#endif
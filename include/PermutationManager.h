@@ -4,25 +4,40 @@
 #include <iostream>
 #include <iomanip>
 #include <vector>
+#include <utility>
+#include <stdint.h>
 #include "TMath.h"
 
 
 
 using namespace std;
 
+// Assignments of Nidx distinct jets to the Nidx positions of a hypothesis.
+//
+// The table of a jet multiplicity is generated the first time it is asked
+// for, into one flat array of Nidx bytes per assignment; construction does
+// no work, and multiplicities that never occur cost nothing. Symmetric
+// positions (e.g. the two daughters of a W or H) are generated once, with
+// the lower jet index first: the caller orders them by pT if needed.
 class PermutationManager
 {
   //
   // construction / destruction
   //
 public:
-  PermutationManager(unsigned int N_idx, unsigned int Jets_Max);
-  virtual ~PermutationManager();
+    typedef std::pair<unsigned int, unsigned int> positions;
+
+    PermutationManager(unsigned int N_idx, unsigned int Jets_Max,
+                       const std::vector<positions>& symmetric = std::vector<positions>());
+    virtual ~PermutationManager();
 
 
 public:
     unsigned int get_Npermutations(unsigned int Njets);
+    // Nidx jet indices of assignment i, valid as long as the manager
+    const uint8_t* get_permutation(unsigned int Njets, unsigned int i);
     void get_permutation(std::vector<int>* permutation, unsigned int Njets, unsigned int i);
+    const std::vector<positions>& get_symmetricPositions() const {return symmetric;}
 
     void show();
     void show(unsigned int Njets);
@@ -33,9 +48,12 @@ public:
 private:
     const unsigned int Nidx;
     const unsigned int JetsMax;
-    std::vector<std::vector<std::vector<int>>> permutations;
+    const std::vector<positions> symmetric;
+    std::vector<std::vector<uint8_t>> permutations; // per Njets - Nidx, built on use
 
     unsigned int getIndex(unsigned int Njets);
+    const std::vector<uint8_t>& getTable(unsigned int Njets);
+    void fill(std::vector<uint8_t>& table, uint8_t* comb, uint8_t* used, int idx, unsigned int Njets);
 };
 
 #endif
@@ -0,0 +1,78 @@
+#ifndef QUANTILESKETCH_H
+#define QUANTILESKETCH_H
+//-----------------------------------------------------------------------------
+// Streaming quantile sketch (KLL, Karnin-Lang-Liberty).
+//
+// Values go into a stack of compactors; when a level is full it is sorted
+// and every other value moves one level up with twice the weight. Memory is
+// bounded by about 3k values whatever the number of entries, the rank error
+// is O(1/k), and two sketches (e.g. from parallel jobs) merge level by level
+// into a sketch of the union. The "random" choice of the surviving half
+// comes from a counter-based generator, so results are reproducible.
+//
+// Used in a first pass to suggest binnings: equal-population edges,
+// optionally with a minimum bin width (the resolution of the observable).
+//-----------------------------------------------------------------------------
+#include <vector>
+#include <stdint.h>
+#include "TH1F.h"
+#include "TString.h"
+
+class QuantileSketch
+{
+ public:
+  explicit QuantileSketch(int k=200);
+  ~QuantileSketch() {}
+
+  /// Add one value (NaN is ignored).
+  void add(double x);
+
+  /// Add the content of another sketch (same k).
+  void merge(const QuantileSketch& other);
+
+  /// Number of values added.
+  long count() const { return n_; }
+  /// Values held (bounded, about 3k).
+  long retained() const { return (long)size_; }
+  double getMin() const { return min_; }
+  double getMax() const { return max_; }
+
+  /// Value below which a fraction q of the entries lie (0 <= q <= 1).
+  double quantile(double q) const;
+
+  /// Fraction of the entries below x.
+  double cdf(double x) const;
+
+  /** Edges of nbins bins of equal population between the minimum and the
+      maximum. Edges closer than minWidth are merged (fewer bins), as are
+      repeated quantiles of discrete observables.
+  */
+  std::vector<double> suggestEdges(int nbins, double minWidth=0) const;
+
+  /// New TH1F (in the current directory) with the given edges, filled with
+  /// the sketch values and their weights (entry count estimate).
+  TH1F* makeTH1F(const TString& name, const TString& title,
+                 const std::vector<double>& edges) const;
+
+  /// Flat copy (k, count, min, max, then per level its size and values) and
+  /// the inverse, to store a sketch and merge it later.
+  std::vector<double> serialize() const;
+  static QuantileSketch deserialize(const std::vector<double>& data);
+
+ private:
+  int k_;
+  long n_;
+  double min_, max_;
+  std::vector<std::vector<double> > levels_;
+  uint64_t coin_;       // generator state for the compaction offsets
+  size_t size_;         // values held
+  size_t maxSize_;      // sum of the level capacities
+
+  int capacity(int level) const;
+  void grow();
+  void compress();
+  /// Values with their weight 2^level, sorted by value.
+  void weighted(std::vector<std::pair<double, double> >& items) const;
+};
+
+#endif
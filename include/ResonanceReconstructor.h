@@ -0,0 +1,176 @@
+#ifndef RESONANCERECONSTRUCTOR_H
+#define RESONANCERECONSTRUCTOR_H
+
+#include <array>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "CachedP4.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// ResonanceReconstructor
+//
+// Assigns jets to N resonances decaying to two or three jets (H, Z, W ->
+// jj, t -> bjj) by minimizing
+//
+//     chi2 = sum_r ((m_r - M_r) / sigma_r)^2
+//
+// over all assignments of disjoint jet groups, and keeps the K best ones.
+//
+// The search is a depth-first branch and bound over the resonances. For
+// every resonance the candidate jet groups are tabulated once per event and
+// sorted by their own chi2 term. At depth r the partial chi2 of resonances
+// 0..r-1 plus the smallest possible term of each remaining resonance is a
+// lower bound on any completion; once it exceeds the K-th best chi2 the
+// remaining (sorted) candidates at that depth are cut in one go. Repeated
+// identical resonances (HH, tt) are only enumerated in increasing candidate
+// order, so each assignment is visited once.
+//
+// At most cMaxJets leading jets are considered, which bounds the candidate
+// tables (<= 220 triplets) and keeps the latency bounded. No allocation
+// happens in the search after the first event.
+////////////////////////////////////////////////////////////////////////////////
+
+struct resonance {
+    float mass;
+    float sigma;
+    int nDaughters;   // 2 or 3
+};
+
+template <unsigned int NRes>
+class ResonanceReconstructor {
+ public:
+    static const int cMaxJets = 12;
+
+    struct assignment {
+	float chi2;
+	std::array<float, NRes> mass;
+	std::array<unsigned short, NRes> jetMask;   // bit i set: jet i belongs to resonance r
+    };
+
+    ResonanceReconstructor(const std::array<resonance, NRes> & resonances, const unsigned int nBest = 1)
+	: _resonances(resonances), _nBest(std::max(1u, nBest)) {
+	_best.reserve(_nBest + 1);
+	for(unsigned int ir = 0; ir < NRes; ir++){
+	    _sameAsPrevious[ir] = ir > 0
+		&& _resonances[ir].mass == _resonances[ir-1].mass
+		&& _resonances[ir].sigma == _resonances[ir-1].sigma
+		&& _resonances[ir].nDaughters == _resonances[ir-1].nDaughters;
+	}
+    }
+
+    // Returns the number of assignments found (<= K), sorted by chi2.
+    template <class object>
+	int reconstruct(std::vector<object*>* jets){
+	const int nJets = std::min<int>(jets->size(), cMaxJets);
+	for(int ijet = 0; ijet < nJets; ijet++){
+	    const CachedP4 & p4 = *jets->at(ijet)->getp4();
+	    _px[ijet] = p4.Px();
+	    _py[ijet] = p4.Py();
+	    _pz[ijet] = p4.Pz();
+	    _E[ijet]  = p4.E();
+	}
+	_best.clear();
+	int nNeeded = 0;
+	for(const auto & res: _resonances) nNeeded += res.nDaughters;
+	if(nJets < nNeeded) return 0;
+
+	for(unsigned int ir = 0; ir < NRes; ir++){
+	    fillCandidates(ir, nJets);
+	}
+	_remainingBound[NRes] = 0.;
+	for(int ir = NRes-1; ir >= 0; ir--){
+	    const float minTerm = _candidates[ir].empty() ? 0. : _candidates[ir].front().chi2;
+	    _remainingBound[ir] = _remainingBound[ir+1] + minTerm;
+	}
+	search(0, 0, 0., 0);
+	return _best.size();
+    }
+
+    const std::vector<assignment>& getBest() const {
+	return _best;
+    }
+
+ private:
+    struct candidate {
+	float chi2;
+	float mass;
+	unsigned short mask;
+    };
+
+    float groupMass(const unsigned short mask) const {
+	double px = 0., py = 0., pz = 0., e = 0.;
+	for(int ijet = 0; ijet < cMaxJets; ijet++){
+	    if(!(mask & (1u << ijet))) continue;
+	    px += _px[ijet]; py += _py[ijet]; pz += _pz[ijet]; e += _E[ijet];
+	}
+	const double m2 = e*e - px*px - py*py - pz*pz;
+	return m2 < 0 ? -std::sqrt(-m2) : std::sqrt(m2);
+    }
+
+    void addCandidate(const unsigned int ir, const unsigned short mask){
+	const float mass = groupMass(mask);
+	const float pull = (mass - _resonances[ir].mass)/_resonances[ir].sigma;
+	_candidates[ir].push_back({pull*pull, mass, mask});
+    }
+
+    void fillCandidates(const unsigned int ir, const int nJets){
+	_candidates[ir].clear();
+	for(int i = 0; i < nJets; i++){
+	    for(int j = i+1; j < nJets; j++){
+		if(_resonances[ir].nDaughters == 2){
+		    addCandidate(ir, (1u << i) | (1u << j));
+		    continue;
+		}
+		for(int k = j+1; k < nJets; k++){
+		    addCandidate(ir, (1u << i) | (1u << j) | (1u << k));
+		}
+	    }
+	}
+	std::sort(_candidates[ir].begin(), _candidates[ir].end(),
+		  [](const candidate & a, const candidate & b){ return a.chi2 < b.chi2; });
+    }
+
+    float bound() const {
+	return _best.size() < _nBest ? cNoBound : _best.back().chi2;
+    }
+
+    void search(const unsigned int ir, const unsigned short usedMask, const float partialChi2, const unsigned int firstCandidate){
+	if(ir == NRes){
+	    insert(partialChi2);
+	    return;
+	}
+	const std::vector<candidate> & cands = _candidates[ir];
+	for(unsigned int ic = firstCandidate; ic < cands.size(); ic++){
+	    const candidate & cand = cands[ic];
+	    // sorted by chi2: no later candidate can do better
+	    if(partialChi2 + cand.chi2 + _remainingBound[ir+1] >= bound()) break;
+	    if(cand.mask & usedMask) continue;
+	    _current.mass[ir] = cand.mass;
+	    _current.jetMask[ir] = cand.mask;
+	    const unsigned int next = (ir+1 < NRes && _sameAsPrevious[ir+1]) ? ic+1 : 0;
+	    search(ir+1, usedMask | cand.mask, partialChi2 + cand.chi2, next);
+	}
+    }
+
+    void insert(const float chi2){
+	_current.chi2 = chi2;
+	auto pos = std::upper_bound(_best.begin(), _best.end(), chi2,
+				    [](const float value, const assignment & a){ return value < a.chi2; });
+	_best.insert(pos, _current);
+	if(_best.size() > _nBest) _best.pop_back();
+    }
+
+    static constexpr float cNoBound = 99999999999.;
+
+    std::array<resonance, NRes> _resonances;
+    std::array<bool, NRes> _sameAsPrevious;
+    unsigned int _nBest;
+    std::array<std::vector<candidate>, NRes> _candidates;
+    std::array<float, NRes+1> _remainingBound;
+    std::array<double, cMaxJets> _px, _py, _pz, _E;
+    assignment _current;
+    std::vector<assignment> _best;
+};
+
+#endif
@@ -0,0 +1,273 @@
+#ifndef TREESCHEMA_H
+#define TREESCHEMA_H
+
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <string>
+#include <limits>
+#include <fstream>
+#include <sstream>
+#include <fnmatch.h>
+#include "TTree.h"
+#include "TString.h"
+#include "tnm.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Declarative output tree.
+//
+// Two kinds of entries:
+//   scalars     - one value per event, leaf type F/f (float, Float16),
+//                 I (int), i (unsigned int), L (Long64_t) or O (bool),
+//   collections - a counter branch nName (I) and one variable-length array
+//                 Name_field[nName] (F) per field, filled from an object
+//                 collection of the event (at most maxSize objects).
+// Absent objects are simply not stored (no sentinel values).
+//
+// fill() evaluates the scalars and gathers every field of a collection into
+// its own contiguous buffer, which the array branch then writes in one go.
+// Define everything first, then branch(tree): the branch addresses point
+// into the schema and must not move afterwards.
+//
+// select() keeps only the branches matching a list of glob patterns (e.g.
+// from a configuration file, one per line); the value functions of the
+// others are dropped and never evaluated.
+//
+// The same values can be flattened into a fixed-width float row for a
+// columnar export: the scalars, then per collection its counter and the
+// fields of its first maxObjects objects (NaN where there is no object).
+////////////////////////////////////////////////////////////////////////////////
+
+template <class Event>
+class TreeSchema {
+ public:
+    typedef std::function<double(Event *)> valueFunc;
+
+    void scalar(const TString & name, const char type, valueFunc value){
+	if(type != 'F' && type != 'f' && type != 'I' && type != 'i' && type != 'L' && type != 'O')
+	    error("TreeSchema::scalar - unknown leaf type for " + std::string(name.Data()));
+	scalarDef def;
+	def.name = name;
+	def.type = type;
+	def.value = value;
+	_scalars.push_back(def);
+    }
+
+    // Value read from a variable that is set before each fill.
+    template <class T>
+    void scalar(const TString & name, const char type, const T * source){
+	scalar(name, type, [source](Event *){ return (double)*source; });
+    }
+
+    template <class Object>
+    struct field {
+	TString name;
+	std::function<float(Object *)> value;
+    };
+
+    template <class Object>
+    void collection(const TString & name, const int maxSize, std::function<std::vector<Object *> *(Event *)> objects,
+		    const std::vector<field<Object> > & fields){
+	collectionDef def;
+	def.name = name;
+	def.maxSize = maxSize;
+	std::vector<std::function<float(Object *)> > values;
+	for(const auto & f : fields){
+	    def.fields.push_back(values.size());
+	    def.fieldNames.push_back(f.name);
+	    def.buffers.push_back(std::vector<float>(maxSize, 0.));
+	    values.push_back(f.value);
+	}
+	// field by field, so that each buffer is written contiguously
+	def.gather = [objects, values](Event * ev, collectionDef & c){
+	    const std::vector<Object *> & objs = *objects(ev);
+	    c.n = std::min<int>(objs.size(), c.maxSize);
+	    for(unsigned f = 0; f < c.fields.size(); f++){
+		float * out = &c.buffers[f][0];
+		const auto & value = values[c.fields[f]];
+		for(int i = 0; i < c.n; i++) out[i] = value(objs[i]);
+	    }
+	};
+	_collections.push_back(def);
+    }
+
+    // Keep the branches whose name matches one of the glob patterns; no
+    // pattern keeps everything. A collection stays if its counter or one of
+    // its fields is selected, and then always has its counter.
+    void select(const std::vector<std::string> & patterns){
+	if(_branched) error("TreeSchema::select - branches already created");
+	if(patterns.empty()) return;
+	auto selected = [&patterns](const TString & name){
+	    for(const auto & p : patterns)
+		if(fnmatch(p.c_str(), name.Data(), 0) == 0) return true;
+	    return false;
+	};
+	std::vector<scalarDef> scalars;
+	for(const auto & s : _scalars)
+	    if(selected(s.name)) scalars.push_back(s);
+	_scalars = scalars;
+
+	std::vector<collectionDef> collections;
+	for(const auto & c : _collections){
+	    std::vector<bool> keep;
+	    for(const auto & f : c.fieldNames) keep.push_back(selected(c.name + "_" + f));
+	    if(std::find(keep.begin(), keep.end(), true) == keep.end() && !selected("n" + c.name)) continue;
+	    collectionDef def = c;
+	    def.fieldNames.clear();
+	    def.buffers.clear();
+	    std::vector<int> fields;
+	    for(unsigned f = 0; f < keep.size(); f++){
+		if(!keep[f]) continue;
+		def.fieldNames.push_back(c.fieldNames[f]);
+		def.buffers.push_back(c.buffers[f]);
+		fields.push_back(c.fields[f]);
+	    }
+	    def.fields = fields;
+	    collections.push_back(def);
+	}
+	_collections = collections;
+    }
+
+    // Patterns from a file, one per line, # starts a comment. Returns false
+    // if the file can't be read.
+    static bool readPatterns(const std::string & path, std::vector<std::string> & patterns){
+	std::ifstream in(path.c_str());
+	if(!in.good()) return false;
+	std::string line;
+	while(std::getline(in, line)){
+	    line = line.substr(0, line.find('#'));
+	    std::istringstream words(line);
+	    std::string word;
+	    while(words >> word) patterns.push_back(word);
+	}
+	return true;
+    }
+
+    // Whether a branch survived select().
+    bool has(const TString & name) const {
+	for(const auto & s : _scalars) if(s.name == name) return true;
+	for(const auto & c : _collections){
+	    if("n" + c.name == name) return true;
+	    for(const auto & f : c.fieldNames) if(c.name + "_" + f == name) return true;
+	}
+	return false;
+    }
+
+    bool empty() const { return _scalars.empty() && _collections.empty(); }
+
+    // Create the branches in tree.
+    void branch(TTree * tree){
+	_branched = true;
+	for(auto & s : _scalars){
+	    TString leaf = s.name + "/" + s.type;
+	    if(s.type == 'F' || s.type == 'f') tree->Branch(s.name, &s.f, leaf);
+	    else if(s.type == 'I') tree->Branch(s.name, &s.i, leaf);
+	    else if(s.type == 'i') tree->Branch(s.name, &s.u, leaf);
+	    else if(s.type == 'L') tree->Branch(s.name, &s.l, leaf);
+	    else tree->Branch(s.name, &s.o, leaf);
+	}
+	for(auto & c : _collections){
+	    TString counter = "n" + c.name;
+	    tree->Branch(counter, &c.n, counter + "/I");
+	    for(unsigned f = 0; f < c.fieldNames.size(); f++){
+		TString name = c.name + "_" + c.fieldNames[f];
+		tree->Branch(name, &c.buffers[f][0], name + "[" + counter + "]/F");
+	    }
+	}
+    }
+
+    // Set every branch from the event; the caller fills the tree.
+    void fill(Event * ev){
+	for(auto & s : _scalars){
+	    const double x = s.value(ev);
+	    if(s.type == 'F' || s.type == 'f') s.f = x;
+	    else if(s.type == 'I') s.i = x;
+	    else if(s.type == 'i') s.u = x;
+	    else if(s.type == 'L') s.l = x;
+	    else s.o = x != 0;
+	}
+	for(auto & c : _collections) c.gather(ev, c);
+    }
+
+    // Zero every scalar and empty every collection, for an entry without
+    // an event (e.g. one that failed the selection).
+    void clear(){
+	for(auto & s : _scalars){
+	    s.f = 0;
+	    s.i = 0;
+	    s.u = 0;
+	    s.l = 0;
+	    s.o = false;
+	}
+	for(auto & c : _collections) c.n = 0;
+    }
+
+    // Column names of the flat row, e.g. bJet_pt_0, bJet_pt_1, ...
+    std::vector<std::string> columnNames(const int maxObjects) const {
+	std::vector<std::string> names;
+	for(const auto & s : _scalars) names.push_back(s.name.Data());
+	for(const auto & c : _collections){
+	    names.push_back(std::string("n") + c.name.Data());
+	    for(const auto & f : c.fieldNames)
+		for(int i = 0; i < std::min(maxObjects, c.maxSize); i++)
+		    names.push_back(std::string(c.name.Data()) + "_" + f.Data() + "_" + std::to_string(i));
+	}
+	return names;
+    }
+
+    // Flat row of the last fill(), columnNames(maxObjects).size() values.
+    // Integers above 2^24 (event numbers) do not survive the float. Float16
+    // ('f') scalars give the full-precision value, not the rounded one the
+    // tree stores.
+    void columnValues(float * row, const int maxObjects) const {
+	const float missing = std::numeric_limits<float>::quiet_NaN();
+	for(const auto & s : _scalars){
+	    if(s.type == 'F' || s.type == 'f') *row++ = s.f;
+	    else if(s.type == 'I') *row++ = s.i;
+	    else if(s.type == 'i') *row++ = s.u;
+	    else if(s.type == 'L') *row++ = s.l;
+	    else *row++ = s.o;
+	}
+	for(const auto & c : _collections){
+	    *row++ = c.n;
+	    const int k = std::min(maxObjects, c.maxSize);
+	    for(const auto & buffer : c.buffers){
+		const int n = std::min(k, c.n);
+		std::copy(buffer.begin(), buffer.begin() + n, row);
+		std::fill(row + n, row + k, missing);
+		row += k;
+	    }
+	}
+    }
+
+    int nScalars() const { return _scalars.size(); }
+    int nCollections() const { return _collections.size(); }
+
+ private:
+    struct scalarDef {
+	TString name;
+	char type;
+	valueFunc value;
+	float f = 0;
+	int i = 0;
+	unsigned int u = 0;
+	Long64_t l = 0;
+	bool o = false;
+    };
+
+    struct collectionDef {
+	TString name;
+	int maxSize;
+	int n = 0;
+	std::vector<int> fields; // value functions in use
+	std::vector<TString> fieldNames;
+	std::vector<std::vector<float> > buffers;
+	std::function<void(Event *, collectionDef &)> gather;
+    };
+
+    std::vector<scalarDef> _scalars;
+    std::vector<collectionDef> _collections;
+    bool _branched = false;
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef VARIATIONOVERLAY_H
+#define VARIATIONOVERLAY_H
+
+#include <vector>
+#include "CachedP4.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// VariationOverlay
+//
+// A kinematic variation (JES, JER) of the entry as a sparse overlay over the
+// nominal jets: only the jets whose pT or mass change are stored, by index in
+// eventBuffer::Jet, together with the sum of their four-momentum changes,
+// which is what the MET has to absorb.
+//
+// The variation event is the nominal one with the overlay applied: leptons,
+// boosted jets, generator particles, triggers and the unchanged jets are
+// shared, and only the changed jets are rebuilt and selected again.
+////////////////////////////////////////////////////////////////////////////////
+
+class VariationOverlay {
+ public:
+    struct jetChange {
+	int index;
+	float pt, mass;
+    };
+
+    // New variation of an entry with nJets jets.
+    void reset(const int nJets){
+	_jets.clear();
+	_slot.assign(nJets, -1);
+	_jetsOffset.assign(4, 0.);
+    }
+
+    // Varied pT and mass of jet index, nominal its nominal four-momentum;
+    // a jet that does not change is not stored.
+    void setJet(const int index, const CachedP4 & nominal, const float pt, const float mass){
+	if(pt == nominal.Pt() && mass == nominal.M()) return;
+	const CachedP4 varied = CachedP4::fromPtEtaPhiM(pt, nominal.Eta(), nominal.Phi(), mass);
+	_jetsOffset[0] += varied.Px() - nominal.Px();
+	_jetsOffset[1] += varied.Py() - nominal.Py();
+	_jetsOffset[2] += varied.Pz() - nominal.Pz();
+	_jetsOffset[3] += varied.E() - nominal.E();
+	_slot[index] = _jets.size();
+	_jets.push_back({index, pt, mass});
+    }
+
+    // Change of jet index, nullptr if it keeps its nominal pT and mass.
+    const jetChange * getJet(const int index) const {
+	return _slot[index] < 0 ? nullptr : &_jets[_slot[index]];
+    }
+
+    const std::vector<jetChange> & getJets() const {
+	return _jets;
+    }
+
+    // Sum of the changes (px, py, pz, E) of the jets, to subtract from the MET.
+    const std::vector<float> & getJetsOffset() const {
+	return _jetsOffset;
+    }
+
+ private:
+    std::vector<jetChange> _jets;
+    std::vector<int> _slot;          // per jet: position in _jets, -1 unchanged
+    std::vector<float> _jetsOffset;
+};
+
+#endif
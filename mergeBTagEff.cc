@@ -0,0 +1,36 @@
+//----------------------------------------------------------------------------
+// mergeBTagEff: add up the partial b-tag efficiency maps written by the jobs
+// of a sample (cut["bTagEff"] = 1) into the cache file that runs with
+// cut["bTagEff"] = 2 load. Run it once all the jobs are done:
+//
+//   ./mergeBTagEff <dir>/btagEff_<sample>_wp<wp>_<hash>.bin.*
+//
+// The merged map is written next to the first partial map.
+//----------------------------------------------------------------------------
+#include <iostream>
+#include <string>
+#include "tnm.h"
+#include "BTagEffMap.h"
+
+using namespace std;
+
+int main(int argc, char** argv){
+    if(argc < 2){
+	cout << "usage: mergeBTagEff <partial map> [<partial map> ...]" << endl;
+	return 1;
+    }
+    BTagEffMap merged;
+    for(int i = 1; i < argc; i++){
+	BTagEffMap part;
+	if(!part.load(argv[i])) error(string("mergeBTagEff - can't read ") + argv[i]);
+	if(i == 1) merged = part;
+	else merged.add(part);
+    }
+    const string first = argv[1];
+    const size_t slash = first.rfind('/');
+    const string dir = slash == string::npos ? "." : first.substr(0, slash);
+    merged.write(dir);
+    cout << "merged " << argc - 1 << " partial maps (" << merged.entries() << " jets) into "
+	 << merged.fileName(dir) << endl;
+    return 0;
+}
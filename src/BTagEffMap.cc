@@ -0,0 +1,193 @@
+//-----------------------------------------------------------------------------
+// b-tag efficiency map in (pT, |eta|, flavour) with a file cache.
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include "BTagEffMap.h"
+#include "tnm.h"
+//-----------------------------------------------------------------------------
+
+namespace {
+  const char MAGIC[8] = {'B', 'T', 'E', 'F', 'F', '1', 0, 0};
+
+  // bin of x for edges e, clamped to the first and last bins
+  int clampedBin(const std::vector<double>& e, double x)
+  {
+    int b = std::upper_bound(e.begin(), e.end(), x) - e.begin() - 1;
+    if ( b < 0 ) return 0;
+    if ( b > (int)e.size() - 2 ) return (int)e.size() - 2;
+    return b;
+  }
+}
+
+///
+BTagEffMap::BTagEffMap(const std::string& sample, double wp,
+                       const std::vector<double>& ptEdges,
+                       const std::vector<double>& etaEdges)
+  : sample_(sample),
+    wp_(wp),
+    ptEdges_(ptEdges),
+    etaEdges_(etaEdges)
+{
+  if ( ptEdges.size() < 2 || etaEdges.size() < 2 )
+    error("BTagEffMap - need at least one pT and one |eta| bin");
+  if ( !std::is_sorted(ptEdges.begin(), ptEdges.end()) ||
+       !std::is_sorted(etaEdges.begin(), etaEdges.end()) )
+    error("BTagEffMap - edges must be increasing");
+  size_t n = nFlavours * (etaEdges.size() - 1) * (ptEdges.size() - 1);
+  tagged_.assign(n, 0);
+  all_.assign(n, 0);
+}
+
+///
+int BTagEffMap::index(double pt, double absEta, flavour f) const
+{
+  int npt = ptEdges_.size() - 1;
+  int neta = etaEdges_.size() - 1;
+  return (f * neta + clampedBin(etaEdges_, absEta)) * npt
+    + clampedBin(ptEdges_, pt);
+}
+
+///
+void BTagEffMap::fill(double pt, double absEta, flavour f, bool tagged,
+                      double w)
+{
+  int i = index(pt, absEta, f);
+  all_[i] += w;
+  if ( tagged ) tagged_[i] += w;
+}
+
+///
+double BTagEffMap::efficiency(double pt, double absEta, flavour f) const
+{
+  int i = index(pt, absEta, f);
+  return all_[i] > 0 ? tagged_[i] / all_[i] : 0;
+}
+
+///
+double BTagEffMap::entries() const
+{
+  double n = 0;
+  for(unsigned i=0; i < all_.size(); i++) n += all_[i];
+  return n;
+}
+
+///
+uint64_t BTagEffMap::binningHash() const
+{
+  // FNV-1a over the edges
+  uint64_t h = 0xcbf29ce484222325ULL;
+  std::vector<double> edges(ptEdges_);
+  edges.push_back(-1);
+  edges.insert(edges.end(), etaEdges_.begin(), etaEdges_.end());
+  for(unsigned i=0; i < edges.size(); i++)
+    {
+      unsigned char bytes[sizeof(double)];
+      std::memcpy(bytes, &edges[i], sizeof(double));
+      for(unsigned k=0; k < sizeof(double); k++)
+        {
+          h ^= bytes[k];
+          h *= 0x100000001b3ULL;
+        }
+    }
+  return h;
+}
+
+///
+std::string BTagEffMap::fileName(const std::string& dir) const
+{
+  char key[64];
+  snprintf(key, sizeof(key), "_wp%.4f_%016llx.bin", wp_,
+           (unsigned long long)binningHash());
+  std::string path = dir.empty() ? std::string(".") : dir;
+  return path + "/btagEff_" + sample_ + key;
+}
+
+///
+void BTagEffMap::save(const std::string& path) const
+{
+  std::string tmp = path + ".tmp";
+  std::ofstream out(tmp.c_str(), std::ios::binary);
+  if ( !out.good() ) error("BTagEffMap::save - can't open " + tmp);
+  int32_t nsample = sample_.size();
+  int32_t npt = ptEdges_.size(), neta = etaEdges_.size();
+  out.write(MAGIC, sizeof(MAGIC));
+  out.write((const char*)&nsample, sizeof(nsample));
+  out.write(sample_.data(), nsample);
+  out.write((const char*)&wp_, sizeof(wp_));
+  out.write((const char*)&npt, sizeof(npt));
+  out.write((const char*)&neta, sizeof(neta));
+  out.write((const char*)&ptEdges_[0], npt * sizeof(double));
+  out.write((const char*)&etaEdges_[0], neta * sizeof(double));
+  out.write((const char*)&tagged_[0], tagged_.size() * sizeof(double));
+  out.write((const char*)&all_[0], all_.size() * sizeof(double));
+  out.close();
+  if ( !out.good() ) error("BTagEffMap::save - write failed for " + tmp);
+  if ( std::rename(tmp.c_str(), path.c_str()) != 0 )
+    error("BTagEffMap::save - can't rename " + tmp);
+}
+
+///
+bool BTagEffMap::read(const std::string& dir)
+{
+  BTagEffMap cached;
+  if ( !cached.load(fileName(dir)) ) return false;
+  if ( cached.sample_ != sample_ || cached.wp_ != wp_ ||
+       cached.ptEdges_ != ptEdges_ || cached.etaEdges_ != etaEdges_ )
+    return false;
+  tagged_.swap(cached.tagged_);
+  all_.swap(cached.all_);
+  return true;
+}
+
+///
+bool BTagEffMap::load(const std::string& path)
+{
+  std::ifstream in(path.c_str(), std::ios::binary);
+  if ( !in.good() ) return false;
+  char magic[sizeof(MAGIC)];
+  int32_t nsample = 0, npt = 0, neta = 0;
+  in.read(magic, sizeof(magic));
+  in.read((char*)&nsample, sizeof(nsample));
+  if ( !in.good() || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+       nsample < 0 || nsample > 4096 )
+    return false;
+  std::string sample(nsample, ' ');
+  double wp = 0;
+  in.read(&sample[0], nsample);
+  in.read((char*)&wp, sizeof(wp));
+  in.read((char*)&npt, sizeof(npt));
+  in.read((char*)&neta, sizeof(neta));
+  if ( !in.good() || npt < 2 || neta < 2 || npt > 4096 || neta > 4096 )
+    return false;
+  std::vector<double> ptEdges(npt), etaEdges(neta);
+  size_t n = nFlavours * (neta - 1) * (npt - 1);
+  std::vector<double> tagged(n), all(n);
+  in.read((char*)&ptEdges[0], npt * sizeof(double));
+  in.read((char*)&etaEdges[0], neta * sizeof(double));
+  in.read((char*)&tagged[0], n * sizeof(double));
+  in.read((char*)&all[0], n * sizeof(double));
+  if ( !in.good() ) return false;
+  sample_ = sample;
+  wp_ = wp;
+  ptEdges_.swap(ptEdges);
+  etaEdges_.swap(etaEdges);
+  tagged_.swap(tagged);
+  all_.swap(all);
+  return true;
+}
+
+///
+void BTagEffMap::add(const BTagEffMap& other)
+{
+  if ( other.sample_ != sample_ || other.wp_ != wp_ ||
+       other.ptEdges_ != ptEdges_ || other.etaEdges_ != etaEdges_ )
+    error("BTagEffMap::add - different key");
+  for(unsigned i=0; i < all_.size(); i++)
+    {
+      tagged_[i] += other.tagged_[i];
+      all_[i] += other.all_[i];
+    }
+}
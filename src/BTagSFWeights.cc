@@ -0,0 +1,85 @@
+//-----------------------------------------------------------------------------
+// Per-event b-tag scale-factor weights (efficiency method).
+//-----------------------------------------------------------------------------
+#include <cmath>
+#include <algorithm>
+#include "BTagSFWeights.h"
+//-----------------------------------------------------------------------------
+
+namespace {
+  // keeps the logs finite: efficiencies in [EPS, 1 - EPS], SF >= EPS
+  const double EPS = 1e-6;
+  // jets per product before taking its log
+  const int BLOCK = 16;
+}
+
+///
+void BTagSFWeights::clear()
+{
+  eff_.clear();
+  sf_.clear();
+  unc_.clear();
+  tag_.clear();
+  for(int k=0; k < nWeights; k++) logw_[k] = 0;
+}
+
+///
+void BTagSFWeights::add(float eff, float sf, float sfUnc, bool tagged)
+{
+  eff_.push_back(eff);
+  sf_.push_back(sf);
+  unc_.push_back(sfUnc);
+  tag_.push_back(tagged ? 1 : 0);
+}
+
+///
+void BTagSFWeights::compute()
+{
+  const int n = eff_.size();
+  factor_.resize(nWeights * n);
+  if ( n == 0 )
+    {
+      for(int k=0; k < nWeights; k++) logw_[k] = 0;
+      return;
+    }
+  const float* eff = &eff_[0];
+  const float* sf  = &sf_[0];
+  const float* unc = &unc_[0];
+  const float* tag = &tag_[0];
+  const double shift[nWeights] = {0, 1, -1};
+  for(int k=0; k < nWeights; k++)
+    {
+      // per-jet factors, no branches (vectorized)
+      double* f = &factor_[k * n];
+      const double d = shift[k];
+      for(int i=0; i < n; i++)
+        {
+          double e = eff[i];
+          e = e < EPS ? EPS : e;
+          e = e > 1 - EPS ? 1 - EPS : e;
+          double s = sf[i] + d * unc[i];
+          s = s < EPS ? EPS : s;
+          double miss = 1 - s * e;
+          miss = miss < EPS ? EPS : miss;
+          f[i] = tag[i] * s + (1 - tag[i]) * miss / (1 - e);
+        }
+
+      // untagged factors are in [EPS, 1/EPS] and SFs of order one: a
+      // block of BLOCK factors can't under/overflow a double
+      double logw = 0;
+      for(int first=0; first < n; first += BLOCK)
+        {
+          const int last = std::min(first + BLOCK, n);
+          double product = 1;
+          for(int i=first; i < last; i++) product *= f[i];
+          logw += std::log(product);
+        }
+      logw_[k] = logw;
+    }
+}
+
+///
+double BTagSFWeights::weight(int k) const
+{
+  return std::exp(logw_[k]);
+}
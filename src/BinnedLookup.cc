@@ -0,0 +1,55 @@
+//-----------------------------------------------------------------------------
+// Flat lookup table copied from a TH1 or TH2.
+//-----------------------------------------------------------------------------
+#include "TAxis.h"
+#include "BinnedLookup.h"
+#include "tnm.h"
+//-----------------------------------------------------------------------------
+
+///
+void BinnedLookup::axis::set(const TAxis* a)
+{
+  nbins = a->GetNbins();
+  low   = a->GetXmin();
+  high  = a->GetXmax();
+  edges.clear();
+  if ( a->IsVariableBinSize() )
+    for(int b=1; b <= nbins + 1; b++) edges.push_back(a->GetBinLowEdge(b));
+}
+
+///
+BinnedLookup::BinnedLookup(const TH1* hist)
+{
+  if ( !hist ) error("BinnedLookup - no histogram");
+  x_.set(hist->GetXaxis());
+  y_.nbins = 0;
+  y_.low = y_.high = 0;
+  values_.resize(x_.nbins + 2);
+  for(int b=0; b < x_.nbins + 2; b++)
+    values_[b] = hist->GetBinContent(b);
+}
+
+///
+BinnedLookup::BinnedLookup(const TH2* hist)
+{
+  if ( !hist ) error("BinnedLookup - no histogram");
+  x_.set(hist->GetXaxis());
+  y_.set(hist->GetYaxis());
+  values_.resize((x_.nbins + 2) * (y_.nbins + 2));
+  for(int by=0; by < y_.nbins + 2; by++)
+    for(int bx=0; bx < x_.nbins + 2; bx++)
+      values_[by * (x_.nbins + 2) + bx] = hist->GetBinContent(bx, by);
+}
+
+///
+void BinnedLookup::values(const float* x, int n, float* out) const
+{
+  for(int i=0; i < n; i++) out[i] = values_[x_.bin(x[i])];
+}
+
+///
+void BinnedLookup::values(const float* x, const float* y, int n,
+                          float* out) const
+{
+  for(int i=0; i < n; i++) out[i] = value(x[i], y[i]);
+}
@@ -0,0 +1,104 @@
+//-----------------------------------------------------------------------------
+// Poisson bootstrap replicas of fixed-binning histograms.
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include "BootstrapHist.h"
+#include "tnm.h"
+//-----------------------------------------------------------------------------
+
+namespace {
+  // splitmix64 finalizer
+  inline uint64_t mix64(uint64_t z)
+  {
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  // Poisson(1) cumulative probabilities, scaled to 2^53 so that a 53-bit
+  // random integer is compared without conversion. P(k > 12) < 1e-10 is
+  // folded into k = 12.
+  struct poissonTable
+  {
+    uint64_t cdf[12];
+    poissonTable()
+    {
+      double p = 0.36787944117144233;   // exp(-1)
+      double c = p;
+      for(int k=0; k < 12; k++)
+        {
+          cdf[k] = (uint64_t)(c * 9007199254740992.0);
+          p /= k + 1;
+          c += p;
+        }
+    }
+  };
+  const poissonTable poisson;
+}
+
+///
+void poissonReplicaWeights(unsigned int run, unsigned int lumi, long event,
+                           int n, unsigned char* weights)
+{
+  uint64_t key = mix64(mix64(mix64(run) ^ lumi) ^ (uint64_t)event);
+  for(int r=0; r < n; r++)
+    {
+      uint64_t u = mix64(key + r) >> 11;
+      int k = 0;
+      while ( k < 12 && u >= poisson.cdf[k] ) k++;
+      weights[r] = (unsigned char)k;
+    }
+}
+
+///
+int BootstrapHist::book(int nbins, double low, double high, int nreplicas)
+{
+  if ( nbins < 1 || !(high > low) )
+    error("BootstrapHist::book - invalid binning");
+  if ( nreplicas < 1 )
+    error("BootstrapHist::book - need at least one replica");
+  HistAccumulator::axis a = {nbins, low, high, high - low};
+  axes_.push_back(a);
+  nreplicas_.push_back(nreplicas);
+  offsets_.push_back(sumw_.size());
+  sumw_.resize(sumw_.size() + (size_t)(nbins + 2) * nreplicas, 0);
+  return (int)axes_.size() - 1;
+}
+
+///
+void BootstrapHist::fill(int h, double x, double w,
+                         const unsigned char* replicaWeights)
+{
+  const int nr = nreplicas_[h];
+  double* sumw = &sumw_[offsets_[h] + (size_t)findBin(h, x) * nr];
+  for(int r=0; r < nr; r++) sumw[r] += w * replicaWeights[r];
+}
+
+///
+void BootstrapHist::reset()
+{
+  std::fill(sumw_.begin(), sumw_.end(), 0);
+}
+
+///
+void BootstrapHist::clear()
+{
+  axes_.clear();
+  nreplicas_.clear();
+  offsets_.clear();
+  sumw_.clear();
+}
+
+///
+TH2D* BootstrapHist::makeTH2D(int h, const TString& name,
+                              const TString& title) const
+{
+  const HistAccumulator::axis& a = axes_[h];
+  const int nr = nreplicas_[h];
+  TH2D* hist = new TH2D(name, title, a.nbins, a.low, a.high, nr, 0, nr);
+  for(int bin=0; bin < a.nbins + 2; bin++)
+    for(int r=0; r < nr; r++)
+      hist->SetBinContent(bin, r + 1, getBinContent(h, bin, r));
+  return hist;
+}
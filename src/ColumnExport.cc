@@ -0,0 +1,156 @@
+//-----------------------------------------------------------------------------
+// Columnar float32 export of per-event features.
+//-----------------------------------------------------------------------------
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ColumnExport.h"
+#include "tnm.h"
+//-----------------------------------------------------------------------------
+
+namespace {
+  // magic, version, header length and a dictionary padded to this size
+  const int NPY_HEADER = 128;
+
+  bool littleEndian()
+  {
+    const uint16_t one = 1;
+    return *(const char*)&one == 1;
+  }
+
+  void writeHeader(FILE* file, long rows)
+  {
+    char header[NPY_HEADER];
+    std::memset(header, ' ', NPY_HEADER);
+    std::memcpy(header, "\x93NUMPY\x01\x00", 8);
+    const uint16_t len = NPY_HEADER - 10;
+    header[8] = len & 0xff;
+    header[9] = len >> 8;
+    char dict[NPY_HEADER];
+    int n = snprintf(dict, sizeof(dict),
+                     "{'descr': '%cf4', 'fortran_order': False, "
+                     "'shape': (%ld,), }",
+                     littleEndian() ? '<' : '>', rows);
+    std::memcpy(header + 10, dict, n);
+    header[NPY_HEADER - 1] = '\n';
+    std::fseek(file, 0, SEEK_SET);
+    std::fwrite(header, 1, NPY_HEADER, file);
+  }
+}
+
+///
+ColumnExporter::ColumnExporter(const std::string& prefix,
+                               const std::vector<std::string>& columns,
+                               int chunkRows)
+  : prefix_(prefix),
+    names_(columns),
+    chunkRows_(chunkRows),
+    buffered_(0),
+    rows_(0)
+{
+  if ( columns.empty() ) error("ColumnExporter - no columns");
+  if ( chunkRows < 1 ) error("ColumnExporter - chunkRows must be positive");
+  buffer_.resize((size_t)chunkRows_ * names_.size());
+  for(unsigned c=0; c < names_.size(); c++)
+    {
+      FILE* file = std::fopen(path(c).c_str(), "wb");
+      if ( !file ) error("ColumnExporter - can't open " + path(c));
+      writeHeader(file, 0);
+      files_.push_back(file);
+    }
+}
+
+///
+ColumnExporter::~ColumnExporter()
+{
+  close();
+}
+
+///
+std::string ColumnExporter::path(int c) const
+{
+  return prefix_ + "_" + names_[c] + ".npy";
+}
+
+///
+void ColumnExporter::fill(const float* values)
+{
+  if ( files_.empty() ) error("ColumnExporter::fill - exporter closed");
+  for(unsigned c=0; c < names_.size(); c++)
+    buffer_[(size_t)c * chunkRows_ + buffered_] = values[c];
+  rows_++;
+  if ( ++buffered_ == chunkRows_ ) flush();
+}
+
+///
+void ColumnExporter::flush()
+{
+  for(unsigned c=0; c < files_.size(); c++)
+    if ( std::fwrite(&buffer_[(size_t)c * chunkRows_], sizeof(float),
+                     buffered_, files_[c]) != (size_t)buffered_ )
+      error("ColumnExporter - write failed for " + path(c));
+  buffered_ = 0;
+}
+
+///
+void ColumnExporter::close()
+{
+  if ( files_.empty() ) return;
+  flush();
+  for(unsigned c=0; c < files_.size(); c++)
+    {
+      writeHeader(files_[c], rows_);
+      std::fclose(files_[c]);
+    }
+  files_.clear();
+
+  std::ofstream manifest((prefix_ + "_columns.txt").c_str());
+  manifest << "rows " << rows_ << std::endl;
+  for(unsigned c=0; c < names_.size(); c++)
+    manifest << names_[c] << std::endl;
+}
+
+///
+NpyColumn::NpyColumn(const std::string& path)
+  : map_(0),
+    mapSize_(0),
+    data_(0),
+    size_(0)
+{
+  int fd = open(path.c_str(), O_RDONLY);
+  if ( fd < 0 ) error("NpyColumn - can't open " + path);
+  struct stat st;
+  fstat(fd, &st);
+  mapSize_ = st.st_size;
+  if ( mapSize_ < 10 ) error("NpyColumn - not an npy file: " + path);
+  map_ = mmap(0, mapSize_, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if ( map_ == MAP_FAILED ) error("NpyColumn - can't map " + path);
+
+  const char* bytes = (const char*)map_;
+  if ( std::memcmp(bytes, "\x93NUMPY", 6) != 0 )
+    error("NpyColumn - not an npy file: " + path);
+  size_t header = 10 + ((unsigned char)bytes[8] | (unsigned char)bytes[9] << 8);
+  if ( header > mapSize_ ) error("NpyColumn - truncated header in " + path);
+  std::string dict(bytes + 10, header - 10);
+  if ( dict.find("f4'") == std::string::npos ||
+       dict.find("'fortran_order': False") == std::string::npos )
+    error("NpyColumn - not a float32 column: " + path);
+  size_t shape = dict.find("'shape': (");
+  if ( shape == std::string::npos ) error("NpyColumn - no shape in " + path);
+  size_ = std::atol(dict.c_str() + shape + 10);
+  if ( size_ < 0 || (size_t)size_ > (mapSize_ - header) / sizeof(float) )
+    error("NpyColumn - truncated file " + path);
+  data_ = (const float*)(bytes + header);
+}
+
+///
+NpyColumn::~NpyColumn()
+{
+  if ( map_ ) munmap(map_, mapSize_);
+}
@@ -0,0 +1,173 @@
+//-----------------------------------------------------------------------------
+// Single-pass scan of a grid of cut values.
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include "TH1D.h"
+#include "CutGridScan.h"
+#include "tnm.h"
+//-----------------------------------------------------------------------------
+
+///
+int CutGridScan::addObjectAxis(const std::string& name,
+                               const std::vector<double>& values)
+{
+  if ( !sumw_.empty() ) error("CutGridScan::addObjectAxis - table booked");
+  if ( values.empty() ) error("CutGridScan::addObjectAxis - no values for " + name);
+  axis a = {name, values};
+  objectAxes_.push_back(a);
+  return (int)objectAxes_.size() - 1;
+}
+
+///
+int CutGridScan::addCutAxis(const std::string& name,
+                            const std::vector<double>& values)
+{
+  if ( !sumw_.empty() ) error("CutGridScan::addCutAxis - table booked");
+  if ( values.empty() ) error("CutGridScan::addCutAxis - no values for " + name);
+  if ( !std::is_sorted(values.begin(), values.end()) )
+    error("CutGridScan::addCutAxis - values not increasing for " + name);
+  axis a = {name, values};
+  cutAxes_.push_back(a);
+  return (int)cutAxes_.size() - 1;
+}
+
+///
+void CutGridScan::book()
+{
+  nouter_ = 1;
+  for(unsigned i=0; i < objectAxes_.size(); i++)
+    nouter_ *= objectAxes_[i].values.size();
+
+  // bucket b of cut axis d counts the values passed, 0..n
+  const int ndim = cutAxes_.size();
+  strides_.assign(ndim, 1);
+  for(int d=ndim-2; d >= 0; d--)
+    strides_[d] = strides_[d+1] * (cutAxes_[d+1].values.size() + 1);
+  ncells_ = ndim == 0 ? 1 : strides_[0] * (cutAxes_[0].values.size() + 1);
+
+  sumw_.assign((size_t)nouter_ * ncells_, 0);
+  sumw2_.assign((size_t)nouter_ * ncells_, 0);
+  finalized_ = false;
+}
+
+///
+int CutGridScan::outerIndex(const std::vector<int>& idx) const
+{
+  int o = 0;
+  for(unsigned i=0; i < objectAxes_.size(); i++)
+    o = o * objectAxes_[i].values.size() + idx[i];
+  return o;
+}
+
+///
+void CutGridScan::fill(int o, const double* features, double w)
+{
+  if ( finalized_ ) error("CutGridScan::fill - table already finalized");
+  size_t c = (size_t)o * ncells_;
+  for(unsigned d=0; d < cutAxes_.size(); d++)
+    {
+      const std::vector<double>& v = cutAxes_[d].values;
+      // values <= feature; NaN passes nothing
+      int b = features[d] == features[d] ?
+        std::upper_bound(v.begin(), v.end(), features[d]) - v.begin() : 0;
+      c += b * strides_[d];
+    }
+  sumw_[c]  += w;
+  sumw2_[c] += w*w;
+}
+
+///
+void CutGridScan::finalize()
+{
+  if ( finalized_ ) return;
+  // suffix sums along each cut axis; going down in cell number, the
+  // neighbour c + stride is already summed
+  for(unsigned d=0; d < cutAxes_.size(); d++)
+    {
+      const int stride = strides_[d];
+      const int n = cutAxes_[d].values.size();
+      for(int o=0; o < nouter_; o++)
+        {
+          double* sumw  = &sumw_[(size_t)o * ncells_];
+          double* sumw2 = &sumw2_[(size_t)o * ncells_];
+          for(int c=ncells_-1; c >= 0; c--)
+            {
+              if ( (c / stride) % (n + 1) == n ) continue;
+              sumw[c]  += sumw[c + stride];
+              sumw2[c] += sumw2[c + stride];
+            }
+        }
+    }
+  finalized_ = true;
+}
+
+///
+int CutGridScan::cell(int o, const std::vector<int>& idx) const
+{
+  if ( !finalized_ ) error("CutGridScan - table not finalized");
+  int c = o * ncells_;
+  for(unsigned d=0; d < cutAxes_.size(); d++)
+    c += (idx[d] + 1) * strides_[d];
+  return c;
+}
+
+///
+double CutGridScan::getYield(int o, const std::vector<int>& idx) const
+{
+  return sumw_[cell(o, idx)];
+}
+
+///
+double CutGridScan::getSumw2(int o, const std::vector<int>& idx) const
+{
+  return sumw2_[cell(o, idx)];
+}
+
+///
+void CutGridScan::write(const TString& name) const
+{
+  const int ndim = cutAxes_.size();
+  int npoints = nouter_;
+  for(int d=0; d < ndim; d++) npoints *= cutAxes_[d].values.size();
+
+  TH1D* yields = new TH1D(name, name, npoints, 0, npoints);
+  yields->Sumw2();
+  std::vector<int> idx(ndim, 0);
+  int bin = 1;
+  for(int o=0; o < nouter_; o++)
+    {
+      std::fill(idx.begin(), idx.end(), 0);
+      for(int p=0; p < npoints / nouter_; p++)
+        {
+          yields->SetBinContent(bin, getYield(o, idx));
+          yields->SetBinError(bin, std::sqrt(getSumw2(o, idx)));
+          bin++;
+          // next grid point, last axis fastest
+          for(int d=ndim-1; d >= 0; d--)
+            {
+              if ( ++idx[d] < (int)cutAxes_[d].values.size() ) break;
+              idx[d] = 0;
+            }
+        }
+    }
+  yields->Write();
+  delete yields;
+
+  TH1D* total = new TH1D(name + "_total", name + " total", 1, 0, 1);
+  total->SetBinContent(1, getTotal());
+  total->Write();
+  delete total;
+
+  std::vector<axis> axes(objectAxes_);
+  axes.insert(axes.end(), cutAxes_.begin(), cutAxes_.end());
+  for(unsigned i=0; i < axes.size(); i++)
+    {
+      const int n = axes[i].values.size();
+      TString axisName = name + "_" + axes[i].name.c_str();
+      TH1D* values = new TH1D(axisName, axisName, n, 0, n);
+      for(int k=0; k < n; k++) values->SetBinContent(k + 1, axes[i].values[k]);
+      values->Write();
+      delete values;
+    }
+}
@@ -0,0 +1,128 @@
+//-----------------------------------------------------------------------------
+// Per-event eta-phi index for deltaR queries and one-to-one matching.
+//-----------------------------------------------------------------------------
+#include "DeltaRIndex.h"
+//-----------------------------------------------------------------------------
+
+///
+double deltaRWrapped(double eta1, double phi1, double eta2, double phi2)
+{
+  double deta = eta1 - eta2;
+  double dphi = fabs(phi1 - phi2);
+  if ( dphi > M_PI ) dphi = 2 * M_PI - dphi;
+  return sqrt(deta*deta + dphi*dphi);
+}
+
+///
+void DeltaRIndex::clear()
+{
+  entries_.clear();
+  eta_.clear();
+  phi_.clear();
+}
+
+///
+int DeltaRIndex::add(double eta, double phi)
+{
+  int index = (int)eta_.size();
+  entry e = {eta, phi, index};
+  entries_.push_back(e);
+  eta_.push_back(eta);
+  phi_.push_back(phi);
+  return index;
+}
+
+///
+void DeltaRIndex::build()
+{
+  std::sort(entries_.begin(), entries_.end());
+}
+
+///
+void DeltaRIndex::query(double eta, double phi, double radius,
+                        std::vector<int>& found) const
+{
+  found.clear();
+  entry low = {eta - radius, 0, 0};
+  std::vector<entry>::const_iterator it =
+    std::lower_bound(entries_.begin(), entries_.end(), low);
+  for(; it != entries_.end() && it->eta < eta + radius; ++it)
+    {
+      if ( deltaRWrapped(eta, phi, it->eta, it->phi) < radius )
+        found.push_back(it->index);
+    }
+}
+
+///
+int DeltaRIndex::nearest(double eta, double phi, double radius,
+                         double* distance) const
+{
+  int best = -1;
+  double bestdR = radius;
+  entry low = {eta - radius, 0, 0};
+  std::vector<entry>::const_iterator it =
+    std::lower_bound(entries_.begin(), entries_.end(), low);
+  for(; it != entries_.end() && it->eta < eta + radius; ++it)
+    {
+      double dR = deltaRWrapped(eta, phi, it->eta, it->phi);
+      if ( dR < bestdR )
+        {
+          best = it->index;
+          bestdR = dR;
+        }
+    }
+  if ( distance ) *distance = bestdR;
+  return best;
+}
+
+///
+std::vector<matchedPair>
+matchOneToOne(const DeltaRIndex& from, const DeltaRIndex& to, double radius,
+              const std::function<bool(int, int)>& accept)
+{
+  std::vector<matchedPair> candidates;
+  std::vector<int> found;
+  for(int i=0; i < from.size(); i++)
+    {
+      to.query(from.eta(i), from.phi(i), radius, found);
+      for(unsigned k=0; k < found.size(); k++)
+        {
+          int j = found[k];
+          if ( accept && !accept(i, j) ) continue;
+          matchedPair mp;
+          mp.first = i;
+          mp.second = j;
+          mp.distance = deltaRWrapped(from.eta(i), from.phi(i),
+                                      to.eta(j), to.phi(j));
+          candidates.push_back(mp);
+        }
+    }
+  // stable: ties keep the (from, to) insertion order
+  std::stable_sort(candidates.begin(), candidates.end());
+
+  std::vector<bool> usedfrom(from.size(), false);
+  std::vector<bool> usedto(to.size(), false);
+  std::vector<matchedPair> matches;
+  for(unsigned c=0; c < candidates.size(); c++)
+    {
+      const matchedPair& mp = candidates[c];
+      if ( usedfrom[mp.first] || usedto[mp.second] ) continue;
+      usedfrom[mp.first] = true;
+      usedto[mp.second] = true;
+      matches.push_back(mp);
+    }
+  return matches;
+}
+
+///
+std::vector<matchedPair>
+matchOneToOne(std::vector<ptThing>& v1, std::vector<ptThing>& v2,
+              double drcut)
+{
+  DeltaRIndex index1, index2;
+  for(unsigned i=0; i < v1.size(); i++) index1.add(v1[i].eta, v1[i].phi);
+  for(unsigned j=0; j < v2.size(); j++) index2.add(v2[j].eta, v2[j].phi);
+  index1.build();
+  index2.build();
+  return matchOneToOne(index1, index2, drcut);
+}
@@ -0,0 +1,171 @@
+//-----------------------------------------------------------------------------
+// Fixed-binning histogram storage.
+//-----------------------------------------------------------------------------
+#include <thread>
+#include <algorithm>
+#include "HistAccumulator.h"
+#include "tnm.h"
+//-----------------------------------------------------------------------------
+
+///
+int HistAccumulator::book(int nbins, double low, double high)
+{
+  if ( nbins < 1 || !(high > low) )
+    error("HistAccumulator::book - invalid binning");
+  axis a = {nbins, low, high, high - low};
+  axes_.push_back(a);
+  offsets_.push_back(sumw_.size());
+  sumw_.resize(sumw_.size() + nbins + 2, 0);
+  sumw2_.resize(sumw2_.size() + nbins + 2, 0);
+  entries_.push_back(0);
+  stats_.resize(stats_.size() + 4, 0);
+  return (int)axes_.size() - 1;
+}
+
+///
+void HistAccumulator::fillN(int h, int n, const double* x, const double* w)
+{
+  if ( (int)bins_.size() < n ) bins_.resize(n);
+  const axis& a = axes_[h];
+  const double low = a.low, high = a.high, width = a.width, nbins = a.nbins;
+  const int overflow = a.nbins + 1;
+  int* bins = &bins_[0];
+
+  // selects only (no branches) so that the loop vectorizes; the clamp keeps
+  // the conversion defined (NaN gives -1), the last two give the same
+  // under/overflow as findBin()
+  for(int i=0; i < n; i++)
+    {
+      double t = nbins * (x[i] - low) / width;
+      t = t > -1.0 ? t : -1.0;
+      t = t < nbins ? t : nbins;
+      int bin = 1 + (int)t;
+      bin = x[i] < low ? 0 : bin;
+      bins[i] = x[i] < high ? bin : overflow;
+    }
+
+  // stats kept in registers (no aliasing with the bin arrays); same
+  // sequence of additions as fill(), so the same result
+  double* sumw  = &sumw_[offsets_[h]];
+  double* sumw2 = &sumw2_[offsets_[h]];
+  double s0 = stats_[4*h], s1 = stats_[4*h+1], s2 = stats_[4*h+2], s3 = stats_[4*h+3];
+  for(int i=0; i < n; i++)
+    {
+      int bin = bins[i];
+      double wi = w[i];
+      sumw[bin]  += wi;
+      sumw2[bin] += wi*wi;
+      // under/overflow add exact zeros instead of a hard to predict branch
+      bool inrange = bin != 0 && bin != overflow;
+      double wm = inrange ? wi : 0;
+      double xm = inrange ? x[i] : 0;
+      s0 += wm;
+      s1 += wm*wi;
+      s2 += wm*xm;
+      s3 += wm*xm*xm;
+    }
+  stats_[4*h] = s0;
+  stats_[4*h+1] = s1;
+  stats_[4*h+2] = s2;
+  stats_[4*h+3] = s3;
+  entries_[h] += n;
+}
+
+///
+void HistAccumulator::add(const HistAccumulator& other)
+{
+  if ( other.sumw_.size() != sumw_.size() || other.axes_.size() != axes_.size() )
+    error("HistAccumulator::add - booking mismatch");
+  for(size_t i=0; i < sumw_.size(); i++)
+    {
+      sumw_[i]  += other.sumw_[i];
+      sumw2_[i] += other.sumw2_[i];
+    }
+  for(size_t i=0; i < entries_.size(); i++) entries_[i] += other.entries_[i];
+  for(size_t i=0; i < stats_.size(); i++) stats_[i] += other.stats_[i];
+}
+
+///
+void HistAccumulator::reset()
+{
+  std::fill(sumw_.begin(), sumw_.end(), 0);
+  std::fill(sumw2_.begin(), sumw2_.end(), 0);
+  std::fill(entries_.begin(), entries_.end(), 0);
+  std::fill(stats_.begin(), stats_.end(), 0);
+}
+
+///
+void HistAccumulator::clear()
+{
+  axes_.clear();
+  offsets_.clear();
+  sumw_.clear();
+  sumw2_.clear();
+  entries_.clear();
+  stats_.clear();
+}
+
+///
+HistAccumulator HistAccumulator::emptyCopy() const
+{
+  HistAccumulator copy(*this);
+  copy.reset();
+  return copy;
+}
+
+///
+TH1F* HistAccumulator::makeTH1F(int h, const TString& name,
+                                const TString& title) const
+{
+  const axis& a = axes_[h];
+  TH1F* hist = new TH1F(name, title, a.nbins, a.low, a.high);
+  hist->Sumw2();
+  for(int bin=0; bin < a.nbins + 2; bin++)
+    {
+      hist->SetBinContent(bin, getBinContent(h, bin));
+      hist->GetSumw2()->SetAt(getBinSumw2(h, bin), bin);
+    }
+  // SetBinContent counts entries and resets the statistics: restore both
+  hist->SetEntries(entries_[h]);
+  double stats[4];
+  for(int i=0; i < 4; i++) stats[i] = stats_[4*h + i];
+  hist->PutStats(stats);
+  return hist;
+}
+
+///
+HistSlices::HistSlices(const HistAccumulator& booking, long nevents,
+                       int nslices)
+  : slices_(nslices, booking.emptyCopy()),
+    next_(0),
+    nevents_(nevents)
+{
+  if ( nslices < 1 ) error("HistSlices - need at least one slice");
+}
+
+///
+void HistSlices::run(int nthreads,
+                     const std::function<void(HistAccumulator&, long, long)>&
+                     fillSlice)
+{
+  next_ = 0;
+  auto worker = [this, &fillSlice]()
+    {
+      for(int s = next(); s >= 0; s = next())
+        fillSlice(slices_[s], begin(s), end(s));
+    };
+  if ( nthreads < 2 )
+    {
+      worker();
+      return;
+    }
+  std::vector<std::thread> threads;
+  for(int t=0; t < nthreads; t++) threads.push_back(std::thread(worker));
+  for(unsigned t=0; t < threads.size(); t++) threads[t].join();
+}
+
+///
+void HistSlices::merge(HistAccumulator& total) const
+{
+  for(unsigned s=0; s < slices_.size(); s++) total.add(slices_[s]);
+}
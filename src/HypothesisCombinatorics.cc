@@ -81,9 +81,16 @@ std::map<std::string, float> HypothesisCombinatorics::GetBestPermutation(const s
     else
 	{
 	    // iterate permutations to find best
-	    for(unsigned int permutation_idx=0; permutation_idx < getPermutator()->get_Npermutations(NJets); permutation_idx++)
+	    PermutationManager* permutator = getPermutator();
+	    const std::vector<PermutationManager::positions>& symmetric = permutator->get_symmetricPositions();
+	    const unsigned int Npermutations = permutator->get_Npermutations(NJets);
+	    for(unsigned int permutation_idx=0; permutation_idx < Npermutations; permutation_idx++)
 		{
-		    getPermutator()->get_permutation(&permutation, NJets, permutation_idx);
+		    permutator->get_permutation(&permutation, NJets, permutation_idx);
+		    // symmetric positions come once: higher pT jet first
+		    for(unsigned int s=0; s < symmetric.size(); s++)
+			if(selectedJetP4[permutation[symmetric[s].second]].Pt() > selectedJetP4[permutation[symmetric[s].first]].Pt())
+			    std::swap(permutation[symmetric[s].first], permutation[symmetric[s].second]);
 		    if(mvars->SkipEvent(selectedJetP4, selectedJetCSV, permutation)) continue;
             
 		    mvars->FillMVAvarMap(selectedLeptonP4, selectedJetP4, selectedJetCSV, metP4, permutation);
@@ -1,5 +1,6 @@
 //#include "TTH/CommonClassifier/interface/MVAvars.h"
 #include "MVAvars.h"
+#include <algorithm>
 
 
 using namespace std;
@@ -12,123 +13,14 @@ MVAvars::MVAvars(const char* era)
     MEMClassifier mem(0, "btagDeepFlavB_", era);
     // ==================================================
     //init all variables potentially used
-    
-    // higgs specific variables
-    variableMap["Reco_best_higgs_mass"] = -999.;
-    variableMap["Reco_dEta_fn"] = -999.;
-
-
-    // CSV variables
-    variableMap["Evt_CSV_min"] = -999.;
-    variableMap["Evt_CSV_min_tagged"] = -999.;
-    variableMap["Evt_CSV_avg"] = -999.;
-    variableMap["Evt_CSV_avg_tagged"] = -999.;
-    variableMap["Evt_CSV_dev"] = -999.;
-    variableMap["Evt_CSV_dev_tagged"] = -999.;
-
-    // fox wolfram moments
-    variableMap["Evt_h0"] = -999.;
-    variableMap["Evt_h1"] = -999.;
-    variableMap["Evt_h2"] = -999.;
-    variableMap["Evt_h3"] = -999.;
-
-    // event masses 
-    variableMap["Evt_M_Total"] = -999.;
-    variableMap["Evt_M3"] = -999.;
-    variableMap["Evt_M3_oneTagged"] = -999.;
-
-    // HT variables
-    variableMap["Evt_HT"] = -999.;
-    variableMap["Evt_HT_wo_MET"] = -999.;
-    variableMap["Evt_HT_jets"] = -999.;
-    variableMap["Evt_HT_tags"] = -999.;
-    
-    // missing transveral variables
-    variableMap["Evt_MHT"] = -999.;
-    variableMap["Evt_MET"] = -999.;
-    variableMap["Evt_MTW"] = -999.;
-
-    // btag likelihood ratios
-    variableMap["Evt_blr"] = -999.;
-    variableMap["Evt_blr_transformed"] = -999.;
-
-    // Jet variables
-    variableMap["Evt_M_JetsAverage"] = -999.;
-    variableMap["Evt_Eta_JetsAverage"] = -999.;
-    variableMap["Evt_Pt_JetsAverage"] = -999.;
-    variableMap["Evt_E_JetsAverage"] = -999.;
-    variableMap["Evt_M_TaggedJetsAverage"] = -999.;
-    variableMap["Evt_Eta_TaggedJetsAverage"] = -999.;
-    variableMap["Evt_Pt_TaggedJetsAverage"] = -999.;
-    variableMap["Evt_E_TaggedJetsAverage"] = -999.;
-    variableMap["Evt_M_UntaggedJetsAverage"] = -999.;
-    variableMap["Evt_Eta_UntaggedJetsAverage"] = -999.;
-    variableMap["Evt_Pt_UntaggedJetsAverage"] = -999.;
-    variableMap["Evt_E_UntaggedJetsAverage"] = -999.;
-
-    // dijet variables (tagged jets)
-    variableMap["Evt_M2_closestTo125TaggedJets"] = -999.;
-    variableMap["Evt_M2_closestTo91TaggedJets"] = -999.;
-    variableMap["Evt_M2_TaggedJetsAverage"] = -999.;
-    variableMap["Evt_Dr_TaggedJetsAverage"] = -999.;
-    variableMap["Evt_Deta_TaggedJetsAverage"] = -999.;
-    variableMap["Evt_M2_minDrTaggedJets"] = -999.;
-    variableMap["Evt_Dr_minDrTaggedJets"] = -999.;
-    variableMap["Evt_Pt_minDrTaggedJets"] = -999.;
-    variableMap["Evt_Dr_maxDrTaggedJets"] = -999.;
-    variableMap["Evt_Dr_closestTo91TaggedJets"] = -999.;
-
-    // dijet variables (all jets)
-    variableMap["Evt_M2_JetsAverage"] = -999.;
-    variableMap["Evt_Dr_JetsAverage"] = -999.;
-    variableMap["Evt_Deta_JetsAverage"] = -999.;
-    variableMap["Evt_M2_minDrJets"] = -999.;
-    variableMap["Evt_Dr_minDrJets"] = -999.;
-    variableMap["Evt_Pt_minDrJets"] = -999.;
-    variableMap["Evt_Dr_maxDrJets"] = -999.;
-
-    // dijet variables (untagged jets)
-    variableMap["Evt_M2_UntaggedJetsAverage"] = -999.;
-    variableMap["Evt_Dr_UntaggedJetsAverage"] = -999.;
-    variableMap["Evt_Deta_UntaggedJetsAverage"] = -999.;
-    variableMap["Evt_M2_minDrUntaggedJets"] = -999.;
-    variableMap["Evt_Dr_minDrUntaggedJets"] = -999.;
-    variableMap["Evt_Pt_minDrUntaggedJets"] = -999.;
-    variableMap["Evt_Dr_maxDrUntaggedJets"] = -999.;
-
-    // max detas 
-    variableMap["Evt_Deta_maxDetaJetJet"] = -999.;
-    variableMap["Evt_Deta_maxDetaTagTag"] = -999.;
-    variableMap["Evt_Deta_maxDetaJetTag"] = -999.;
-
-    // lepton + jet variables
-    variableMap["Evt_Dr_minDrLepTag"] = -999.;
-    variableMap["Evt_Dr_minDrLepJet"] = -999.;
-    variableMap["Evt_M_minDrLepTag"] = -999.;
-    variableMap["Evt_M_minDrLepJet"] = -999.;
-
-
-    // event shape variables
-    variableMap["Evt_aplanarity"] = -999.;
-    variableMap["Evt_aplanarity_jets"] = -999.;
-    variableMap["Evt_aplanarity_tags"] = -999.;
-    variableMap["Evt_sphericity"] = -999.;
-    variableMap["Evt_sphericity_jets"] = -999.;
-    variableMap["Evt_sphericity_tags"] = -999.;
-    variableMap["Evt_transverse_sphericity"] = -999.;
-    variableMap["Evt_transverse_sphericity_jets"] = -999.;
-    variableMap["Evt_transverse_sphericity_tags"] = -999.;
-    variableMap["Evt_JetPt_over_JetE"] = -999.;
-    variableMap["Evt_TaggedJetPt_over_TaggedJetE"] = -999.;
-
-    // reconstructed WLep variables
-    variableMap["Reco_WLep_E"] = -999.;
-    variableMap["Reco_WLep_Eta"] = -999.;
-    variableMap["Reco_WLep_Phi"] = -999.;
-    variableMap["Reco_WLep_Pt"] = -999.;
-    variableMap["Reco_WLep_Mass"] = -999.;
-
-    
+    Recolabels = {
+#define MVAVARS_EVT_NAME(name) #name,
+        MVAVARS_EVT(MVAVARS_EVT_NAME)
+#undef MVAVARS_EVT_NAME
+    };
+    InitVariables();
+    // before the first event, as with the former map
+    std::fill(variables.begin(), variables.end(), -999.);
 }
 
 MVAvars::~MVAvars()
@@ -692,120 +584,120 @@ void MVAvars::FillMVAvarMap(const std::vector<TLorentzVector> &selectedLeptonP4,
     TLorentzVector Wlep = GetLeptonicW(selectedLeptonP4.at(0), metP4);
     
     // ==================================================
-    // Fill variable map
+    // Fill variables
     
     // higgs specific variables
-    variableMap["Reco_best_higgs_mass"] = bestHiggsMass;
-    variableMap["Reco_dEta_fn"] = dEta_fn;
+    variables[Reco_best_higgs_mass] = bestHiggsMass;
+    variables[Reco_dEta_fn] = dEta_fn;
 
     // CSV variables
-    variableMap["Evt_CSV_min"] = lowest_btag_all;
-    variableMap["Evt_CSV_min_tagged"] = lowest_btag_tagged;
-    variableMap["Evt_CSV_avg"] = averageCSV_all;
-    variableMap["Evt_CSV_avg_tagged"] = averageCSV_tagged;
-    variableMap["Evt_CSV_dev"] = csvDev_all;
-    variableMap["Evt_CSV_dev_tagged"] = csvDev_tagged;
+    variables[Evt_CSV_min] = lowest_btag_all;
+    variables[Evt_CSV_min_tagged] = lowest_btag_tagged;
+    variables[Evt_CSV_avg] = averageCSV_all;
+    variables[Evt_CSV_avg_tagged] = averageCSV_tagged;
+    variables[Evt_CSV_dev] = csvDev_all;
+    variables[Evt_CSV_dev_tagged] = csvDev_tagged;
 
     // fox wolfram moments
-    variableMap["Evt_h0"] = h0;
-    variableMap["Evt_h1"] = h1;
-    variableMap["Evt_h2"] = h2;
-    variableMap["Evt_h3"] = h3;
+    variables[Evt_h0] = h0;
+    variables[Evt_h1] = h1;
+    variables[Evt_h2] = h2;
+    variables[Evt_h3] = h3;
 
     // event masses 
-    variableMap["Evt_M_Total"] = mass_of_everything;
-    variableMap["Evt_M3"] = m3;
-    variableMap["Evt_M3_oneTagged"] = m3_onetagged;
+    variables[Evt_M_Total] = mass_of_everything;
+    variables[Evt_M3] = m3;
+    variables[Evt_M3_oneTagged] = m3_onetagged;
 
     // HT variables
-    variableMap["Evt_HT"] = ht;
-    variableMap["Evt_HT_wo_MET"] = ht_wo_met;
-    variableMap["Evt_HT_jets"] = ht_jets;
-    variableMap["Evt_HT_tags"] = ht_taggedjets;
+    variables[Evt_HT] = ht;
+    variables[Evt_HT_wo_MET] = ht_wo_met;
+    variables[Evt_HT_jets] = ht_jets;
+    variables[Evt_HT_tags] = ht_taggedjets;
     
     // missing transveral variables
-    variableMap["Evt_MHT"] = MHT;
-    variableMap["Evt_MET"] = metP4.Pt();
-    variableMap["Evt_MTW"] = MTW;
+    variables[Evt_MHT] = MHT;
+    variables[Evt_MET] = metP4.Pt();
+    variables[Evt_MTW] = MTW;
 
     // btag likelihood ratios
-    variableMap["Evt_blr"] = eth_blr;
-    variableMap["Evt_blr_transformed"] = blr_transformed;
+    variables[Evt_blr] = eth_blr;
+    variables[Evt_blr_transformed] = blr_transformed;
 
     // Jet variables
-    variableMap["Evt_M_JetsAverage"] = avgJetM;
-    variableMap["Evt_Eta_JetsAverage"] = avgJetEta;
-    variableMap["Evt_Pt_JetsAverage"] = avgJetPt;
-    variableMap["Evt_E_JetsAverage"] = avgJetE;
-    variableMap["Evt_M_TaggedJetsAverage"] = avgTaggedJetM;
-    variableMap["Evt_Eta_TaggedJetsAverage"] = avgTaggedJetEta;
-    variableMap["Evt_Pt_TaggedJetsAverage"] = avgTaggedJetPt;
-    variableMap["Evt_E_TaggedJetsAverage"] = avgTaggedJetE;
-    variableMap["Evt_M_UntaggedJetsAverage"] = avgUntaggedJetM;
-    variableMap["Evt_Eta_UntaggedJetsAverage"] = avgUntaggedJetEta;
-    variableMap["Evt_Pt_UntaggedJetsAverage"] = avgUntaggedJetPt;
-    variableMap["Evt_E_UntaggedJetsAverage"] = avgUntaggedJetE;
+    variables[Evt_M_JetsAverage] = avgJetM;
+    variables[Evt_Eta_JetsAverage] = avgJetEta;
+    variables[Evt_Pt_JetsAverage] = avgJetPt;
+    variables[Evt_E_JetsAverage] = avgJetE;
+    variables[Evt_M_TaggedJetsAverage] = avgTaggedJetM;
+    variables[Evt_Eta_TaggedJetsAverage] = avgTaggedJetEta;
+    variables[Evt_Pt_TaggedJetsAverage] = avgTaggedJetPt;
+    variables[Evt_E_TaggedJetsAverage] = avgTaggedJetE;
+    variables[Evt_M_UntaggedJetsAverage] = avgUntaggedJetM;
+    variables[Evt_Eta_UntaggedJetsAverage] = avgUntaggedJetEta;
+    variables[Evt_Pt_UntaggedJetsAverage] = avgUntaggedJetPt;
+    variables[Evt_E_UntaggedJetsAverage] = avgUntaggedJetE;
 
     // dijet variables (tagged jets)
-    variableMap["Evt_M2_closestTo125TaggedJets"] = tagged_dijet_mass_closest_to_125;
-    variableMap["Evt_M2_closestTo91TaggedJets"] = tagged_dijet_mass_closest_to_91;
-    variableMap["Evt_M2_TaggedJetsAverage"] = avgM2Tagged;
-    variableMap["Evt_Dr_TaggedJetsAverage"] = avgDrTagged;
-    variableMap["Evt_Deta_TaggedJetsAverage"] = avgDetaTagged;
-    variableMap["Evt_M2_minDrTaggedJets"] = closest_tagged_dijet_mass;
-    variableMap["Evt_Dr_minDrTaggedJets"] = minDrTagged;
-    variableMap["Evt_Pt_minDrTaggedJets"] = minPtTagged;
-    variableMap["Evt_Dr_maxDrTaggedJets"] = maxDrTagged;
-    variableMap["Evt_Dr_closestTo91TaggedJets"] = DrTagged91;
+    variables[Evt_M2_closestTo125TaggedJets] = tagged_dijet_mass_closest_to_125;
+    variables[Evt_M2_closestTo91TaggedJets] = tagged_dijet_mass_closest_to_91;
+    variables[Evt_M2_TaggedJetsAverage] = avgM2Tagged;
+    variables[Evt_Dr_TaggedJetsAverage] = avgDrTagged;
+    variables[Evt_Deta_TaggedJetsAverage] = avgDetaTagged;
+    variables[Evt_M2_minDrTaggedJets] = closest_tagged_dijet_mass;
+    variables[Evt_Dr_minDrTaggedJets] = minDrTagged;
+    variables[Evt_Pt_minDrTaggedJets] = minPtTagged;
+    variables[Evt_Dr_maxDrTaggedJets] = maxDrTagged;
+    variables[Evt_Dr_closestTo91TaggedJets] = DrTagged91;
 
 
     // dijet variables (all jets)
-    variableMap["Evt_M2_JetsAverage"] = avgM2Jets;
-    variableMap["Evt_Dr_JetsAverage"] = avgDrJets;
-    variableMap["Evt_Deta_JetsAverage"] = avgDetaJets;
-    variableMap["Evt_M2_minDrJets"] = closest_dijet_mass;
-    variableMap["Evt_Dr_minDrJets"] = minDrJets;
-    variableMap["Evt_Pt_minDrJets"] = minPtJets;
-    variableMap["Evt_Dr_maxDrJets"] = maxDrJets;
+    variables[Evt_M2_JetsAverage] = avgM2Jets;
+    variables[Evt_Dr_JetsAverage] = avgDrJets;
+    variables[Evt_Deta_JetsAverage] = avgDetaJets;
+    variables[Evt_M2_minDrJets] = closest_dijet_mass;
+    variables[Evt_Dr_minDrJets] = minDrJets;
+    variables[Evt_Pt_minDrJets] = minPtJets;
+    variables[Evt_Dr_maxDrJets] = maxDrJets;
 
     // dijet variables (untagged jets)
-    variableMap["Evt_M2_UntaggedJetsAverage"] = avgM2Untagged;
-    variableMap["Evt_Dr_UntaggedJetsAverage"] = avgDrUntagged;
-    variableMap["Evt_Deta_UntaggedJetsAverage"] = avgDetaUntagged;
-    variableMap["Evt_M2_minDrUntaggedJets"] = closest_untagged_dijet_mass;
-    variableMap["Evt_Dr_minDrUntaggedJets"] = minDrUntagged;
-    variableMap["Evt_Pt_minDrUntaggedJets"] = minPtUntagged;
-    variableMap["Evt_Dr_maxDrUntaggedJets"] = maxDrUntagged;
+    variables[Evt_M2_UntaggedJetsAverage] = avgM2Untagged;
+    variables[Evt_Dr_UntaggedJetsAverage] = avgDrUntagged;
+    variables[Evt_Deta_UntaggedJetsAverage] = avgDetaUntagged;
+    variables[Evt_M2_minDrUntaggedJets] = closest_untagged_dijet_mass;
+    variables[Evt_Dr_minDrUntaggedJets] = minDrUntagged;
+    variables[Evt_Pt_minDrUntaggedJets] = minPtUntagged;
+    variables[Evt_Dr_maxDrUntaggedJets] = maxDrUntagged;
 
     // max detas 
-    variableMap["Evt_Deta_maxDetaJetJet"] = jet_jet_etamax;
-    variableMap["Evt_Deta_maxDetaTagTag"] = tag_tag_etamax;
-    variableMap["Evt_Deta_maxDetaJetTag"] = jet_tag_etamax;
+    variables[Evt_Deta_maxDetaJetJet] = jet_jet_etamax;
+    variables[Evt_Deta_maxDetaTagTag] = tag_tag_etamax;
+    variables[Evt_Deta_maxDetaJetTag] = jet_tag_etamax;
 
     // lepton + jet variables
-    variableMap["Evt_Dr_minDrLepTag"] = dr_between_lep_and_closest_tagged_jet;
-    variableMap["Evt_Dr_minDrLepJet"] = dr_between_lep_and_closest_jet;
-    variableMap["Evt_M_minDrLepTag"] = Mlb;
-    variableMap["Evt_M_minDrLepJet"] = Mlj;
+    variables[Evt_Dr_minDrLepTag] = dr_between_lep_and_closest_tagged_jet;
+    variables[Evt_Dr_minDrLepJet] = dr_between_lep_and_closest_jet;
+    variables[Evt_M_minDrLepTag] = Mlb;
+    variables[Evt_M_minDrLepJet] = Mlj;
 
     // event shape variables
-    variableMap["Evt_aplanarity"] = aplanarity;
-    variableMap["Evt_aplanarity_jets"] = aplanarity_jets;
-    variableMap["Evt_aplanarity_tags"] = aplanarity_tags;
-    variableMap["Evt_sphericity"] = sphericity;
-    variableMap["Evt_sphericity_jets"] = sphericity_jets;
-    variableMap["Evt_sphericity_tags"] = sphericity_tags;
-    variableMap["Evt_transverse_sphericity"] = transverse_sphericity;
-    variableMap["Evt_transverse_sphericity_jets"] = transverse_sphericity_jets;
-    variableMap["Evt_transverse_sphericity_tags"] = transverse_sphericity_tags;
-    variableMap["Evt_JetPt_over_JetE"] = pt_E_ratio;
-    variableMap["Evt_TaggedJetPt_over_TaggedJetE"] = pt_E_ratio_tag;
+    variables[Evt_aplanarity] = aplanarity;
+    variables[Evt_aplanarity_jets] = aplanarity_jets;
+    variables[Evt_aplanarity_tags] = aplanarity_tags;
+    variables[Evt_sphericity] = sphericity;
+    variables[Evt_sphericity_jets] = sphericity_jets;
+    variables[Evt_sphericity_tags] = sphericity_tags;
+    variables[Evt_transverse_sphericity] = transverse_sphericity;
+    variables[Evt_transverse_sphericity_jets] = transverse_sphericity_jets;
+    variables[Evt_transverse_sphericity_tags] = transverse_sphericity_tags;
+    variables[Evt_JetPt_over_JetE] = pt_E_ratio;
+    variables[Evt_TaggedJetPt_over_TaggedJetE] = pt_E_ratio_tag;
 
     // reconstructed WLep variables
-    variableMap["Reco_WLep_E"] = Wlep.E();
-    variableMap["Reco_WLep_Eta"] = Wlep.Eta();
-    variableMap["Reco_WLep_Phi"] = Wlep.Phi();
-    variableMap["Reco_WLep_Pt"] = Wlep.Pt();
-    variableMap["Reco_WLep_Mass"] = Wlep.M();
+    variables[Reco_WLep_E] = Wlep.E();
+    variables[Reco_WLep_Eta] = Wlep.Eta();
+    variables[Reco_WLep_Phi] = Wlep.Phi();
+    variables[Reco_WLep_Pt] = Wlep.Pt();
+    variables[Reco_WLep_Mass] = Wlep.M();
 
 }
@@ -14,25 +14,49 @@ MVAvarsBase::~MVAvarsBase()
 {
 }
 
+float MVAvarsBase::GetDefault(const std::string& variablelabel) const
+{
+    if ((variablelabel.find("eta") != string::npos) and not (variablelabel.find("abs") != string::npos))
+	{
+	    return -5.;
+	}
+    else if (variablelabel.find("phi") != string::npos)
+	{
+	    return -5.;
+	}
+    return globalDefault;
+}
+
+void MVAvarsBase::InitVariables()
+{
+    defaults.resize(Recolabels.size());
+    for (unsigned int i = 0; i < Recolabels.size(); i++)
+	{
+	    defaults[i] = GetDefault(Recolabels[i]);
+	}
+    variables = defaults;
+}
+
 void MVAvarsBase::ResetVariableMap()
 {
-    for (auto it = variableMap.begin(); it != variableMap.end(); it++)
+    std::copy(defaults.begin(), defaults.end(), variables.begin());
+    for (auto it = extraVariables.begin(); it != extraVariables.end(); it++)
 	{
-	    if ((it->first.find("eta") != string::npos) and not (it->first.find("abs") != string::npos))
-		{
-		    it->second = -5.;
-		}
-	    else if (it->first.find("phi") != string::npos)
-		{
-		    it->second = -5.;
-		}
-	    else
-		{
-		    it->second = globalDefault;
-		}
+	    it->second = GetDefault(it->first);
 	}
 }
 
+float* MVAvarsBase::GetAdress(std::string variablelabel)
+{
+    for (unsigned int i = 0; i < Recolabels.size(); i++)
+	{
+	    if (Recolabels[i] == variablelabel) return &variables[i];
+	}
+    std::cout << "WARNING: " << variablelabel << " is not a variable of this hypothesis, it stays at its default\n";
+    auto it = extraVariables.insert(std::make_pair(variablelabel, GetDefault(variablelabel))).first;
+    return &it->second;
+}
+
 void MVAvarsBase::SetWP(double WP){
     btagMcut = WP;
 }
@@ -65,7 +89,7 @@ std::map<std::string, float> MVAvarsBase::GetMVAvars(const std::vector<TLorentzV
 						     const TLorentzVector &metP4)
 {
     FillMVAvarMap(selectedLeptonP4, selectedJetP4, selectedJetCSV, metP4);
-    return variableMap;
+    return GetVariables();
 }
 
 std::map<std::string, float> MVAvarsBase::GetMVAvars(   const std::vector<TLorentzVector> &selectedLeptonP4,
@@ -75,15 +99,7 @@ std::map<std::string, float> MVAvarsBase::GetMVAvars(   const std::vector<TLoren
                                                         const std::vector<int> &jets_idx)
 {
     FillMVAvarMap(selectedLeptonP4, selectedJetP4, selectedJetCSV, metP4, jets_idx);
-    return variableMap;
-}
-
-std::map<std::string, TLorentzVector> MVAvarsBase::GetVectors(  const TLorentzVector &selectedLeptonP4,
-                                                                const std::vector<TLorentzVector> &selectedJetP4,
-                                                                const TLorentzVector &metP4,
-                                                                const std::vector<int> &jets_idx)
-{
-    return std::map<std::string, TLorentzVector>();
+    return GetVariables();
 }
 
 bool MVAvarsBase::SkipEvent(const std::vector<TLorentzVector> &selectedJetP4,
@@ -95,8 +111,13 @@ bool MVAvarsBase::SkipEvent(const std::vector<TLorentzVector> &selectedJetP4,
 }
 
 
-std::map<std::string, float>& MVAvarsBase::GetVariables()
+std::map<std::string, float> MVAvarsBase::GetVariables()
 {
+    std::map<std::string, float> variableMap(extraVariables);
+    for (unsigned int i = 0; i < Recolabels.size(); i++)
+	{
+	    variableMap[Recolabels[i]] = variables[i];
+	}
     return variableMap;
 }
 
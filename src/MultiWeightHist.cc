@@ -0,0 +1,86 @@
+//-----------------------------------------------------------------------------
+// Histograms filled with a vector of event weights.
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include "MultiWeightHist.h"
+#include "tnm.h"
+//-----------------------------------------------------------------------------
+
+///
+int MultiWeightHist::book(int nbins, double low, double high, int nweights)
+{
+  if ( nbins < 1 || !(high > low) )
+    error("MultiWeightHist::book - invalid binning");
+  if ( nweights < 1 )
+    error("MultiWeightHist::book - need at least one weight");
+  HistAccumulator::axis a = {nbins, low, high, high - low};
+  axes_.push_back(a);
+  nweights_.push_back(nweights);
+  offsets_.push_back(sumw_.size());
+  size_t n = (size_t)(nbins + 2) * nweights;
+  sumw_.resize(sumw_.size() + n, 0);
+  sumw2_.resize(sumw2_.size() + n, 0);
+  entries_.push_back(0);
+  return (int)axes_.size() - 1;
+}
+
+///
+void MultiWeightHist::fill(int h, double x, double w, int n,
+                           const float* weights)
+{
+  const int nw = nweights_[h];
+  const int m  = std::min(n, nw);
+  size_t slot  = offsets_[h] + (size_t)findBin(h, x) * nw;
+  double* sumw  = &sumw_[slot];
+  double* sumw2 = &sumw2_[slot];
+  for(int k=0; k < m; k++)
+    {
+      double wk = w * weights[k];
+      sumw[k]  += wk;
+      sumw2[k] += wk*wk;
+    }
+  for(int k=m; k < nw; k++)
+    {
+      sumw[k]  += w;
+      sumw2[k] += w*w;
+    }
+  entries_[h] += 1;
+}
+
+///
+void MultiWeightHist::reset()
+{
+  std::fill(sumw_.begin(), sumw_.end(), 0);
+  std::fill(sumw2_.begin(), sumw2_.end(), 0);
+  std::fill(entries_.begin(), entries_.end(), 0);
+}
+
+///
+void MultiWeightHist::clear()
+{
+  axes_.clear();
+  nweights_.clear();
+  offsets_.clear();
+  sumw_.clear();
+  sumw2_.clear();
+  entries_.clear();
+}
+
+///
+TH2D* MultiWeightHist::makeTH2D(int h, const TString& name,
+                                const TString& title) const
+{
+  const HistAccumulator::axis& a = axes_[h];
+  const int nw = nweights_[h];
+  TH2D* hist = new TH2D(name, title, a.nbins, a.low, a.high, nw, 0, nw);
+  hist->Sumw2();
+  for(int bin=0; bin < a.nbins + 2; bin++)
+    for(int k=0; k < nw; k++)
+      {
+        hist->SetBinContent(bin, k + 1, getBinContent(h, bin, k));
+        hist->SetBinError(bin, k + 1, std::sqrt(getBinSumw2(h, bin, k)));
+      }
+  hist->SetEntries(entries_[h]);
+  return hist;
+}
@@ -24,64 +24,28 @@ using namespace std;
 ////////////////////////////////////////////////////////////////////////////////
 
 //______________________________________________________________________________
-PermutationManager::PermutationManager(unsigned int N_idx, unsigned int Jets_Max) : Nidx(N_idx), JetsMax(Jets_Max)
+PermutationManager::PermutationManager(unsigned int N_idx, unsigned int Jets_Max,
+                                       const std::vector<positions>& symmetric_positions) :
+    Nidx(N_idx), JetsMax(Jets_Max), symmetric(symmetric_positions)
 {
     if(Nidx > JetsMax)
     {
         cout << "error: number of indizes > max number of jets" << endl;
     }
-
-    for(unsigned int Njets=Nidx; Njets<=JetsMax; Njets++)
+    if(JetsMax > 256)
     {
-        std::vector<std::vector<int>> temp;
-
-        unsigned int comb[Nidx];
-        for(unsigned int idx=0; idx<Nidx; idx++)
-        {
-            comb[idx] = Njets-1;
-        }
-
-        unsigned int sum = 999;
-        bool reduce;
-        bool skip;
-
-        // fill permutations
-        while(sum > 0)
+        cout << "error: jet indizes are stored in 8 bits, max number of jets > 256" << endl;
+    }
+    for(unsigned int s=0; s<symmetric.size(); s++)
+    {
+        if(symmetric[s].first >= Nidx || symmetric[s].second >= Nidx || symmetric[s].first == symmetric[s].second)
         {
-            std::vector<int> combination;
-            reduce = true;
-            skip = false;
-            sum = 0;
-            for(unsigned int idx=0; idx<Nidx; idx++)
-            {
-                combination.push_back(comb[idx]);
-
-                // skip combinations with double indizes
-                for(unsigned int idx2=0; idx2<idx; idx2++)
-                {
-                    if(comb[idx] == comb[idx2]) skip=true;
-                }
-            }
-            if(!skip) temp.push_back(combination);
-
-            for(unsigned int idx=0; idx<Nidx; idx++)
-            {
-                // reduce by 1
-                if(reduce && comb[idx]>0)
-                {
-                    comb[idx] = comb[idx] - 1;
-                    reduce = false;
-                }
-                else if (reduce)
-                {
-                    comb[idx] = Njets-1;
-                }
-
-                sum += comb[idx];
-            }
+            cout << "error: symmetric positions " << symmetric[s].first << ", " << symmetric[s].second << " out of range" << endl;
         }
-        permutations.push_back(temp);
     }
+
+    // tables are generated on first use
+    if(JetsMax >= Nidx) permutations.resize(JetsMax - Nidx + 1);
 }
 
 
@@ -97,21 +61,29 @@ PermutationManager::~PermutationManager()
 ////////////////////////////////////////////////////////////////////////////////
 unsigned int PermutationManager::get_Npermutations(unsigned int Njets)
 {
-    return permutations.at(getIndex(Njets)).size();
+    return getTable(Njets).size() / Nidx;
 }
 
 
-void PermutationManager::get_permutation(std::vector<int>* permutation, unsigned int Njets, unsigned int i)
+const uint8_t* PermutationManager::get_permutation(unsigned int Njets, unsigned int i)
 {
-    if(i >= get_Npermutations(Njets)) cout << "error: permutation index out of range!" << endl;
+    const std::vector<uint8_t>& table = getTable(Njets);
+    if(i >= table.size() / Nidx) cout << "error: permutation index out of range!" << endl;
+
+    return &table.at(i * Nidx);
+}
 
-    *permutation = permutations[getIndex(Njets)].at(i);
+
+void PermutationManager::get_permutation(std::vector<int>* permutation, unsigned int Njets, unsigned int i)
+{
+    const uint8_t* comb = get_permutation(Njets, i);
+    permutation->assign(comb, comb + Nidx);
 }
 
 
 void PermutationManager::show()
 {
-    cout << "Permutationmanager for " << Nidx << " indizes" << endl;
+    cout << "Permutationmanager for " << Nidx << " indizes, " << symmetric.size() << " symmetric pairs" << endl;
     cout << "NJets (Index),     theo,       generated permutations" << endl;
     for(unsigned int i=Nidx; i<=JetsMax; i++)
     {
@@ -123,15 +95,14 @@ void PermutationManager::show()
 
 void PermutationManager::show(unsigned int Njets)
 {
-    std::vector<std::vector<int>> combinations = permutations.at(getIndex(Njets));
-
     cout << "permutations for " << Nidx << " indizes and " << Njets << " jets" << endl;
 
     for(unsigned int n=0; n<get_Npermutations(Njets); n++)
     {
+        const uint8_t* comb = get_permutation(Njets, n);
         for(unsigned int idx=0; idx<Nidx; idx++)
         {
-            cout << combinations.at(n).at(idx) << "\t";
+            cout << int(comb[idx]) << "\t";
         }
         cout << endl;
     }
@@ -154,3 +125,57 @@ unsigned int PermutationManager::getIndex(unsigned int Njets)
 
     return Njets - Nidx;
 }
+
+
+const std::vector<uint8_t>& PermutationManager::getTable(unsigned int Njets)
+{
+    unsigned int index = getIndex(Njets);
+    Njets = index + Nidx;
+    std::vector<uint8_t>& table = permutations.at(index);
+    if(!table.empty() || Nidx == 0) return table;
+
+    // Njets!/(Njets-Nidx)!, halved per pair of symmetric positions
+    double count = TMath::Factorial(Njets)/TMath::Factorial(Njets - Nidx);
+    for(unsigned int s=0; s<symmetric.size(); s++) count /= 2;
+    table.reserve((size_t)(count + 0.5) * Nidx);
+
+    std::vector<uint8_t> comb(Nidx);
+    std::vector<uint8_t> used(Njets, 0);
+    fill(table, &comb[0], &used[0], Nidx - 1, Njets);
+    return table;
+}
+
+
+// Assign the positions idx, idx-1, ..., 0 with the jets not used yet, from
+// the highest jet index down: the order of the former brute-force counting,
+// without the combinations with double indizes.
+void PermutationManager::fill(std::vector<uint8_t>& table, uint8_t* comb, uint8_t* used, int idx, unsigned int Njets)
+{
+    if(idx < 0)
+    {
+        table.insert(table.end(), comb, comb + Nidx);
+        return;
+    }
+
+    for(int jet=Njets-1; jet>=0; jet--)
+    {
+        if(used[jet]) continue;
+
+        // symmetric positions: the other one is already assigned, keep the
+        // lower jet index at the first position
+        bool skip = false;
+        for(unsigned int s=0; s<symmetric.size() && !skip; s++)
+        {
+            if(symmetric[s].first == (unsigned int)idx && symmetric[s].second > (unsigned int)idx)
+                skip = jet > comb[symmetric[s].second];
+            else if(symmetric[s].second == (unsigned int)idx && symmetric[s].first > (unsigned int)idx)
+                skip = comb[symmetric[s].first] > jet;
+        }
+        if(skip) continue;
+
+        comb[idx] = jet;
+        used[jet] = 1;
+        fill(table, comb, used, idx - 1, Njets);
+        used[jet] = 0;
+    }
+}
@@ -0,0 +1,222 @@
+//-----------------------------------------------------------------------------
+// Streaming quantile sketch (KLL).
+//-----------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "QuantileSketch.h"
+#include "tnm.h"
+//-----------------------------------------------------------------------------
+
+///
+QuantileSketch::QuantileSketch(int k)
+  : k_(k),
+    n_(0),
+    min_(std::numeric_limits<double>::infinity()),
+    max_(-std::numeric_limits<double>::infinity()),
+    coin_(0),
+    size_(0),
+    maxSize_(0)
+{
+  if ( k < 8 ) error("QuantileSketch - k must be at least 8");
+  grow();
+}
+
+///
+int QuantileSketch::capacity(int level) const
+{
+  // capacities shrink by 2/3 per level below the top one
+  int depth = (int)levels_.size() - 1 - level;
+  int c = (int)std::ceil(k_ * std::pow(2.0 / 3.0, depth));
+  return c < 2 ? 2 : c;
+}
+
+///
+void QuantileSketch::grow()
+{
+  levels_.push_back(std::vector<double>());
+  maxSize_ = 0;
+  for(unsigned h=0; h < levels_.size(); h++) maxSize_ += capacity(h);
+}
+
+///
+void QuantileSketch::add(double x)
+{
+  if ( x != x ) return;
+  if ( x < min_ ) min_ = x;
+  if ( x > max_ ) max_ = x;
+  n_++;
+  levels_[0].push_back(x);
+  size_++;
+  if ( size_ >= maxSize_ ) compress();
+}
+
+///
+void QuantileSketch::compress()
+{
+  for(unsigned h=0; h < levels_.size(); h++)
+    {
+      if ( (int)levels_[h].size() < capacity(h) ) continue;
+      if ( h + 1 == levels_.size() ) grow();
+      std::vector<double>& level = levels_[h];
+      std::vector<double>& up = levels_[h+1];
+      std::sort(level.begin(), level.end());
+
+      // splitmix64 step for the offset: keep the odd or the even values
+      coin_ += 0x9E3779B97F4A7C15ULL;
+      uint64_t z = coin_;
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      int offset = (z ^ (z >> 31)) & 1;
+
+      // an odd value out stays at this level
+      size_t npairs = level.size() / 2;
+      size_t first = level.size() - 2 * npairs;
+      for(size_t i=0; i < npairs; i++)
+        up.push_back(level[first + 2*i + offset]);
+      level.resize(first);
+
+      size_ = 0;
+      for(unsigned l=0; l < levels_.size(); l++) size_ += levels_[l].size();
+      break;
+    }
+}
+
+///
+void QuantileSketch::merge(const QuantileSketch& other)
+{
+  if ( other.k_ != k_ ) error("QuantileSketch::merge - different k");
+  while ( levels_.size() < other.levels_.size() ) grow();
+  for(unsigned h=0; h < other.levels_.size(); h++)
+    levels_[h].insert(levels_[h].end(),
+                      other.levels_[h].begin(), other.levels_[h].end());
+  n_ += other.n_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+  size_ = 0;
+  for(unsigned h=0; h < levels_.size(); h++) size_ += levels_[h].size();
+  while ( size_ >= maxSize_ )
+    {
+      size_t before = size_;
+      compress();
+      if ( size_ == before ) break;
+    }
+}
+
+///
+void QuantileSketch::weighted(std::vector<std::pair<double, double> >& items)
+  const
+{
+  items.clear();
+  items.reserve(size_);
+  double w = 1;
+  for(unsigned h=0; h < levels_.size(); h++, w *= 2)
+    for(unsigned i=0; i < levels_[h].size(); i++)
+      items.push_back(std::make_pair(levels_[h][i], w));
+  std::sort(items.begin(), items.end());
+}
+
+///
+double QuantileSketch::quantile(double q) const
+{
+  if ( n_ == 0 ) return 0;
+  if ( q <= 0 ) return min_;
+  if ( q >= 1 ) return max_;
+  std::vector<std::pair<double, double> > items;
+  weighted(items);
+  double total = 0;
+  for(unsigned i=0; i < items.size(); i++) total += items[i].second;
+  double target = q * total, sum = 0;
+  for(unsigned i=0; i < items.size(); i++)
+    {
+      sum += items[i].second;
+      if ( sum >= target ) return items[i].first;
+    }
+  return max_;
+}
+
+///
+double QuantileSketch::cdf(double x) const
+{
+  double below = 0, total = 0, w = 1;
+  for(unsigned h=0; h < levels_.size(); h++, w *= 2)
+    for(unsigned i=0; i < levels_[h].size(); i++)
+      {
+        total += w;
+        if ( levels_[h][i] < x ) below += w;
+      }
+  return total > 0 ? below / total : 0;
+}
+
+///
+std::vector<double> QuantileSketch::suggestEdges(int nbins, double minWidth)
+  const
+{
+  std::vector<double> edges;
+  if ( n_ == 0 || nbins < 1 ) return edges;
+  edges.push_back(min_);
+  for(int b=1; b < nbins; b++)
+    {
+      double x = quantile(double(b) / nbins);
+      if ( x - edges.back() > minWidth ) edges.push_back(x);
+    }
+  // the last edge is just above the maximum so that it is in range
+  double top = max_ + std::max(minWidth, 1e-6 * (std::fabs(max_) + 1));
+  if ( edges.size() > 1 && top - edges.back() < minWidth ) edges.pop_back();
+  edges.push_back(top);
+  return edges;
+}
+
+///
+TH1F* QuantileSketch::makeTH1F(const TString& name, const TString& title,
+                               const std::vector<double>& edges) const
+{
+  if ( edges.size() < 2 ) error("QuantileSketch::makeTH1F - need two edges");
+  TH1F* hist = new TH1F(name, title, edges.size() - 1, &edges[0]);
+  double w = 1;
+  for(unsigned h=0; h < levels_.size(); h++, w *= 2)
+    for(unsigned i=0; i < levels_[h].size(); i++)
+      hist->Fill(levels_[h][i], w);
+  return hist;
+}
+
+///
+std::vector<double> QuantileSketch::serialize() const
+{
+  std::vector<double> data;
+  data.push_back(k_);
+  data.push_back(n_);
+  data.push_back(min_);
+  data.push_back(max_);
+  data.push_back(levels_.size());
+  for(unsigned h=0; h < levels_.size(); h++)
+    {
+      data.push_back(levels_[h].size());
+      data.insert(data.end(), levels_[h].begin(), levels_[h].end());
+    }
+  return data;
+}
+
+///
+QuantileSketch QuantileSketch::deserialize(const std::vector<double>& data)
+{
+  if ( data.size() < 5 ) error("QuantileSketch::deserialize - bad data");
+  QuantileSketch sketch((int)data[0]);
+  sketch.n_ = (long)data[1];
+  sketch.min_ = data[2];
+  sketch.max_ = data[3];
+  int nlevels = (int)data[4];
+  while ( (int)sketch.levels_.size() < nlevels ) sketch.grow();
+  size_t pos = 5;
+  for(int h=0; h < nlevels; h++)
+    {
+      if ( pos >= data.size() ) error("QuantileSketch::deserialize - bad data");
+      size_t size = (size_t)data[pos++];
+      if ( pos + size > data.size() )
+        error("QuantileSketch::deserialize - bad data");
+      sketch.levels_[h].assign(data.begin() + pos, data.begin() + pos + size);
+      pos += size;
+      sketch.size_ += size;
+    }
+  return sketch;
+}
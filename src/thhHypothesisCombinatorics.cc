@@ -24,4 +24,5 @@ HypothesisCombinatorics(optional_varstring)
 
 thhHypothesisCombinatorics::~thhHypothesisCombinatorics(){}
 
-PermutationManager thhHypothesisCombinatorics::permutator(minJets, 18);
+// the daughters of the W / H are interchangeable: generated once, ordered by pT
+PermutationManager thhHypothesisCombinatorics::permutator(minJets, 18, {{tHH_h1dau1_idx, tHH_h1dau2_idx}, {tHH_h2dau3_idx, tHH_h2dau4_idx}});
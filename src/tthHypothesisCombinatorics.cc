@@ -24,4 +24,5 @@ HypothesisCombinatorics(optional_varstring)
 
 tthHypothesisCombinatorics::~tthHypothesisCombinatorics(){}
 
-PermutationManager tthHypothesisCombinatorics::permutator(minJets, 18);
+// the daughters of the W / H are interchangeable: generated once, ordered by pT
+PermutationManager tthHypothesisCombinatorics::permutator(minJets, 18, {{ttH_whaddau1_idx, ttH_whaddau2_idx}, {ttH_hdau1_idx, ttH_hdau2_idx}});
@@ -0,0 +1,122 @@
+//
+// benchHistFill.cc
+//
+//   description: Throughput of histogram filling: TH1F::Fill per value,
+//                HistAccumulator::fill per value and HistAccumulator::fillN
+//                over blocks of events (the HistogramRegistry block mode).
+//
+
+#include "HistAccumulator.h"
+#include "TH1F.h"
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+
+using namespace std;
+
+const int nhists = 100;
+const int nevents = 200000;
+const int blocksize = 1024;
+
+const int ntrials = 5;    // best of, against timing noise
+
+double seconds(chrono::steady_clock::time_point start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+int main()
+{
+  // event-major values, as produced by the analysis (one value per histogram
+  // and event) and one weight per event
+  mt19937 generator(12345);
+  normal_distribution<double> gauss(0, 1);
+  vector<double> values((size_t)nhists * nevents), weights(nevents);
+  for(int i=0; i < nevents; i++)
+    {
+      weights[i] = 0.8 + 0.4 * fabs(gauss(generator));
+      for(int h=0; h < nhists; h++)
+        values[(size_t)i * nhists + h] = 100 + 150 * gauss(generator);
+    }
+  double nfills = (double)nhists * nevents;
+
+  // TH1F::Fill per value
+  vector<TH1F*> roothists;
+  for(int h=0; h < nhists; h++)
+    {
+      roothists.push_back(new TH1F(TString::Format("h%d", h), "", 50, 0, 500));
+      roothists.back()->Sumw2();
+      roothists.back()->SetDirectory(0);
+    }
+  double troot = 1e30;
+  for(int trial=0; trial < ntrials; trial++)
+    {
+      for(int h=0; h < nhists; h++) roothists[h]->Reset();
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for(int i=0; i < nevents; i++)
+        for(int h=0; h < nhists; h++)
+          roothists[h]->Fill(values[(size_t)i * nhists + h], weights[i]);
+      troot = min(troot, seconds(start));
+    }
+
+  // HistAccumulator::fill per value
+  HistAccumulator single;
+  for(int h=0; h < nhists; h++) single.book(50, 0, 500);
+  double tsingle = 1e30;
+  for(int trial=0; trial < ntrials; trial++)
+    {
+      single.reset();
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for(int i=0; i < nevents; i++)
+        for(int h=0; h < nhists; h++)
+          single.fill(h, values[(size_t)i * nhists + h], weights[i]);
+      tsingle = min(tsingle, seconds(start));
+    }
+
+  // block fill: buffer a block per histogram, then fillN
+  HistAccumulator block = single.emptyCopy();
+  vector<double> bufx((size_t)nhists * blocksize), bufw((size_t)nhists * blocksize);
+  double tblock = 1e30, tbuffer = 1e30;
+  for(int trial=0; trial < ntrials; trial++)
+    {
+      block.reset();
+      double buffering = 0;
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for(int first=0; first < nevents; first += blocksize)
+        {
+          chrono::steady_clock::time_point startbuffer = chrono::steady_clock::now();
+          int n = min(blocksize, nevents - first);
+          for(int i=0; i < n; i++)
+            for(int h=0; h < nhists; h++)
+              {
+                bufx[(size_t)h * blocksize + i] = values[(size_t)(first + i) * nhists + h];
+                bufw[(size_t)h * blocksize + i] = weights[first + i];
+              }
+          buffering += seconds(startbuffer);
+          for(int h=0; h < nhists; h++)
+            block.fillN(h, n, &bufx[(size_t)h * blocksize], &bufw[(size_t)h * blocksize]);
+        }
+      tblock = min(tblock, seconds(start));
+      tbuffer = min(tbuffer, buffering);
+    }
+
+  int nmismatch = 0;
+  for(int h=0; h < nhists; h++)
+    for(int bin=0; bin < 52; bin++)
+      {
+        if ( block.getBinContent(h, bin) != single.getBinContent(h, bin) ) nmismatch++;
+        if ( block.getBinContent(h, bin) != roothists[h]->GetBinContent(bin) ) nmismatch++;
+      }
+
+  cout << "fills: " << nfills << " (" << nhists << " histograms x "
+       << nevents << " events)" << endl;
+  cout << "TH1F::Fill              : " << nfills / troot / 1e6 << " Mfills/s" << endl;
+  cout << "HistAccumulator::fill   : " << nfills / tsingle / 1e6 << " Mfills/s" << endl;
+  cout << "HistAccumulator::fillN  : " << nfills / tblock / 1e6 << " Mfills/s"
+       << " (block " << blocksize << ", buffering included)" << endl;
+  cout << "  of which fillN only     : " << nfills / (tblock - tbuffer) / 1e6
+       << " Mfills/s" << endl;
+  cout << "bin content mismatches: " << nmismatch << endl;
+  return nmismatch ? 1 : 0;
+}
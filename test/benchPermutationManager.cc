@@ -0,0 +1,182 @@
+//
+// benchPermutationManager.cc
+//
+//   description: Startup time and resident memory of PermutationManager(6,18)
+//                (the static permutators of the ttH / tHH combinatorics),
+//                cost of the tables built on first use per jet multiplicity,
+//                and a check of the tables against the brute-force counting
+//                over Njets^6 for small multiplicities. With the argument
+//                "baseline", also the eager construction of the former
+//                implementation (every table up to 18 jets as nested vectors,
+//                in the constructor) for comparison: tens of seconds and
+//                gigabytes.
+//
+
+#include "PermutationManager.h"
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+const unsigned int nidx = 6;
+const unsigned int jetsmax = 18;
+
+double seconds(chrono::steady_clock::time_point start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// resident set size in kB (Linux), 0 if unknown
+long residentkB()
+{
+  long size = 0, resident = 0;
+  FILE* f = fopen("/proc/self/statm", "r");
+  if ( !f ) return 0;
+  if ( fscanf(f, "%ld %ld", &size, &resident) != 2 ) resident = 0;
+  fclose(f);
+  return resident * 4;
+}
+
+// brute-force counting of the former implementation: all Njets^nidx index
+// combinations from the highest down, without double indices, and with the
+// lower jet index first at symmetric positions
+vector<vector<int> > bruteForce(unsigned int njets,
+                                const vector<PermutationManager::positions>& symmetric)
+{
+  vector<vector<int> > result;
+  vector<int> comb(nidx, njets - 1);
+  while ( true )
+    {
+      bool skip = false;
+      for(unsigned int i=0; i < nidx; i++)
+        for(unsigned int j=0; j < i; j++)
+          if ( comb[i] == comb[j] ) skip = true;
+      for(unsigned int s=0; s < symmetric.size(); s++)
+        if ( comb[symmetric[s].first] > comb[symmetric[s].second] ) skip = true;
+      if ( !skip ) result.push_back(comb);
+      unsigned int i = 0;
+      while ( i < nidx && comb[i] == 0 ) comb[i++] = njets - 1;
+      if ( i == nidx ) break;
+      comb[i]--;
+    }
+  return result;
+}
+
+// tables of the former constructor: every multiplicity from nidx to jetsmax,
+// all index combinations without double indices as vector<int>
+vector<vector<vector<int> > > eagerTables()
+{
+  vector<vector<vector<int> > > permutations;
+  for(unsigned int njets=nidx; njets <= jetsmax; njets++)
+    {
+      vector<vector<int> > temp;
+      unsigned int comb[nidx];
+      for(unsigned int idx=0; idx < nidx; idx++) comb[idx] = njets - 1;
+      unsigned int sum = 999;
+      while ( sum > 0 )
+        {
+          vector<int> combination;
+          bool reduce = true, skip = false;
+          sum = 0;
+          for(unsigned int idx=0; idx < nidx; idx++)
+            {
+              combination.push_back(comb[idx]);
+              for(unsigned int idx2=0; idx2 < idx; idx2++)
+                if ( comb[idx] == comb[idx2] ) skip = true;
+            }
+          if ( !skip ) temp.push_back(combination);
+          for(unsigned int idx=0; idx < nidx; idx++)
+            {
+              if ( reduce && comb[idx] > 0 )
+                {
+                  comb[idx]--;
+                  reduce = false;
+                }
+              else if ( reduce ) comb[idx] = njets - 1;
+              sum += comb[idx];
+            }
+        }
+      permutations.push_back(temp);
+    }
+  return permutations;
+}
+
+int main(int argc, char** argv)
+{
+  // ttH positions: b lep, W daughters (1, 2), b had, H daughters (4, 5)
+  vector<PermutationManager::positions> symmetric;
+  symmetric.push_back(PermutationManager::positions(1, 2));
+  symmetric.push_back(PermutationManager::positions(4, 5));
+
+  long rss0 = residentkB();
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  PermutationManager plain(nidx, jetsmax);
+  PermutationManager permutator(nidx, jetsmax, symmetric);
+  double tconstruct = seconds(start);
+  long rssconstruct = residentkB() - rss0;
+
+  cout << "construction (two managers): " << tconstruct * 1e3 << " ms, "
+       << rssconstruct << " kB resident" << endl;
+
+  // tables on first use, then iteration over a built table
+  cout << "Njets  assignments    first use [ms]  iteration [ms]  table [kB]" << endl;
+  long checksum = 0;
+  for(unsigned int njets=nidx; njets <= jetsmax; njets++)
+    {
+      long rss = residentkB();
+      start = chrono::steady_clock::now();
+      unsigned int n = permutator.get_Npermutations(njets);
+      double tbuild = seconds(start);
+      start = chrono::steady_clock::now();
+      for(unsigned int i=0; i < n; i++)
+        {
+          const uint8_t* comb = permutator.get_permutation(njets, i);
+          checksum += comb[0] + comb[nidx - 1];
+        }
+      double titerate = seconds(start);
+      printf("%5u  %11u  %14.2f  %14.2f  %10ld\n", njets, n, tbuild * 1e3,
+             titerate * 1e3, residentkB() - rss);
+    }
+  cout << "resident after all tables: " << residentkB() - rss0 << " kB"
+       << " (checksum " << checksum << ")" << endl;
+
+  // same assignments, in the same order, as the brute-force counting
+  long nmismatch = 0;
+  for(unsigned int njets=nidx; njets <= 9; njets++)
+    for(int withsymmetry=0; withsymmetry < 2; withsymmetry++)
+      {
+        PermutationManager& manager = withsymmetry ? permutator : plain;
+        vector<PermutationManager::positions> none;
+        vector<vector<int> > expected = bruteForce(njets, withsymmetry ? symmetric : none);
+        if ( expected.size() != manager.get_Npermutations(njets) )
+          {
+            nmismatch++;
+            continue;
+          }
+        vector<int> permutation;
+        for(unsigned int i=0; i < expected.size(); i++)
+          {
+            manager.get_permutation(&permutation, njets, i);
+            if ( permutation != expected[i] ) nmismatch++;
+          }
+      }
+  cout << "mismatches with the brute-force counting: " << nmismatch << endl;
+
+  // former eager construction, two managers as the ttH and tHH statics
+  if ( argc > 1 && strcmp(argv[1], "baseline") == 0 )
+    {
+      long rss = residentkB();
+      start = chrono::steady_clock::now();
+      vector<vector<vector<int> > > tth = eagerTables();
+      vector<vector<vector<int> > > thh = eagerTables();
+      double teager = seconds(start);
+      cout << "baseline eager construction (two managers): " << teager * 1e3
+           << " ms, " << residentkB() - rss << " kB resident ("
+           << tth.back().size() << " assignments per manager at " << jetsmax
+           << " jets)" << endl;
+    }
+  return nmismatch ? 1 : 0;
+}
@@ -0,0 +1,117 @@
+//
+// testBTagEffMap.cc
+//
+//   description: Build a b-tag efficiency map from random jets, save it,
+//                load it back under the same key (identical efficiencies)
+//                and check that another working point or binning does not
+//                pick it up. Partial maps of two jobs, loaded back with their
+//                key and added (as mergeBTagEff does), give the full map.
+//
+
+#include "BTagEffMap.h"
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <stdint.h>
+
+using namespace std;
+
+double uniform(uint64_t i, uint64_t stream)
+{
+  uint64_t z = i * 0x9E3779B97F4A7C15ULL + stream * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+  return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+int main()
+{
+  vector<double> ptEdges = {30, 50, 70, 100, 140, 200, 300, 600, 1000, 3000};
+  vector<double> etaEdges = {0, 0.8, 1.6, 2.5};
+  const double trueEff[] = {0.7, 0.15, 0.02};
+  const int flavours[] = {5, 4, 0};
+
+  BTagEffMap map("testSample", 0.304, ptEdges, etaEdges);
+  const long njets = 200000;
+  for(long i=0; i < njets; i++)
+    {
+      double pt = 30 + 400 * uniform(i, 0);
+      double eta = 2.5 * uniform(i, 1);
+      int k = int(3 * uniform(i, 2));
+      BTagEffMap::flavour f = BTagEffMap::fromHadronFlavour(flavours[k]);
+      map.fill(pt, eta, f, uniform(i, 3) < trueEff[k]);
+    }
+
+  // efficiencies close to the true ones in a well populated bin
+  double maxDiff = 0;
+  for(int k=0; k < 3; k++)
+    {
+      BTagEffMap::flavour f = BTagEffMap::fromHadronFlavour(flavours[k]);
+      maxDiff = max(maxDiff, fabs(map.efficiency(60, 1.0, f) - trueEff[k]));
+    }
+
+  map.write(".");
+  BTagEffMap loaded("testSample", 0.304, ptEdges, etaEdges);
+  bool readOK = loaded.read(".");
+  long mismatches = 0;
+  for(unsigned p=0; p < ptEdges.size(); p++)
+    for(unsigned e=0; e < etaEdges.size(); e++)
+      for(int f=0; f < BTagEffMap::nFlavours; f++)
+        {
+          BTagEffMap::flavour fl = BTagEffMap::flavour(f);
+          if ( loaded.efficiency(ptEdges[p] + 1, etaEdges[e] + 0.1, fl) !=
+               map.efficiency(ptEdges[p] + 1, etaEdges[e] + 0.1, fl) )
+            mismatches++;
+        }
+
+  BTagEffMap otherWP("testSample", 0.7476, ptEdges, etaEdges);
+  vector<double> coarse = {0, 2.5};
+  BTagEffMap otherBinning("testSample", 0.304, ptEdges, coarse);
+  bool keyOK = !otherWP.read(".") && !otherBinning.read(".") &&
+    otherBinning.fileName(".") != map.fileName(".");
+
+  loaded.add(map);
+  bool addOK = fabs(loaded.entries() - 2 * map.entries()) < 1e-9;
+
+  // two jobs with half of the jets each, merged
+  BTagEffMap job1("testSample", 0.304, ptEdges, etaEdges);
+  BTagEffMap job2("testSample", 0.304, ptEdges, etaEdges);
+  for(long i=0; i < njets; i++)
+    {
+      double pt = 30 + 400 * uniform(i, 0);
+      double eta = 2.5 * uniform(i, 1);
+      int k = int(3 * uniform(i, 2));
+      BTagEffMap::flavour f = BTagEffMap::fromHadronFlavour(flavours[k]);
+      (i % 2 ? job2 : job1).fill(pt, eta, f, uniform(i, 3) < trueEff[k]);
+    }
+  job1.writePart(".", "job1");
+  job2.writePart(".", "job2");
+  BTagEffMap merged, part;
+  bool mergeOK = merged.load(job1.partName(".", "job1")) &&
+    part.load(job2.partName(".", "job2")) && merged.fileName(".") == map.fileName(".");
+  if ( mergeOK ) merged.add(part);
+  for(unsigned p=0; p < ptEdges.size() && mergeOK; p++)
+    for(unsigned e=0; e < etaEdges.size(); e++)
+      for(int f=0; f < BTagEffMap::nFlavours; f++)
+        {
+          BTagEffMap::flavour fl = BTagEffMap::flavour(f);
+          if ( merged.efficiency(ptEdges[p] + 1, etaEdges[e] + 0.1, fl) !=
+               map.efficiency(ptEdges[p] + 1, etaEdges[e] + 0.1, fl) )
+            mergeOK = false;
+        }
+
+  std::remove(map.fileName(".").c_str());
+  std::remove(job1.partName(".", "job1").c_str());
+  std::remove(job2.partName(".", "job2").c_str());
+
+  bool ok = maxDiff < 0.03 && readOK && mismatches == 0 && keyOK && addOK && mergeOK;
+  cout << "jets: " << map.entries()
+       << "  max |eff - true|: " << maxDiff
+       << "  reload mismatches: " << mismatches
+       << "  key check: " << (keyOK ? "yes" : "no")
+       << "  merged jobs: " << (mergeOK ? "same map" : "different")
+       << (ok ? "  OK" : "  FAILED") << endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+//
+// testBTagSFWeights.cc
+//
+//   description: Compare the log-space b-tag weights with the direct
+//                products of SF and (1 - SF eff) / (1 - eff) factors for
+//                random events, and check a large event stays finite.
+//
+
+#include "BTagSFWeights.h"
+#include <iostream>
+#include <cmath>
+#include <stdint.h>
+
+using namespace std;
+
+double uniform(uint64_t i, uint64_t stream)
+{
+  uint64_t z = i * 0x9E3779B97F4A7C15ULL + stream * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+  return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+int main()
+{
+  BTagSFWeights weights;
+  const long nevents = 20000;
+  double maxRelDiff = 0;
+  uint64_t j = 0;
+  for(long ev=0; ev < nevents; ev++)
+    {
+      weights.clear();
+      int njets = int(16 * uniform(ev, 0));
+      double direct[3] = {1, 1, 1};
+      for(int i=0; i < njets; i++, j++)
+        {
+          float eff = 0.01 + 0.9 * uniform(j, 1);
+          float sf = 0.9 + 0.2 * uniform(j, 2);
+          float unc = 0.05 * uniform(j, 3);
+          bool tagged = uniform(j, 4) < eff;
+          weights.add(eff, sf, unc, tagged);
+          const double s[3] = {sf, (double)sf + unc, (double)sf - unc};
+          for(int k=0; k < 3; k++)
+            direct[k] *= tagged ? s[k] : (1 - s[k] * eff) / (1 - (double)eff);
+        }
+      weights.compute();
+      for(int k=0; k < BTagSFWeights::nWeights; k++)
+        maxRelDiff = max(maxRelDiff,
+                         fabs(weights.weight(k) - direct[k]) / direct[k]);
+    }
+
+  // many tagged jets with a large SF: the product is kept as a log
+  weights.clear();
+  for(int i=0; i < 2000; i++) weights.add(0.5, 2, 0.1, true);
+  weights.compute();
+  bool finite = fabs(weights.logWeight(BTagSFWeights::kNominal)
+                     - 2000 * log(2.)) < 1e-6;
+
+  // SF of one: unit nominal weight
+  weights.clear();
+  weights.add(0.7, 1, 0.02, true);
+  weights.add(0.3, 1, 0.02, false);
+  weights.compute();
+  bool unit = weights.weight(BTagSFWeights::kNominal) == 1;
+
+  bool ok = maxRelDiff < 1e-9 && finite && unit;
+  cout << "events: " << nevents
+       << "  max relative difference: " << maxRelDiff
+       << "  log weight finite: " << (finite ? "yes" : "no")
+       << "  unit SF: " << (unit ? "yes" : "no")
+       << (ok ? "  OK" : "  FAILED") << endl;
+  return ok ? 0 : 1;
+}
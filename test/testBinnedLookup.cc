@@ -0,0 +1,91 @@
+//
+// testBinnedLookup.cc
+//
+//   description: Fill histograms with fixed and variable bins (1-d and 2-d)
+//                with random contents and check that BinnedLookup returns
+//                exactly GetBinContent(FindBin(...)) for random points, bin
+//                edges and under/overflow, one by one and batched.
+//
+
+#include "BinnedLookup.h"
+#include "TH1D.h"
+#include "TH2D.h"
+#include <iostream>
+#include <vector>
+#include <stdint.h>
+
+using namespace std;
+
+double uniform(uint64_t i, uint64_t stream)
+{
+  uint64_t z = i * 0x9E3779B97F4A7C15ULL + stream * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+  return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// random points over [low - 10%, high + 10%], plus every bin edge
+vector<float> points(const TAxis* axis, int n, uint64_t stream)
+{
+  double low = axis->GetXmin(), high = axis->GetXmax();
+  double margin = 0.1 * (high - low);
+  vector<float> x;
+  for(int i=0; i < n; i++)
+    x.push_back(low - margin + (high - low + 2 * margin) * uniform(i, stream));
+  for(int b=1; b <= axis->GetNbins() + 1; b++)
+    x.push_back(axis->GetBinLowEdge(b));
+  return x;
+}
+
+int main()
+{
+  const int npoints = 100000;
+  long mismatches = 0, checked = 0;
+
+  // JES-like: variable pT bins, and a fixed-bin version
+  double ptEdges[] = {20, 30, 40, 50, 60, 80, 100, 150, 200, 300, 500, 1000, 3000};
+  TH1D variable("variable", "", 12, ptEdges);
+  TH1D fixed("fixed", "", 37, 20, 3000);
+  vector<TH1D*> hists1 = {&variable, &fixed};
+  for(unsigned h=0; h < hists1.size(); h++)
+    {
+      for(int b=0; b <= hists1[h]->GetNbinsX() + 1; b++)
+        hists1[h]->SetBinContent(b, 0.05 * uniform(b, 100 + h));
+      BinnedLookup table(hists1[h]);
+      vector<float> x = points(hists1[h]->GetXaxis(), npoints, h);
+      vector<float> batch(x.size());
+      table.values(&x[0], x.size(), &batch[0]);
+      for(unsigned i=0; i < x.size(); i++)
+        {
+          float expected = hists1[h]->GetBinContent(hists1[h]->FindBin(x[i]));
+          if ( table.value(x[i]) != expected ) mismatches++;
+          if ( batch[i] != expected ) mismatches++;
+          checked += 2;
+        }
+    }
+
+  // eta x pT
+  TH2D map("map", "", 10, -2.5, 2.5, 12, 20, 3000);
+  for(int by=0; by <= 13; by++)
+    for(int bx=0; bx <= 11; bx++)
+      map.SetBinContent(bx, by, uniform(by * 100 + bx, 200));
+  BinnedLookup table2(&map);
+  vector<float> eta = points(map.GetXaxis(), npoints, 10);
+  vector<float> pt = points(map.GetYaxis(), npoints, 11);
+  eta.resize(min(eta.size(), pt.size()));
+  pt.resize(eta.size());
+  vector<float> batch(eta.size());
+  table2.values(&eta[0], &pt[0], eta.size(), &batch[0]);
+  for(unsigned i=0; i < eta.size(); i++)
+    {
+      float expected = map.GetBinContent(map.FindBin(eta[i], pt[i]));
+      if ( table2.value(eta[i], pt[i]) != expected ) mismatches++;
+      if ( batch[i] != expected ) mismatches++;
+      checked += 2;
+    }
+
+  cout << "lookups: " << checked << "  mismatches: " << mismatches
+       << (mismatches == 0 ? "  OK" : "  FAILED") << endl;
+  return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+//
+// testBootstrapHist.cc
+//
+//   description: Check the Poisson(1) replica weights (mean and variance
+//                1, P(0) = exp(-1)) and that the replicas do not depend on
+//                the event order: events filled forward and backward must
+//                give the same replica histograms.
+//
+
+#include "BootstrapHist.h"
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+using namespace std;
+
+int main()
+{
+  const int nreplicas = 100;
+  const long nevents = 20000;
+  vector<unsigned char> weights(nreplicas);
+
+  // moments of the weights over all events and replicas
+  double n = 0, sum = 0, sum2 = 0, zeros = 0;
+  for(long i=0; i < nevents; i++)
+    {
+      poissonReplicaWeights(1, 1 + i / 1000, 123456 + 7 * i, nreplicas,
+                            &weights[0]);
+      for(int r=0; r < nreplicas; r++)
+        {
+          n += 1;
+          sum += weights[r];
+          sum2 += weights[r] * weights[r];
+          zeros += weights[r] == 0;
+        }
+    }
+  double mean = sum / n;
+  double variance = sum2 / n - mean * mean;
+  double p0 = zeros / n;
+  bool momentsOK = fabs(mean - 1) < 0.01 && fabs(variance - 1) < 0.02 &&
+    fabs(p0 - exp(-1.0)) < 0.005;
+  cout << "mean: " << mean << "  variance: " << variance
+       << "  P(0): " << p0 << (momentsOK ? "  OK" : "  FAILED") << endl;
+
+  // same replicas whatever the event order
+  BootstrapHist forward, backward;
+  forward.book(20, 0, 20, nreplicas);
+  backward.book(20, 0, 20, nreplicas);
+  for(long i=0; i < nevents; i++)
+    {
+      poissonReplicaWeights(1, 1 + i / 1000, 123456 + 7 * i, nreplicas,
+                            &weights[0]);
+      forward.fill(0, i % 23, 1, &weights[0]);
+    }
+  for(long i=nevents-1; i >= 0; i--)
+    {
+      poissonReplicaWeights(1, 1 + i / 1000, 123456 + 7 * i, nreplicas,
+                            &weights[0]);
+      backward.fill(0, i % 23, 1, &weights[0]);
+    }
+  int mismatches = 0;
+  for(int bin=0; bin < 22; bin++)
+    for(int r=0; r < nreplicas; r++)
+      if ( forward.getBinContent(0, bin, r) != backward.getBinContent(0, bin, r) )
+        mismatches++;
+  cout << "order mismatches: " << mismatches
+       << (mismatches == 0 ? "  OK" : "  FAILED") << endl;
+
+  return momentsOK && mismatches == 0 ? 0 : 1;
+}
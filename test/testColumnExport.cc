@@ -0,0 +1,159 @@
+//
+// testColumnExport.cc
+//
+//   description: Fill a TTree through a TreeSchema with random toy events,
+//                export the same rows as npy columns in small chunks, then
+//                map the columns back and compare them with the values read
+//                from the tree. A Float16 branch exports the full-precision
+//                value; the tree holds it rounded to 12 mantissa bits.
+//                Events failing a toy selection are written cleared, as the
+//                friend tree does: passSelection false, zeros, no objects.
+//
+
+#include "ColumnExport.h"
+#include "TreeSchema.h"
+#include "TTree.h"
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <stdint.h>
+
+using namespace std;
+
+double uniform(uint64_t i, uint64_t stream)
+{
+  uint64_t z = i * 0x9E3779B97F4A7C15ULL + stream * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+  return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+struct toyJet
+{
+  float pt, eta;
+};
+
+struct toyEvent
+{
+  vector<toyJet*> jets;
+  float met;
+  int nMuons;
+  bool trigger;
+};
+
+int main()
+{
+  const long nevents = 3000;
+  const int maxObjects = 4;
+
+  TreeSchema<toyEvent> schema;
+  typedef TreeSchema<toyEvent>::field<toyJet> jetField;
+  schema.collection<toyJet>("Jet", 10,
+                            [](toyEvent* ev){ return &ev->jets; },
+                            {jetField{"pt", [](toyJet* j){ return j->pt; }},
+                             jetField{"eta", [](toyJet* j){ return j->eta; }}});
+  schema.scalar("met", 'F', [](toyEvent* ev){ return ev->met; });
+  schema.scalar("nMuons", 'I', [](toyEvent* ev){ return ev->nMuons; });
+  schema.scalar("trigger", 'O', [](toyEvent* ev){ return ev->trigger; });
+  schema.scalar("metF16", 'f', [](toyEvent* ev){ return ev->met; });
+  bool passed = false;
+  schema.scalar("passSelection", 'O', &passed);
+
+  TTree* tree = new TTree("Tree", "toy");
+  tree->SetDirectory(0);
+  schema.branch(tree);
+
+  vector<string> names = schema.columnNames(maxObjects);
+  vector<float> row(names.size());
+  const string prefix = "testColumnExport";
+  ColumnExporter exporter(prefix, names, 256);
+
+  toyEvent ev;
+  vector<toyJet> jets(12);
+  vector<float> metValues(nevents);
+  for(long i=0; i < nevents; i++)
+    {
+      ev.jets.clear();
+      int njets = int(12 * uniform(i, 0));
+      for(int j=0; j < njets; j++)
+        {
+          jets[j].pt = 30 + 500 * uniform(i, 10 + j);
+          jets[j].eta = -2.4 + 4.8 * uniform(i, 30 + j);
+          ev.jets.push_back(&jets[j]);
+        }
+      ev.met = 200 * uniform(i, 1);
+      ev.nMuons = int(3 * uniform(i, 2));
+      ev.trigger = uniform(i, 3) < 0.5;
+      passed = uniform(i, 4) < 0.8;
+      metValues[i] = passed ? ev.met : 0;
+      if ( passed ) schema.fill(&ev);
+      else schema.clear();
+      tree->Fill();
+      schema.columnValues(&row[0], maxObjects);
+      exporter.fill(&row[0]);
+    }
+  exporter.close();
+
+  // read the tree back into separate buffers
+  int nJet, nMuons;
+  float pt[10], eta[10], met, metF16;
+  bool trigger, passSelection;
+  tree->SetBranchAddress("nJet", &nJet);
+  tree->SetBranchAddress("Jet_pt", pt);
+  tree->SetBranchAddress("Jet_eta", eta);
+  tree->SetBranchAddress("met", &met);
+  tree->SetBranchAddress("nMuons", &nMuons);
+  tree->SetBranchAddress("trigger", &trigger);
+  tree->SetBranchAddress("metF16", &metF16);
+  tree->SetBranchAddress("passSelection", &passSelection);
+
+  vector<NpyColumn*> columns;
+  for(int c=0; c < exporter.columns(); c++)
+    columns.push_back(new NpyColumn(exporter.path(c)));
+
+  // column c of the row: nJet, Jet_pt_0..3, Jet_eta_0..3 after the scalars
+  const int f16Column = 3;
+  long mismatches = 0, f16Mismatches = 0, badCleared = 0;
+  bool sizeOK = true;
+  for(unsigned c=0; c < columns.size(); c++)
+    if ( columns[c]->size() != nevents ) sizeOK = false;
+  for(long i=0; sizeOK && i < nevents; i++)
+    {
+      tree->GetEntry(i);
+      vector<float> expected = {met, float(nMuons), float(trigger), metValues[i],
+                                float(passSelection), float(nJet)};
+      bool pass = uniform(i, 4) < 0.8;
+      if ( passSelection != pass ||
+           (!pass && (met != 0 || nMuons != 0 || trigger || nJet != 0)) )
+        badCleared++;
+      float x16 = (*columns[f16Column])[i];
+      if ( fabs(metF16 - x16) > ldexp(fabs(x16), -12) ) f16Mismatches++;
+      for(int k=0; k < maxObjects; k++) expected.push_back(k < nJet ? pt[k] : NAN);
+      for(int k=0; k < maxObjects; k++) expected.push_back(k < nJet ? eta[k] : NAN);
+      for(unsigned c=0; c < columns.size(); c++)
+        {
+          float x = (*columns[c])[i];
+          bool same = std::isnan(expected[c]) ? std::isnan(x) : x == expected[c];
+          if ( !same ) mismatches++;
+        }
+    }
+
+  for(unsigned c=0; c < columns.size(); c++)
+    {
+      delete columns[c];
+      std::remove(exporter.path(c).c_str());
+    }
+  std::remove((prefix + "_columns.txt").c_str());
+  delete tree;
+
+  bool ok = sizeOK && mismatches == 0 && f16Mismatches == 0 && badCleared == 0;
+  cout << "rows: " << exporter.rows()
+       << "  columns: " << exporter.columns()
+       << "  mismatches: " << mismatches
+       << "  Float16 beyond rounding: " << f16Mismatches
+       << "  bad cleared entries: " << badCleared
+       << (ok ? "  OK" : "  FAILED") << endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,78 @@
+//
+// testCutGridScan.cc
+//
+//   description: Fill a CutGridScan with random events and compare every
+//                grid point with a brute-force count of the events passing
+//                its cuts.
+//
+
+#include "CutGridScan.h"
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <stdint.h>
+
+using namespace std;
+
+double uniform(uint64_t i, uint64_t stream)
+{
+  uint64_t z = i * 0x9E3779B97F4A7C15ULL + stream * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+  return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+int main()
+{
+  const long nevents = 5000;
+  const int nouter = 2;
+  vector<double> nJets = {4, 5, 6, 7, 8};
+  vector<double> HT = {300, 400, 500, 600};
+
+  CutGridScan scan;
+  scan.addObjectAxis("jetPt", {30, 40});
+  scan.addCutAxis("nJets", nJets);
+  scan.addCutAxis("HT", HT);
+  scan.book();
+
+  // features of event i in outer cell o
+  vector<double> features(nevents * nouter * 2), weights(nevents);
+  for(long i=0; i < nevents; i++)
+    {
+      weights[i] = 0.5 + uniform(i, 0);
+      for(int o=0; o < nouter; o++)
+        {
+          double* f = &features[(i * nouter + o) * 2];
+          f[0] = int(10 * uniform(i, 1 + o));
+          f[1] = 900 * uniform(i, 3 + o);
+          scan.fill(o, f, weights[i]);
+        }
+    }
+  scan.finalize();
+
+  int mismatches = 0;
+  for(int o=0; o < nouter; o++)
+    for(unsigned a=0; a < nJets.size(); a++)
+      for(unsigned b=0; b < HT.size(); b++)
+        {
+          double sumw = 0;
+          for(long i=0; i < nevents; i++)
+            {
+              const double* f = &features[(i * nouter + o) * 2];
+              if ( f[0] >= nJets[a] && f[1] >= HT[b] ) sumw += weights[i];
+            }
+          vector<int> idx = {int(a), int(b)};
+          if ( fabs(scan.getYield(o, idx) - sumw) > 1e-9 * sumw ) mismatches++;
+        }
+
+  double total = 0;
+  for(long i=0; i < nevents; i++) total += weights[i];
+  bool totalOK = fabs(scan.getTotal() - total) < 1e-9 * total;
+
+  cout << "grid points: " << nouter * nJets.size() * HT.size()
+       << "  mismatches: " << mismatches
+       << "  total: " << scan.getTotal()
+       << (mismatches == 0 && totalOK ? "  OK" : "  FAILED") << endl;
+  return mismatches == 0 && totalOK ? 0 : 1;
+}
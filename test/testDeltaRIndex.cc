@@ -0,0 +1,161 @@
+//
+// testDeltaRIndex.cc
+//
+//   description: Compare the radius and nearest-neighbour queries and the
+//                one-to-one matching of DeltaRIndex with O(n^2) scans over
+//                all entries, on random events where a third of the
+//                directions sit near phi = +-pi, so that many neighbours
+//                are only close across the wrap-around.
+//
+
+#include "DeltaRIndex.h"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+
+using namespace std;
+
+double uniform(uint64_t i, uint64_t stream)
+{
+  uint64_t z = i * 0x9E3779B97F4A7C15ULL + stream * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+  return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+struct direction
+{
+  double eta, phi;
+};
+
+// deltaR of the scans, phi difference folded with remainder()
+double deltaR(const direction& a, const direction& b)
+{
+  double deta = a.eta - b.eta;
+  double dphi = remainder(a.phi - b.phi, 2 * M_PI);
+  return sqrt(deta*deta + dphi*dphi);
+}
+
+// within 0.3 of phi = +-pi for every third direction, anywhere otherwise
+direction randomDirection(uint64_t j)
+{
+  direction d;
+  d.eta = -2.5 + 5 * uniform(j, 1);
+  if ( j % 3 == 0 )
+    {
+      double phi = M_PI - 0.3 * uniform(j, 2);
+      d.phi = uniform(j, 3) < 0.5 ? phi : -phi;
+    }
+  else
+    d.phi = -M_PI + 2 * M_PI * uniform(j, 2);
+  return d;
+}
+
+bool sameMatches(vector<matchedPair> a, vector<matchedPair> b)
+{
+  if ( a.size() != b.size() ) return false;
+  for(unsigned k=0; k < a.size(); k++)
+    if ( a[k].first != b[k].first || a[k].second != b[k].second ||
+         fabs(a[k].distance - b[k].distance) > 1e-12 )
+      return false;
+  return true;
+}
+
+int main()
+{
+  const long nevents = 2000;
+  const double radius = 0.4;
+  long nqueries = 0, badQuery = 0, badNearest = 0, badMatch = 0;
+  long nwrapped = 0, nmatches = 0;
+  uint64_t j = 0;
+  DeltaRIndex index, other;
+  vector<int> found;
+  for(long ev=0; ev < nevents; ev++)
+    {
+      int n1 = 1 + int(20 * uniform(ev, 0));
+      int n2 = 1 + int(20 * uniform(ev, 4));
+      vector<direction> d1(n1), d2(n2);
+      index.clear();
+      other.clear();
+      for(int i=0; i < n1; i++, j++)
+        {
+          d1[i] = randomDirection(j);
+          index.add(d1[i].eta, d1[i].phi);
+        }
+      for(int i=0; i < n2; i++, j++)
+        {
+          d2[i] = randomDirection(j);
+          other.add(d2[i].eta, d2[i].phi);
+        }
+      index.build();
+      other.build();
+
+      // queries around every direction of the other set
+      for(int q=0; q < n2; q++, nqueries++)
+        {
+          index.query(d2[q].eta, d2[q].phi, radius, found);
+          sort(found.begin(), found.end());
+          vector<int> expected;
+          int best = -1;
+          double bestdR = radius;
+          for(int i=0; i < n1; i++)
+            {
+              double dR = deltaR(d2[q], d1[i]);
+              if ( dR < radius )
+                {
+                  expected.push_back(i);
+                  if ( fabs(d2[q].phi - d1[i].phi) > M_PI ) nwrapped++;
+                }
+              if ( dR < bestdR )
+                {
+                  best = i;
+                  bestdR = dR;
+                }
+            }
+          if ( found != expected ) badQuery++;
+          double distance;
+          int nearest = index.nearest(d2[q].eta, d2[q].phi, radius, &distance);
+          if ( nearest != best || (best >= 0 && fabs(distance - bestdR) > 1e-12) )
+            badNearest++;
+        }
+
+      // greedy one-to-one matching over all pairs, closest first
+      vector<matchedPair> candidates;
+      for(int a=0; a < n1; a++)
+        for(int b=0; b < n2; b++)
+          {
+            double dR = deltaR(d1[a], d2[b]);
+            if ( !(dR < radius) ) continue;
+            matchedPair mp;
+            mp.first = a;
+            mp.second = b;
+            mp.distance = dR;
+            candidates.push_back(mp);
+          }
+      stable_sort(candidates.begin(), candidates.end());
+      vector<bool> used1(n1, false), used2(n2, false);
+      vector<matchedPair> expected;
+      for(unsigned c=0; c < candidates.size(); c++)
+        {
+          if ( used1[candidates[c].first] || used2[candidates[c].second] ) continue;
+          used1[candidates[c].first] = used2[candidates[c].second] = true;
+          expected.push_back(candidates[c]);
+        }
+      vector<matchedPair> matches = matchOneToOne(index, other, radius);
+      nmatches += matches.size();
+      if ( !sameMatches(matches, expected) ) badMatch++;
+    }
+
+  bool ok = badQuery == 0 && badNearest == 0 && badMatch == 0 && nwrapped > 0;
+  cout << "events: " << nevents << "  queries: " << nqueries
+       << "  neighbours across phi = pi: " << nwrapped
+       << "  matches: " << nmatches
+       << "  bad queries: " << badQuery
+       << "  bad nearest: " << badNearest
+       << "  bad matchings: " << badMatch
+       << (ok ? "  OK" : "  FAILED") << endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,98 @@
+//
+// testHistAccumulator.cc
+//
+//   description: Fill HistAccumulators in parallel slices with 1 to 16
+//                threads and check that the merged histograms are
+//                bit-identical.
+//
+
+#include "HistAccumulator.h"
+#include <iostream>
+#include <cstring>
+#include <cmath>
+#include <stdint.h>
+
+using namespace std;
+
+// Pseudo-random number in [0, 1) from the event number and a stream index,
+// so that any thread can regenerate event i.
+double uniform(uint64_t i, uint64_t stream)
+{
+  uint64_t z = i * 0x9E3779B97F4A7C15ULL + stream * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+  return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+void fillEvents(HistAccumulator& acc, long first, long last)
+{
+  for(long i=first; i < last; i++)
+    {
+      double w = 0.5 + uniform(i, 0);
+      acc.fill(0, 3000 * uniform(i, 1) * uniform(i, 2), w);   // pT-like
+      acc.fill(1, 6.4 * uniform(i, 3) - 3.2, w);             // eta-like
+      acc.fill(2, int(20 * uniform(i, 4)), w * 1e-3);        // multiplicity
+    }
+}
+
+bool identical(const HistAccumulator& a, const HistAccumulator& b)
+{
+  for(int h=0; h < a.size(); h++)
+    {
+      if ( a.getEntries(h) != b.getEntries(h) ) return false;
+      if ( memcmp(a.getStats(h), b.getStats(h), 4*sizeof(double)) ) return false;
+      for(int bin=0; bin < a.getAxis(h).nbins + 2; bin++)
+        {
+          if ( a.getBinContent(h, bin) != b.getBinContent(h, bin) ) return false;
+          if ( a.getBinSumw2(h, bin) != b.getBinSumw2(h, bin) ) return false;
+        }
+    }
+  return true;
+}
+
+int main()
+{
+  const long nevents = 1000003;
+
+  HistAccumulator booking;
+  booking.book(50, 0, 3000);
+  booking.book(50, -3.2, 3.2);
+  booking.book(17, 5, 22);
+
+  // sequential fill, for reference (different summation order)
+  HistAccumulator serial = booking.emptyCopy();
+  fillEvents(serial, 0, nevents);
+
+  HistAccumulator reference;
+  int nfailed = 0;
+  int nthreads[] = {1, 2, 3, 4, 8, 16};
+  for(unsigned t=0; t < sizeof(nthreads)/sizeof(int); t++)
+    {
+      HistSlices slices(booking, nevents);
+      slices.run(nthreads[t], fillEvents);
+      HistAccumulator merged = booking.emptyCopy();
+      slices.merge(merged);
+      if ( t == 0 ) reference = merged;
+
+      bool same = identical(merged, reference);
+      if ( !same ) nfailed++;
+      cout << "threads: " << nthreads[t]
+           << "  entries: " << merged.getEntries(0)
+           << "  bit-identical: " << (same ? "yes" : "NO") << endl;
+    }
+
+  double maxdiff = 0;
+  for(int h=0; h < booking.size(); h++)
+    for(int bin=0; bin < booking.getAxis(h).nbins + 2; bin++)
+      {
+        double s = serial.getBinContent(h, bin);
+        if ( s != 0 )
+          maxdiff = max(maxdiff,
+                        fabs(reference.getBinContent(h, bin) - s) / fabs(s));
+      }
+  cout << "max relative difference to a sequential fill: " << maxdiff << endl;
+
+  cout << (nfailed ? "FAILED" : "OK") << endl;
+  return nfailed ? 1 : 0;
+}
@@ -0,0 +1,315 @@
+//
+// testMVAvarsJABDT.cc
+//
+//   description: Compare the indexed ttH and tHH hypothesis variables with
+//                the former name-keyed map implementation on 200 random
+//                events, through GetVariables() and through the addresses
+//                bound before the loop (as the TMVA reader does).
+//
+
+#include "MVAvarsJABDTtth.h"
+#include "MVAvarsJABDTthh.h"
+#include <iostream>
+#include <vector>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+
+using namespace std;
+
+double uniform(uint64_t i, uint64_t stream)
+{
+  uint64_t z = i * 0x9E3779B97F4A7C15ULL + stream * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+  return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// former map implementation of MVAvarsJABDTtth::FillMVAvarMap and GetVectors
+map<string, float> referenceTtH(MVAvarsJABDTtth& hyp,
+                                const vector<TLorentzVector>& selectedLeptonP4,
+                                const vector<TLorentzVector>& selectedJetP4,
+                                const vector<double>& selectedJetCSV,
+                                const TLorentzVector& metP4,
+                                const vector<int>& jets_idx)
+{
+  map<string, float> m;
+
+  float HT = hyp.GetHT(selectedJetP4);
+  map<string, TLorentzVector> vectors;
+
+  vectors["leptonicW"]    = hyp.GetLeptonicW(selectedLeptonP4[0], metP4);
+
+  vectors["btoplep"]      = selectedJetP4[jets_idx.at(ttHIndexes::ttH_btoplep_idx)];
+  vectors["btophad"]      = selectedJetP4[jets_idx.at(ttHIndexes::ttH_btophad_idx)];
+  vectors["whaddau1"]     = selectedJetP4[jets_idx.at(ttHIndexes::ttH_whaddau1_idx)];
+  vectors["whaddau2"]     = selectedJetP4[jets_idx.at(ttHIndexes::ttH_whaddau2_idx)];
+  vectors["hdau1"]        = selectedJetP4[jets_idx.at(ttHIndexes::ttH_hdau1_idx)];
+  vectors["hdau2"]        = selectedJetP4[jets_idx.at(ttHIndexes::ttH_hdau2_idx)];
+
+  vectors["toplep"]       = vectors["btoplep"] + vectors["leptonicW"];
+  vectors["whad"]         = vectors["whaddau1"] + vectors["whaddau2"];
+  vectors["tophad"]       = vectors["whad"] + vectors["btophad"];
+  vectors["higg"]         = vectors["hdau1"] + vectors["hdau2"];
+
+  m["Reco_ttH_btoplep_idx"]   = jets_idx.at(ttHIndexes::ttH_btoplep_idx);
+  m["Reco_ttH_btophad_idx"]   = jets_idx.at(ttHIndexes::ttH_btophad_idx);
+  m["Reco_ttH_whaddau_idx1"]  = jets_idx.at(ttHIndexes::ttH_whaddau1_idx);
+  m["Reco_ttH_whaddau_idx2"]  = jets_idx.at(ttHIndexes::ttH_whaddau2_idx);
+  m["Reco_ttH_hdau_idx1"]     = jets_idx.at(ttHIndexes::ttH_hdau1_idx);
+  m["Reco_ttH_hdau_idx2"]     = jets_idx.at(ttHIndexes::ttH_hdau2_idx);
+
+  m["Reco_ttH_btoplep_m"]     = vectors["btoplep"].M();
+  m["Reco_ttH_btoplep_pt"]    = vectors["btoplep"].Pt();
+  m["Reco_ttH_btoplep_phi"]   = vectors["btoplep"].Phi();
+  m["Reco_ttH_btoplep_eta"]   = vectors["btoplep"].Eta();
+  m["Reco_ttH_btoplep_w_dr"]  = vectors["btoplep"].DeltaR(vectors["leptonicWP4"]);
+
+  m["Reco_ttH_whad_m"]        = vectors["whad"].M();
+  m["Reco_ttH_whad_pt"]       = vectors["whad"].Pt();
+  m["Reco_ttH_whad_phi"]      = vectors["whad"].Phi();
+  m["Reco_ttH_whad_eta"]      = vectors["whad"].Eta();
+  m["Reco_ttH_whad_dr"]       = vectors["whaddau1"].DeltaR(vectors["whaddau2"]);
+
+  m["Reco_ttH_whaddau_m1"]    = vectors["whaddau1"].M();
+  m["Reco_ttH_whaddau_pt1"]   = vectors["whaddau1"].Pt();
+  m["Reco_ttH_whaddau_phi1"]  = vectors["whaddau1"].Phi();
+  m["Reco_ttH_whaddau_eta1"]  = vectors["whaddau1"].Eta();
+
+  m["Reco_ttH_whaddau_m2"]    = vectors["whaddau2"].M();
+  m["Reco_ttH_whaddau_pt2"]   = vectors["whaddau2"].Pt();
+  m["Reco_ttH_whaddau_phi2"]  = vectors["whaddau2"].Phi();
+  m["Reco_ttH_whaddau_eta2"]  = vectors["whaddau2"].Eta();
+
+  m["Reco_ttH_btophad_m"]     = vectors["btophad"].M();
+  m["Reco_ttH_btophad_pt"]    = vectors["btophad"].Pt();
+  m["Reco_ttH_btophad_phi"]   = vectors["btophad"].Phi();
+  m["Reco_ttH_btophad_eta"]   = vectors["btophad"].Eta();
+
+  m["Reco_ttH_tophad_m"]      = vectors["tophad"].M();
+  m["Reco_ttH_tophad_pt"]     = vectors["tophad"].Pt();
+  m["Reco_ttH_tophad_phi"]    = vectors["tophad"].Phi();
+  m["Reco_ttH_tophad_eta"]    = vectors["tophad"].Eta();
+  m["Reco_ttH_tophad_dr"]     = vectors["whad"].DeltaR(vectors["btophad"]);
+
+  m["Reco_ttH_toplep_m"]      = vectors["toplep"].M();
+  m["Reco_ttH_toplep_pt"]     = vectors["toplep"].Pt();
+  m["Reco_ttH_toplep_phi"]    = vectors["toplep"].Phi();
+  m["Reco_ttH_toplep_eta"]    = vectors["toplep"].Eta();
+
+  m["Reco_ttH_h_m"]         = vectors["higg"].M();
+  m["Reco_ttH_h_pt"]        = vectors["higg"].Pt();
+  m["Reco_ttH_h_phi"]       = vectors["higg"].Phi();
+  m["Reco_ttH_h_eta"]       = vectors["higg"].Eta();
+  m["Reco_ttH_h_dr"]        = vectors["hdau1"].DeltaR(vectors["hdau2"]);
+
+  m["Reco_ttH_hdau_m1"]     = vectors["hdau1"].M();
+  m["Reco_ttH_hdau_pt1"]    = vectors["hdau1"].Pt();
+  m["Reco_ttH_hdau_phi1"]   = vectors["hdau1"].Phi();
+  m["Reco_ttH_hdau_eta1"]   = vectors["hdau1"].Eta();
+
+  m["Reco_ttH_hdau_m2"]     = vectors["hdau2"].M();
+  m["Reco_ttH_hdau_pt2"]    = vectors["hdau2"].Pt();
+  m["Reco_ttH_hdau_phi2"]   = vectors["hdau2"].Phi();
+  m["Reco_ttH_hdau_eta2"]   = vectors["hdau2"].Eta();
+
+  // variables for JABDT
+  m["Reco_JABDT_ttH_log_whad_m"]                = log(vectors["whad"].M());
+  m["Reco_JABDT_ttH_Jet_CSV_btoplep"]           = selectedJetCSV[jets_idx.at(ttHIndexes::ttH_btoplep_idx)];
+  m["Reco_JABDT_ttH_Jet_CSV_btophad"]           = selectedJetCSV[jets_idx.at(ttHIndexes::ttH_btophad_idx)];
+  m["Reco_JABDT_ttH_Jet_CSV_whaddau1"]          = selectedJetCSV[jets_idx.at(ttHIndexes::ttH_whaddau1_idx)];
+  m["Reco_JABDT_ttH_Jet_CSV_whaddau2"]          = selectedJetCSV[jets_idx.at(ttHIndexes::ttH_whaddau2_idx)];
+  m["Reco_JABDT_ttH_Jet_CSV_hdau1"]             = selectedJetCSV[jets_idx.at(ttHIndexes::ttH_hdau1_idx)];
+  m["Reco_JABDT_ttH_Jet_CSV_hdau2"]             = selectedJetCSV[jets_idx.at(ttHIndexes::ttH_hdau2_idx)];
+  m["Reco_JABDT_ttH_log_tophad_m__M__whad_m"]   = log(vectors["tophad"].M() - vectors["whad"].M());
+  m["Reco_JABDT_ttH_log_tophad_m"]              = log(vectors["tophad"].M());
+  m["Reco_JABDT_ttH_log_tophad_pt"]             = log(vectors["tophad"].Pt());
+  m["Reco_JABDT_ttH_log_toplep_m"]              = log(vectors["toplep"].M());
+  m["Reco_JABDT_ttH_log_toplep_pt"]             = log(vectors["toplep"].Pt());
+  m["Reco_JABDT_ttH_tophad_pt__P__toplep_pt__P__h_pt__DIV__Evt_HT__P__Evt_Pt_MET__P__Lep_Pt"] = (vectors["tophad"].Pt() + vectors["toplep"].Pt() + vectors["higg"].Pt())/(HT + metP4.Pt() + selectedLeptonP4[0].Pt());
+  m["Reco_JABDT_ttH_log_h_pt"]                  = log(vectors["higg"].Pt());
+  m["Reco_JABDT_ttH_log_h_m"]                   = log(vectors["higg"].M());
+
+  return m;
+}
+
+// former map implementation of MVAvarsJABDTthh::FillMVAvarMap and GetVectors
+map<string, float> referenceTHH(MVAvarsJABDTthh& hyp,
+                                const vector<TLorentzVector>& selectedLeptonP4,
+                                const vector<TLorentzVector>& selectedJetP4,
+                                const vector<double>& selectedJetCSV,
+                                const TLorentzVector& metP4,
+                                const vector<int>& jets_idx)
+{
+  map<string, float> m;
+
+  map<string, TLorentzVector> vectors;
+
+  vectors["leptonicW"]    = hyp.GetLeptonicW(selectedLeptonP4[0], metP4);
+
+  vectors["btoplep"]      = selectedJetP4[jets_idx.at(tHHIndexes::tHH_btoplep_idx)];
+  vectors["btophad"]      = selectedJetP4[jets_idx.at(tHHIndexes::tHH_btophad_idx)];
+
+  vectors["h1dau1"]        = selectedJetP4[jets_idx.at(tHHIndexes::tHH_h1dau1_idx)];
+  vectors["h1dau2"]        = selectedJetP4[jets_idx.at(tHHIndexes::tHH_h1dau2_idx)];
+  vectors["h2dau3"]        = selectedJetP4[jets_idx.at(tHHIndexes::tHH_h2dau3_idx)];
+  vectors["h2dau4"]        = selectedJetP4[jets_idx.at(tHHIndexes::tHH_h2dau4_idx)];
+
+  vectors["toplep"]       = vectors["btoplep"] + vectors["leptonicW"];
+
+  vectors["higg1"]         = vectors["h1dau1"] + vectors["h1dau2"];
+  vectors["higg2"]         = vectors["h2dau3"] + vectors["h2dau4"];
+
+  m["Reco_tHH_btoplep_idx"]   = jets_idx.at(tHHIndexes::tHH_btoplep_idx);
+  m["Reco_tHH_btophad_idx"]   = jets_idx.at(tHHIndexes::tHH_btophad_idx);
+  m["Reco_tHH_h1dau1_idx"]     = jets_idx.at(tHHIndexes::tHH_h1dau1_idx);
+  m["Reco_tHH_h1dau2_idx"]     = jets_idx.at(tHHIndexes::tHH_h1dau2_idx);
+  m["Reco_tHH_h2dau3_idx"]     = jets_idx.at(tHHIndexes::tHH_h2dau3_idx);
+  m["Reco_tHH_h2dau4_idx"]     = jets_idx.at(tHHIndexes::tHH_h2dau4_idx);
+
+  m["Reco_tHH_btoplep_m"]     = vectors["btoplep"].M();
+  m["Reco_tHH_btoplep_pt"]    = vectors["btoplep"].Pt();
+  m["Reco_tHH_btoplep_phi"]   = vectors["btoplep"].Phi();
+  m["Reco_tHH_btoplep_eta"]   = vectors["btoplep"].Eta();
+  m["Reco_tHH_btoplep_w_dr"]  = vectors["btoplep"].DeltaR(vectors["leptonicWP4"]);
+
+  m["Reco_tHH_btophad_m"]     = vectors["btophad"].M();
+  m["Reco_tHH_btophad_pt"]    = vectors["btophad"].Pt();
+  m["Reco_tHH_btophad_phi"]   = vectors["btophad"].Phi();
+  m["Reco_tHH_btophad_eta"]   = vectors["btophad"].Eta();
+
+  m["Reco_tHH_toplep_m"]      = vectors["toplep"].M();
+  m["Reco_tHH_toplep_pt"]     = vectors["toplep"].Pt();
+  m["Reco_tHH_toplep_phi"]    = vectors["toplep"].Phi();
+  m["Reco_tHH_toplep_eta"]    = vectors["toplep"].Eta();
+
+  m["Reco_tHH_h1_m"]         = vectors["higg1"].M();
+  m["Reco_tHH_h1_pt"]        = vectors["higg1"].Pt();
+  m["Reco_tHH_h1_phi"]       = vectors["higg1"].Phi();
+  m["Reco_tHH_h1_eta"]       = vectors["higg1"].Eta();
+  m["Reco_tHH_h1_dr"]        = vectors["h1dau1"].DeltaR(vectors["h1dau2"]);
+  
+  m["Reco_tHH_h2_m"]         = vectors["higg2"].M();
+  m["Reco_tHH_h2_pt"]        = vectors["higg2"].Pt();
+  m["Reco_tHH_h2_phi"]       = vectors["higg2"].Phi();
+  m["Reco_tHH_h2_eta"]       = vectors["higg2"].Eta();
+  m["Reco_tHH_h2_dr"]        = vectors["h2dau3"].DeltaR(vectors["h2dau4"]);
+
+  m["Reco_tHH_h1dau1_m"]     = vectors["h1dau1"].M();
+  m["Reco_tHH_h1dau1_pt"]    = vectors["h1dau1"].Pt();
+  m["Reco_tHH_h1dau1_phi"]   = vectors["h1dau1"].Phi();
+  m["Reco_tHH_h1dau1_eta"]   = vectors["h1dau1"].Eta();
+
+  m["Reco_tHH_h1dau2_m"]     = vectors["h1dau2"].M();
+  m["Reco_tHH_h1dau2_pt"]    = vectors["h1dau2"].Pt();
+  m["Reco_tHH_h1dau2_phi"]   = vectors["h1dau2"].Phi();
+  m["Reco_tHH_h1dau2_eta"]   = vectors["h1dau2"].Eta();
+  
+  m["Reco_tHH_h2dau3_m"]     = vectors["h2dau3"].M();
+  m["Reco_tHH_h2dau3_pt"]    = vectors["h2dau3"].Pt();
+  m["Reco_tHH_h2dau3_phi"]   = vectors["h2dau3"].Phi();
+  m["Reco_tHH_h2dau3_eta"]   = vectors["h2dau3"].Eta();
+
+  m["Reco_tHH_h2dau4_m"]     = vectors["h2dau4"].M();
+  m["Reco_tHH_h2dau4_pt"]    = vectors["h2dau4"].Pt();
+  m["Reco_tHH_h2dau4_phi"]   = vectors["h2dau4"].Phi();
+  m["Reco_tHH_h2dau4_eta"]   = vectors["h2dau4"].Eta();
+  
+
+  // variables for JABDT
+  m["Reco_JABDT_tHH_Jet_CSV_btoplep"]           = selectedJetCSV[jets_idx.at(tHHIndexes::tHH_btoplep_idx)];
+  m["Reco_JABDT_tHH_Jet_CSV_btophad"]           = selectedJetCSV[jets_idx.at(tHHIndexes::tHH_btophad_idx)];
+
+  m["Reco_JABDT_tHH_Jet_CSV_h1dau1"]             = selectedJetCSV[jets_idx.at(tHHIndexes::tHH_h1dau1_idx)];
+  m["Reco_JABDT_tHH_Jet_CSV_h1dau2"]             = selectedJetCSV[jets_idx.at(tHHIndexes::tHH_h1dau2_idx)];
+  m["Reco_JABDT_tHH_Jet_CSV_h2dau3"]             = selectedJetCSV[jets_idx.at(tHHIndexes::tHH_h2dau3_idx)];
+  m["Reco_JABDT_tHH_Jet_CSV_h2dau4"]             = selectedJetCSV[jets_idx.at(tHHIndexes::tHH_h2dau4_idx)];
+
+  m["Reco_JABDT_tHH_log_toplep_m"]              = log(vectors["toplep"].M());
+  m["Reco_JABDT_tHH_log_toplep_pt"]             = log(vectors["toplep"].Pt());
+  
+  m["Reco_JABDT_tHH_log_h1_pt"]                  = log(vectors["higg1"].Pt());
+  m["Reco_JABDT_tHH_log_h1_m"]                   = log(vectors["higg1"].M());
+  m["Reco_JABDT_tHH_log_h2_pt"]                  = log(vectors["higg2"].Pt());
+  m["Reco_JABDT_tHH_log_h2_m"]                   = log(vectors["higg2"].M());
+
+  return m;
+}
+
+
+bool same(float a, float b)
+{
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+// number of variables differing from the reference, in the values returned
+// by GetVariables() and in the bound addresses
+template <class hypothesis>
+long compare(hypothesis& hyp, const map<string, float>& reference,
+             const map<string, float*>& bound)
+{
+  long ndiff = 0;
+  map<string, float> values = hyp.GetVariables();
+  if ( values.size() != reference.size() ) ndiff++;
+  for(auto it = reference.begin(); it != reference.end(); it++)
+    {
+      auto value = values.find(it->first);
+      if ( value == values.end() || !same(value->second, it->second) ) ndiff++;
+      auto address = bound.find(it->first);
+      if ( address == bound.end() || !same(*address->second, it->second) ) ndiff++;
+    }
+  return ndiff;
+}
+
+int main()
+{
+  MVAvarsJABDTtth tth;
+  MVAvarsJABDTthh thh;
+  tth.SetWP(0.3);
+  thh.SetWP(0.3);
+  map<string, float*> tthBound, thhBound;
+  vector<string> labels = tth.GetRecolabels();
+  for(unsigned int i=0; i < labels.size(); i++) tthBound[labels[i]] = tth.GetAdress(labels[i]);
+  labels = thh.GetRecolabels();
+  for(unsigned int i=0; i < labels.size(); i++) thhBound[labels[i]] = thh.GetAdress(labels[i]);
+
+  const long nevents = 200;
+  const int njets = 8;
+  long ndiff = 0;
+  uint64_t j = 0;
+  for(long ev=0; ev < nevents; ev++)
+    {
+      vector<TLorentzVector> jets(njets), leptons(1);
+      vector<double> csv(njets);
+      for(int i=0; i < njets; i++, j++)
+        {
+          jets[i].SetPtEtaPhiM(30 + 200 * uniform(j, 1), 4 * uniform(j, 2) - 2,
+                               6 * uniform(j, 3) - 3, 5 + 10 * uniform(j, 4));
+          csv[i] = uniform(j, 5);
+        }
+      leptons[0].SetPtEtaPhiM(30 + 50 * uniform(ev, 6), 2 * uniform(ev, 7) - 1,
+                              6 * uniform(ev, 8) - 3, 0.1);
+      TLorentzVector met;
+      met.SetPtEtaPhiM(50 * uniform(ev, 9), 0, 6 * uniform(ev, 10) - 3, 0);
+
+      // random assignment of 6 distinct jets
+      vector<int> idx;
+      for(int i=0; i < njets; i++) idx.push_back(i);
+      for(int i=njets - 1; i > 0; i--) swap(idx[i], idx[int((i + 1) * uniform(ev, 11 + i))]);
+      idx.resize(6);
+
+      tth.FillMVAvarMap(leptons, jets, csv, met, idx);
+      ndiff += compare(tth, referenceTtH(tth, leptons, jets, csv, met, idx), tthBound);
+      thh.FillMVAvarMap(leptons, jets, csv, met, idx);
+      ndiff += compare(thh, referenceTHH(thh, leptons, jets, csv, met, idx), thhBound);
+    }
+
+  cout << "events: " << nevents
+       << "  variables: " << tthBound.size() << " ttH, " << thhBound.size() << " tHH"
+       << "  differences from the map implementation: " << ndiff
+       << (ndiff == 0 ? "  OK" : "  FAILED") << endl;
+  return ndiff == 0 ? 0 : 1;
+}
@@ -0,0 +1,63 @@
+//
+// testMultiWeightHist.cc
+//
+//   description: Fill a MultiWeightHist with a vector of weights per event
+//                and check each copy against a HistAccumulator filled with
+//                that weight alone. Events with fewer weights than booked
+//                must fill the missing copies with the nominal weight.
+//
+
+#include "MultiWeightHist.h"
+#include "HistAccumulator.h"
+#include <iostream>
+#include <vector>
+#include <stdint.h>
+
+using namespace std;
+
+double uniform(uint64_t i, uint64_t stream)
+{
+  uint64_t z = i * 0x9E3779B97F4A7C15ULL + stream * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+  return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+int main()
+{
+  const int nweights = 103;
+  const long nevents = 20000;
+
+  MultiWeightHist multi;
+  HistAccumulator single;
+  multi.book(50, 0, 3000, nweights);
+  for(int k=0; k < nweights; k++) single.book(50, 0, 3000);
+
+  vector<float> weights(nweights);
+  for(long i=0; i < nevents; i++)
+    {
+      double x = 3500 * uniform(i, 0) * uniform(i, 1) - 100;
+      double w = 0.5 + uniform(i, 2);
+      // every tenth event has only the first 9 weights
+      int n = i % 10 == 0 ? 9 : nweights;
+      for(int k=0; k < n; k++) weights[k] = 0.8 + 0.4 * uniform(i, 3 + k);
+      multi.fill(0, x, w, n, &weights[0]);
+      for(int k=0; k < nweights; k++)
+        single.fill(k, x, k < n ? w * weights[k] : w);
+    }
+
+  int mismatches = 0;
+  for(int k=0; k < nweights; k++)
+    for(int bin=0; bin < 52; bin++)
+      if ( multi.getBinContent(0, bin, k) != single.getBinContent(k, bin) ||
+           multi.getBinSumw2(0, bin, k) != single.getBinSumw2(k, bin) )
+        mismatches++;
+
+  cout << "weights: " << nweights
+       << "  events: " << nevents
+       << "  entries: " << multi.getEntries(0)
+       << "  mismatches: " << mismatches
+       << (mismatches == 0 ? "  OK" : "  FAILED") << endl;
+  return mismatches == 0 ? 0 : 1;
+}
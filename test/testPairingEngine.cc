@@ -0,0 +1,126 @@
+//
+// testPairingEngine.cc
+//
+//   description: Compare the chi2 pairing of PairingEngine with the former
+//                diMotherReco evaluated on every assignment of two disjoint
+//                jet pairs to the two mothers, on random 4-10 jet events with
+//                random generator matching, for the HH (matched, not
+//                matched), ZZ and ZH hypotheses of the analyzer.
+//
+
+#include "PairingEngine.h"
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <stdint.h>
+
+using namespace std;
+
+double uniform(uint64_t i, uint64_t stream)
+{
+  uint64_t z = i * 0x9E3779B97F4A7C15ULL + stream * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+  return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+struct testJet
+{
+  CachedP4 p4;
+  bool matched;
+  const CachedP4* getp4() { return &p4; }
+};
+
+struct bruteResult
+{
+  float chi2 = PairingEngine::cNoCandidate;
+  float mass1 = -1, mass2 = -1;
+};
+
+// the former ttHHanalyzer::diMotherReco
+void diMotherReco(const CachedP4& dPar1p4, const CachedP4& dPar2p4,
+                  const CachedP4& dPar3p4, const CachedP4& dPar4p4,
+                  const float mother1mass, const float mother2mass,
+                  bruteResult& best)
+{
+  float bbMass1 = (dPar1p4 + dPar2p4).M();
+  float bbMass2 = (dPar3p4 + dPar4p4).M();
+  float chi2 = pow((bbMass1 - mother1mass), 2)/pow((dPar1p4.Pt() + dPar2p4.Pt())/2.*0.2, 0.5)
+    + pow((bbMass2 - mother2mass), 2)/pow((dPar3p4.Pt() + dPar4p4.Pt())/2.*0.02, 0.5);
+  if ( best.chi2 > chi2 )
+    {
+      best.chi2 = chi2;
+      best.mass1 = bbMass1;
+      best.mass2 = bbMass2;
+    }
+}
+
+bool same(const PairingEngine::result& engine, const bruteResult& brute)
+{
+  if ( brute.chi2 == PairingEngine::cNoCandidate )
+    return engine.chi2 == PairingEngine::cNoCandidate && engine.pair1 < 0;
+  const float tolerance = 1e-4 * (1 + brute.chi2);
+  return fabs(engine.chi2 - brute.chi2) <= tolerance
+    && fabs(engine.mass1 - brute.mass1) <= 1e-3 * (1 + brute.mass1)
+    && fabs(engine.mass2 - brute.mass2) <= 1e-3 * (1 + brute.mass2);
+}
+
+int main()
+{
+  const float mH = 125.38, mZ = 91.;
+  PairingEngine engine;
+  const int hypHH = engine.addHypothesis(mH, mH, 0.2, 0.02);
+  const int hypHHMatched = engine.addHypothesis(mH, mH, 0.2, 0.02, PairingEngine::kAllMatched);
+  const int hypHHNotMatched = engine.addHypothesis(mH, mH, 0.2, 0.02, PairingEngine::kNotAllMatched);
+  const int hypZZ = engine.addHypothesis(mZ, mZ, 0.2, 0.02);
+  const int hypHZ = engine.addHypothesis(mH, mZ, 0.2, 0.02);
+
+  const long nevents = 5000;
+  long nmismatch = 0, ncandidates = 0;
+  vector<testJet> jets(10);
+  vector<testJet*> pointers;
+  uint64_t j = 0;
+  for(long ev=0; ev < nevents; ev++)
+    {
+      int njets = 4 + int(7 * uniform(ev, 0));
+      pointers.clear();
+      for(int i=0; i < njets; i++, j++)
+        {
+          jets[i].p4 = CachedP4::fromPtEtaPhiM(30 + 200 * uniform(j, 1), -2.4 + 4.8 * uniform(j, 2),
+                                               -M_PI + 2 * M_PI * uniform(j, 3), 5 + 15 * uniform(j, 4));
+          jets[i].matched = uniform(j, 5) < 0.7;
+          pointers.push_back(&jets[i]);
+        }
+      engine.setJets(&pointers, [](testJet* jet){ return jet->matched; });
+      engine.solve();
+
+      // every ordered assignment of two disjoint pairs to mother 1 and 2
+      bruteResult hh, hhMatched, hhNotMatched, zz, hz;
+      for(int i1=0; i1 < njets; i1++)
+        for(int i2=i1+1; i2 < njets; i2++)
+          for(int i3=0; i3 < njets; i3++)
+            for(int i4=i3+1; i4 < njets; i4++)
+              {
+                if ( i3 == i1 || i3 == i2 || i4 == i1 || i4 == i2 ) continue;
+                const CachedP4 &p1 = jets[i1].p4, &p2 = jets[i2].p4, &p3 = jets[i3].p4, &p4 = jets[i4].p4;
+                bool allMatched = jets[i1].matched && jets[i2].matched && jets[i3].matched && jets[i4].matched;
+                diMotherReco(p1, p2, p3, p4, mH, mH, allMatched ? hhMatched : hhNotMatched);
+                diMotherReco(p1, p2, p3, p4, mH, mH, hh);
+                diMotherReco(p1, p2, p3, p4, mZ, mZ, zz);
+                diMotherReco(p1, p2, p3, p4, mH, mZ, hz);
+                ncandidates++;
+              }
+
+      if ( !same(engine.getResult(hypHH), hh) ) nmismatch++;
+      if ( !same(engine.getResult(hypHHMatched), hhMatched) ) nmismatch++;
+      if ( !same(engine.getResult(hypHHNotMatched), hhNotMatched) ) nmismatch++;
+      if ( !same(engine.getResult(hypZZ), zz) ) nmismatch++;
+      if ( !same(engine.getResult(hypHZ), hz) ) nmismatch++;
+    }
+
+  cout << "events: " << nevents << "  assignments: " << ncandidates
+       << "  mismatches: " << nmismatch
+       << (nmismatch == 0 ? "  OK" : "  FAILED") << endl;
+  return nmismatch == 0 ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+//
+// testQuantileSketch.cc
+//
+//   description: Stream values into a KLL quantile sketch and compare its
+//                quantiles with the exact ones (rank error), for one sketch
+//                and for the merge of sketches filled in separate chunks
+//                (parallel jobs). Also checks that the memory stays bounded.
+//
+
+#include "QuantileSketch.h"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <stdint.h>
+
+using namespace std;
+
+double uniform(uint64_t i, uint64_t stream)
+{
+  uint64_t z = i * 0x9E3779B97F4A7C15ULL + stream * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+  return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// largest |rank(q quantile) / n - q| over q = 0.01 .. 0.99
+double maxRankError(const QuantileSketch& sketch, const vector<double>& sorted)
+{
+  double worst = 0;
+  for(int i=1; i < 100; i++)
+    {
+      double q = i / 100.0;
+      double x = sketch.quantile(q);
+      double rank = (lower_bound(sorted.begin(), sorted.end(), x)
+                     - sorted.begin()) / double(sorted.size());
+      worst = max(worst, fabs(rank - q));
+    }
+  return worst;
+}
+
+int main()
+{
+  const long nevents = 1000000;
+  const int nchunks = 8;
+
+  // falling, HT-like spectrum
+  vector<double> values(nevents);
+  for(long i=0; i < nevents; i++)
+    values[i] = 300 - 200 * log(1 - uniform(i, 0));
+
+  QuantileSketch single;
+  vector<QuantileSketch> chunks(nchunks);
+  for(long i=0; i < nevents; i++)
+    {
+      single.add(values[i]);
+      chunks[i * nchunks / nevents].add(values[i]);
+    }
+  QuantileSketch merged;
+  for(int c=0; c < nchunks; c++)
+    merged.merge(QuantileSketch::deserialize(chunks[c].serialize()));
+
+  vector<double> sorted(values);
+  sort(sorted.begin(), sorted.end());
+  double errSingle = maxRankError(single, sorted);
+  double errMerged = maxRankError(merged, sorted);
+  bool ok = errSingle < 0.02 && errMerged < 0.02 &&
+    single.retained() < 1000 && merged.retained() < 1000 &&
+    merged.count() == nevents;
+
+  vector<double> edges = single.suggestEdges(10);
+  cout << "rank error single: " << errSingle
+       << "  merged: " << errMerged
+       << "  retained: " << single.retained() << " / " << merged.retained()
+       << (ok ? "  OK" : "  FAILED") << endl;
+  cout << "equal-population edges:";
+  for(unsigned i=0; i < edges.size(); i++) cout << " " << edges[i];
+  cout << endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,230 @@
+//
+// testResonanceReconstructor.cc
+//
+//   description: Compare the K best jet assignments of the branch and bound
+//                search with an exhaustive enumeration on random 6-12 jet
+//                events (HH+W and HH+tt), including events with identical
+//                jets, where many assignments tie, and report the latency
+//                per event.
+//
+
+#include "ResonanceReconstructor.h"
+#include <iostream>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <stdint.h>
+
+using namespace std;
+
+double uniform(uint64_t i, uint64_t stream)
+{
+  uint64_t z = i * 0x9E3779B97F4A7C15ULL + stream * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+  return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+struct testJet
+{
+  CachedP4 p4;
+  const CachedP4* getp4() { return &p4; }
+};
+
+// njets random jets; with pairs, every second jet repeats the previous one
+void randomEvent(uint64_t ev, int njets, bool pairs, vector<testJet>& jets,
+                 vector<testJet*>& pointers)
+{
+  jets.resize(njets);
+  pointers.clear();
+  for(int i=0; i < njets; i++)
+    {
+      uint64_t j = ev * 64 + (pairs ? i / 2 : i);
+      double pt = 30 + 170 * uniform(j, 1);
+      double eta = -2.4 + 4.8 * uniform(j, 2);
+      double phi = -M_PI + 2 * M_PI * uniform(j, 3);
+      double m = 5 + 15 * uniform(j, 4);
+      jets[i].p4 = CachedP4::fromPtEtaPhiM(pt, eta, phi, m);
+      pointers.push_back(&jets[i]);
+    }
+}
+
+// exhaustive enumeration, identical resonances in increasing mask order
+template <size_t NRes>
+struct bruteForce
+{
+  array<resonance, NRes> resonances;
+  array<bool, NRes> same;
+  vector<testJet*>* jets;
+  array<unsigned short, NRes> masks;
+  vector<pair<float, array<unsigned short, NRes> > > all;
+
+  float chi2(unsigned int ir, unsigned short mask)
+  {
+    double px = 0, py = 0, pz = 0, e = 0;
+    for(unsigned int i=0; i < jets->size(); i++)
+      if ( mask & (1u << i) )
+        {
+          const CachedP4& p4 = *jets->at(i)->getp4();
+          px += p4.Px(); py += p4.Py(); pz += p4.Pz(); e += p4.E();
+        }
+    double m2 = e*e - px*px - py*py - pz*pz;
+    float mass = m2 < 0 ? -sqrt(-m2) : sqrt(m2);
+    float pull = (mass - resonances[ir].mass) / resonances[ir].sigma;
+    return pull * pull;
+  }
+
+  void groups(unsigned int ir, unsigned short used, int first, int left,
+              unsigned short mask)
+  {
+    if ( left == 0 )
+      {
+        if ( ir > 0 && same[ir] && mask <= masks[ir-1] ) return;
+        masks[ir] = mask;
+        enumerate(ir + 1, used | mask);
+        return;
+      }
+    for(int i=first; i < (int)jets->size(); i++)
+      if ( !(used & (1u << i)) )
+        groups(ir, used, i + 1, left - 1, mask | (1u << i));
+  }
+
+  void enumerate(unsigned int ir, unsigned short used)
+  {
+    if ( ir == NRes )
+      {
+        float sum = 0;
+        for(unsigned int r=0; r < NRes; r++) sum += chi2(r, masks[r]);
+        all.push_back(make_pair(sum, masks));
+        return;
+      }
+    groups(ir, used, 0, resonances[ir].nDaughters, 0);
+  }
+
+  void run(vector<testJet*>* j)
+  {
+    jets = j;
+    all.clear();
+    enumerate(0, 0);
+    sort(all.begin(), all.end(),
+         [](const pair<float, array<unsigned short, NRes> >& a,
+            const pair<float, array<unsigned short, NRes> >& b)
+         { return a.first < b.first; });
+  }
+};
+
+// masks of identical resonances in increasing order, as in the enumeration
+template <size_t NRes>
+array<unsigned short, NRes> canonical(array<unsigned short, NRes> masks,
+                                      const array<bool, NRes>& same)
+{
+  for(unsigned int ir=1; ir < NRes; ir++)
+    for(unsigned int k=ir; k > 0 && same[k] && masks[k] < masks[k-1]; k--)
+      swap(masks[k], masks[k-1]);
+  return masks;
+}
+
+struct result
+{
+  long nevents = 0, nmismatch = 0;
+  double seconds = 0;
+};
+
+// Each of the K assignments must be a valid one of the enumeration, with
+// the same chi2, distinct, and the chi2 values must be the K smallest
+// (with ties, any of the tied assignments may be kept).
+template <size_t NRes>
+void check(const array<resonance, NRes>& resonances, unsigned int nBest,
+           int njets, bool pairs, long nevents, uint64_t stream, result& res)
+{
+  ResonanceReconstructor<NRes> reco(resonances, nBest);
+  bruteForce<NRes> brute;
+  brute.resonances = resonances;
+  for(unsigned int ir=0; ir < NRes; ir++)
+    brute.same[ir] = ir > 0 && resonances[ir].mass == resonances[ir-1].mass
+      && resonances[ir].sigma == resonances[ir-1].sigma
+      && resonances[ir].nDaughters == resonances[ir-1].nDaughters;
+
+  vector<testJet> jets;
+  vector<testJet*> pointers;
+  for(long ev=0; ev < nevents; ev++)
+    {
+      randomEvent(stream * 100000 + ev, njets, pairs, jets, pointers);
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      int n = reco.reconstruct(&pointers);
+      res.seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      res.nevents++;
+
+      brute.run(&pointers);
+      const vector<typename ResonanceReconstructor<NRes>::assignment>& best = reco.getBest();
+      bool ok = n == (int)min<size_t>(nBest, brute.all.size());
+      vector<array<unsigned short, NRes> > seen;
+      for(int k=0; ok && k < n; k++)
+        {
+          float expected = brute.all[k].first;
+          ok = fabs(best[k].chi2 - expected) <= 1e-4 * (1 + expected);
+          array<unsigned short, NRes> key = canonical(best[k].jetMask, brute.same);
+          if ( find(seen.begin(), seen.end(), key) != seen.end() ) ok = false;
+          seen.push_back(key);
+          bool found = false;
+          for(size_t a=0; a < brute.all.size() && !found; a++)
+            found = brute.all[a].second == key
+              && fabs(brute.all[a].first - best[k].chi2) <= 1e-4 * (1 + expected);
+          ok = ok && found;
+        }
+      if ( !ok ) res.nmismatch++;
+    }
+}
+
+int main()
+{
+  const float mH = 125.1, mW = 80.377, mt = 172.76;
+  const array<resonance, 3> hhw = {{ {mH, 15., 2}, {mH, 15., 2}, {mW, 10., 2} }};
+  const array<resonance, 4> hhtt = {{ {mH, 15., 2}, {mH, 15., 2}, {mt, 20., 3}, {mt, 20., 3} }};
+
+  bool ok = true;
+  printf("resonances  K  Njets  identical jets  events  mismatches  latency [us/event]\n");
+  for(int pairs=0; pairs < 2; pairs++)
+    for(unsigned int nBest=1; nBest <= 5; nBest += 4)
+      for(int njets=6; njets <= 12; njets++)
+        {
+          result res;
+          check(hhw, nBest, njets, pairs, 100, njets + 16 * nBest + 256 * pairs, res);
+          printf("HH+W        %u  %5d  %14s  %6ld  %10ld  %18.2f\n", nBest, njets,
+                 pairs ? "yes" : "no", res.nevents, res.nmismatch, res.seconds / res.nevents * 1e6);
+          ok = ok && res.nmismatch == 0;
+        }
+  for(int pairs=0; pairs < 2; pairs++)
+    for(unsigned int nBest=1; nBest <= 5; nBest += 4)
+      for(int njets=10; njets <= 12; njets++)
+        {
+          result res;
+          check(hhtt, nBest, njets, pairs, 8, 1000 + njets + 16 * nBest + 256 * pairs, res);
+          printf("HH+tt       %u  %5d  %14s  %6ld  %10ld  %18.2f\n", nBest, njets,
+                 pairs ? "yes" : "no", res.nevents, res.nmismatch, res.seconds / res.nevents * 1e6);
+          ok = ok && res.nmismatch == 0;
+        }
+
+  // latency of the largest search alone, without the enumeration
+  ResonanceReconstructor<4> reco(hhtt, 1);
+  vector<testJet> jets;
+  vector<testJet*> pointers;
+  const long nevents = 2000;
+  double seconds = 0;
+  long nfound = 0;
+  for(long ev=0; ev < nevents; ev++)
+    {
+      randomEvent(50000 + ev, 12, false, jets, pointers);
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      nfound += reco.reconstruct(&pointers);
+      seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+  cout << "HH+tt, 12 jets, K=1: " << seconds / nevents * 1e6 << " us/event"
+       << " (" << nfound << " assignments)"
+       << (ok ? "  OK" : "  FAILED") << endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,150 @@
+//
+// testVariationOverlay.cc
+//
+//   description: Apply random JES/JER-like overlays to random nominal jets
+//                and MET the way createVariedObjects does (changed jets as
+//                varied copies, MET copied from the nominal one minus the
+//                jet offsets, storage reused between variations), then
+//                revert them: the inverse overlay gives back the nominal
+//                jets bit for bit and cancels the MET offset, an empty
+//                overlay gives back the nominal jets and MET exactly, and
+//                the nominal objects are never modified.
+//
+
+#include "ttHHanalyzer_trigger.h"
+#include "VariationOverlay.h"
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <stdint.h>
+
+using namespace std;
+
+double uniform(uint64_t i, uint64_t stream)
+{
+  uint64_t z = i * 0x9E3779B97F4A7C15ULL + stream * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+  return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+bool identical(const CachedP4& a, const CachedP4& b)
+{
+  return a.Px() == b.Px() && a.Py() == b.Py() && a.Pz() == b.Pz() && a.E() == b.E()
+    && a.Pt() == b.Pt() && a.Eta() == b.Eta() && a.Phi() == b.Phi() && a.M() == b.M();
+}
+
+// objects of the variation as createVariedObjects builds them: unchanged
+// jets are the nominal ones, changed jets are varied copies in the reused
+// storage, the MET is a copy of the nominal one minus the jet offsets
+// (left as it is when no jet changes)
+void apply(const VariationOverlay& overlay, vector<objectJet>& nominal,
+           objectMET& nominalMET, vector<objectJet>& storage, objectMET& met,
+           vector<objectJet*>& jets)
+{
+  met = nominalMET;
+  if ( !overlay.getJets().empty() ) met.subtractp4(overlay.getJetsOffset());
+  storage.resize(overlay.getJets().size());
+  jets.clear();
+  int nChanged = 0;
+  for(unsigned int i=0; i < nominal.size(); i++)
+    {
+      const VariationOverlay::jetChange* change = overlay.getJet(i);
+      if ( !change )
+        {
+          jets.push_back(&nominal[i]);
+          continue;
+        }
+      objectJet* jet = &storage[nChanged++];
+      *jet = nominal[i];
+      jet->vary(change->pt, change->mass);
+      jets.push_back(jet);
+    }
+}
+
+int main()
+{
+  const long nevents = 5000;
+  long nbad = 0, nchanged = 0;
+  uint64_t j = 0;
+  VariationOverlay overlay, inverse;
+  vector<objectJet> storage, inverseStorage;
+  objectMET met, inverseMET;
+  vector<objectJet*> jets, inverseJets;
+  for(long ev=0; ev < nevents; ev++)
+    {
+      int njets = 1 + int(14 * uniform(ev, 0));
+      vector<objectJet> nominal(njets);
+      for(int i=0; i < njets; i++, j++)
+        nominal[i] = objectJet(30 + 300 * uniform(j, 1), -2.4 + 4.8 * uniform(j, 2),
+                               -M_PI + 2 * M_PI * uniform(j, 3), 5 + 20 * uniform(j, 4));
+      objectMET nominalMET(200 * uniform(ev, 5), 0, -M_PI + 2 * M_PI * uniform(ev, 6), 0);
+      vector<CachedP4> before;
+      for(int i=0; i < njets; i++) before.push_back(*nominal[i].getp4());
+      const CachedP4 metBefore = *nominalMET.getp4();
+
+      // up, down and no variation in the same storage; up and down reverted
+      for(int v=0; v < 3; v++)
+        {
+          overlay.reset(njets);
+          for(int i=0; i < njets; i++)
+            {
+              const CachedP4& p4 = *nominal[i].getp4();
+              bool changes = v < 2 && uniform(j + i, 7) < 0.6;
+              float scale = changes ? (v == 0 ? 1.02 : 0.97) + 0.02 * uniform(j + i, 8) : 1;
+              overlay.setJet(i, p4, changes ? scale * p4.Pt() : p4.Pt(), changes ? scale * p4.M() : p4.M());
+              if ( (overlay.getJet(i) != nullptr) != changes ) nbad++;
+            }
+          nchanged += overlay.getJets().size();
+          apply(overlay, nominal, nominalMET, storage, met, jets);
+
+          // MET absorbs the jet changes
+          double dpx = 0, dpy = 0;
+          for(int i=0; i < njets; i++)
+            {
+              dpx += jets[i]->getp4()->Px() - before[i].Px();
+              dpy += jets[i]->getp4()->Py() - before[i].Py();
+            }
+          if ( fabs(met.getp4()->Px() - (metBefore.Px() - dpx)) > 1e-3 ||
+               fabs(met.getp4()->Py() - (metBefore.Py() - dpy)) > 1e-3 )
+            nbad++;
+
+          if ( v == 2 )
+            {
+              // empty overlay: the nominal objects exactly
+              if ( !overlay.getJets().empty() || !identical(*met.getp4(), metBefore) ) nbad++;
+              for(int i=0; i < njets; i++)
+                if ( jets[i] != &nominal[i] ) nbad++;
+              continue;
+            }
+
+          // inverse overlay from the varied jets back to the nominal pT and mass
+          inverse.reset(njets);
+          for(int i=0; i < njets; i++)
+            inverse.setJet(i, *jets[i]->getp4(), before[i].Pt(), before[i].M());
+          if ( inverse.getJets().size() != overlay.getJets().size() ) nbad++;
+          vector<objectJet> varied(njets);
+          for(int i=0; i < njets; i++) varied[i] = *jets[i];
+          apply(inverse, varied, met, inverseStorage, inverseMET, inverseJets);
+          for(int i=0; i < njets; i++)
+            if ( !identical(*inverseJets[i]->getp4(), before[i]) ) nbad++;
+          for(int k=0; k < 4; k++)
+            if ( fabs(inverse.getJetsOffset()[k] + overlay.getJetsOffset()[k]) > 1e-3 ) nbad++;
+          if ( fabs(inverseMET.getp4()->Px() - metBefore.Px()) > 1e-3 ||
+               fabs(inverseMET.getp4()->Py() - metBefore.Py()) > 1e-3 )
+            nbad++;
+        }
+      j += njets;
+
+      // the nominal objects were never touched
+      for(int i=0; i < njets; i++)
+        if ( !identical(*nominal[i].getp4(), before[i]) ) nbad++;
+      if ( !identical(*nominalMET.getp4(), metBefore) ) nbad++;
+    }
+
+  cout << "events: " << nevents << "  changed jets: " << nchanged
+       << "  failed checks: " << nbad
+       << (nbad == 0 ? "  OK" : "  FAILED") << endl;
+  return nbad == 0 ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+//
+// testVariedEvent.cc
+//
+//   description: Select random jets into a nominal event, start varied
+//                events from it with shareUnvaried() and select the varied
+//                jets again, as a JES/JER pass does: the per-collection
+//                mass lists and the light-jet SoA must hold one entry per
+//                selected jet of the varied event, and the nominal event
+//                must keep its own.
+//
+
+#include "ttHHanalyzer_trigger.h"
+#include <iostream>
+#include <vector>
+#include <stdint.h>
+
+using namespace std;
+
+double uniform(uint64_t i, uint64_t stream)
+{
+  uint64_t z = i * 0x9E3779B97F4A7C15ULL + stream * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z = z ^ (z >> 31);
+  return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// selects every jet, as b-jet or light jet after its b-tag score
+void select(event& ev, vector<objectJet>& jets)
+{
+  for(unsigned int i=0; i < jets.size(); i++)
+    {
+      ev.selectJet(&jets[i]);
+      if ( jets[i].bTagCSV > objectJet::valbTagMedium ) ev.selectbJet(&jets[i]);
+      else ev.selectLightJet(&jets[i]);
+    }
+}
+
+// one entry per selected jet in every per-collection list
+bool consistent(event& ev)
+{
+  return (int)ev.getSelbJetsMass()->size() == ev.getnbJet()
+    && (int)ev.getSelLightJetsMass()->size() == ev.getnLightJet()
+    && ev.getSelLightJetsSoA()->size() == ev.getnLightJet();
+}
+
+int main()
+{
+  const long nevents = 1000;
+  const int nvariations = 4; // JES up/down, JER up/down
+  long nbad = 0;
+  uint64_t j = 0;
+  for(long iev=0; iev < nevents; iev++)
+    {
+      int njets = 4 + int(9 * uniform(iev, 0));
+      vector<objectJet> nominalJets(njets);
+      for(int i=0; i < njets; i++, j++)
+        {
+          nominalJets[i] = objectJet(30 + 200 * uniform(j, 1), 4.8 * uniform(j, 2) - 2.4,
+                                     6.28 * uniform(j, 3) - 3.14, 5 + 15 * uniform(j, 4));
+          nominalJets[i].bTagCSV = uniform(j, 5);
+        }
+      event nominal;
+      select(nominal, nominalJets);
+      const int nb = nominal.getnbJet();
+      if ( !consistent(nominal) ) nbad++;
+
+      for(int v=0; v < nvariations; v++)
+        {
+          vector<objectJet> variedJets(nominalJets);
+          for(int i=0; i < njets; i++)
+            {
+              const CachedP4& p4 = *variedJets[i].getp4();
+              float scale = 0.9 + 0.2 * uniform(j + i, 6 + v);
+              variedJets[i].vary(scale * p4.Pt(), scale * p4.M());
+            }
+          event varied;
+          varied.shareUnvaried(nominal);
+          select(varied, variedJets);
+          if ( !consistent(varied) || varied.getnbJet() != nb ) nbad++;
+        }
+      if ( !consistent(nominal) || nominal.getnbJet() != nb ) nbad++;
+    }
+
+  cout << "events: " << nevents << "  variations: " << nvariations
+       << "  inconsistent events: " << nbad
+       << (nbad == 0 ? "  OK" : "  FAILED") << endl;
+  return nbad == 0 ? 0 : 1;
+}
@@ -13,28 +13,8 @@ using namespace std;
 using namespace Logger;
  
 void ttHHanalyzer::performAnalysis(){
+    // JES, JER and b-tag variations are filled in the same loop (see _variations)
     loop(noSys, false);
-    /*    getbJetEffMap();
-    initHistograms(kJES, false);
-    initTree(kJES, false);
-    loop(kJES, false);
-    initHistograms(kJES, true);
-    initTree(kJES, true);
-    loop(kJES, true);
-
-    initHistograms(kJER, false);
-    initTree(kJER, false);
-    loop(kJER, false);
-    initHistograms(kJER, true);
-    initTree(kJER, true);
-    loop(kJER, true);
-
-    initHistograms(kbTag, false);
-    initTree(kbTag, false);
-    loop(kbTag, false);
-    initHistograms(kbTag, true);
-    initTree(kbTag, true);
-    loop(kbTag, true); */
 
 }
 
@@ -77,7 +57,25 @@ void ttHHanalyzer::loop(sysName sysType, bool up){
 	event * currentEvent = new event;
         ////cout << "Processed events: " << entry << endl;
 	_ev->read(entry);       // read an event into event buffer
+	_ev->fillObjects();     // once for the nominal and all variations
+	_jetVariations.setEvent(_ev);
+	if(_theoryWeights) setTheoryWeights(entry);
+	if(_nReplicas > 0) poissonReplicaWeights(_ev->run, _ev->luminosityBlock, _ev->event, _nReplicas, &_replicaWeights[0]);
+	_variation = 0;
+	_nominalEvent = currentEvent;
+	_passSelection = false;
+	_inputEntry = entry;
 	process(currentEvent, sysType, up);
+	if(_friendTree == 1 && !_passSelection) fillTree(nullptr);
+	// kinematic variations: rebuild the objects from the same buffer
+	for(unsigned v = 1; v < _variations.size(); v++){
+	    if(_variations[v].sys == kbTag) continue;
+	    event * varEvent = new event;
+	    _variation = v;
+	    process(varEvent, _variations[v].sys, _variations[v].up);
+	    delete varEvent;
+	}
+	_variation = 0;
 
 	if (entry % 1000 == 0){
             print("Processed events of " + analysisInfo + ": " + to_string(entry) ,"c");
@@ -91,6 +89,9 @@ void ttHHanalyzer::loop(sysName sysType, bool up){
     
     writeHistos();
     writeTree();
+    writebTagEff();
+    if(_nTheoryWeightMismatch > 0)
+	print(to_string(_nTheoryWeightMismatch) + " entries had a different number of theory weights than the first one", "r", "warning");
     
     
 
@@ -102,12 +103,50 @@ void ttHHanalyzer::loop(sysName sysType, bool up){
     } 
     hCutFlow->Write();
     hCutFlow_w->Write();
+    if(_cutScan){
+	_of->file->cd();
+	_scan.finalize();
+	_scan.write("cutScan");
+    }
+    if(_nReplicas > 0){
+	const char * names[] = {"cutflow_bootstrap", "cutflow_w_bootstrap"};
+	const char * titles[] = {"N_{cutFlow} bootstrap", "N_{weighted} bootstrap"};
+	for(int h = 0; h < 2; h++){
+	    TH2D * hist = _cutflowBootstrap.makeTH2D(h, names[h], titles[h]);
+	    int bin = 1;
+	    for(const auto & x : cutflow) hist->GetXaxis()->SetBinLabel(bin++, x.first.c_str());
+	    hist->Write();
+	    delete hist;
+	}
+    }
 }
 
-void ttHHanalyzer::createObjects(event * thisEvent, sysName sysType, bool up){
+// Theory weights of the entry for the weight sets. The sets are booked with
+// the number of weights of the first entry; an entry with another number
+// fills the missing copies with the nominal weight and drops the extra
+// weights, so it is reported.
+void ttHHanalyzer::setTheoryWeights(int entry){
+    const std::vector<float> * weights[] = {&_ev->LHEScaleWeight, &_ev->LHEPdfWeight, &_ev->PSWeight};
+    const int sets[] = {_lheScaleSet, _lhePdfSet, _psSet};
+    bool mismatch = false;
+    for(int i = 0; i < 3; i++){
+	_histos.setWeights(sets[i], *weights[i]);
+	const int n = weights[i]->size(), booked = _histos.getWeightSetSize(sets[i]);
+	if(n == booked || (n == 0 && booked == 1)) continue;
+	if(!mismatch && _nTheoryWeightMismatch == 0)
+	    print("entry " + to_string(entry) + " has " + to_string(n) + " " + std::string(_histos.getWeightSetName(sets[i]).Data())
+		  + ", " + to_string(booked) + " booked from the first entry", "r", "warning");
+	mismatch = true;
+    }
+    if(mismatch) _nTheoryWeightMismatch++;
+}
 
-    _ev->fillObjects();
+void ttHHanalyzer::createObjects(event * thisEvent, sysName sysType, bool up){
 
+    if(_sys && (sysType == kJES || sysType == kJER)){
+	createVariedObjects(thisEvent, sysType, up);
+	return;
+    }
  
     thisEvent->setMuonTrigger(
         _ev->HLT_IsoMu27
@@ -208,11 +247,12 @@ void ttHHanalyzer::createObjects(event * thisEvent, sysName sysType, bool up){
    
   
     thisEvent->setPV(_ev->PV_npvsGood);
-    std::vector<eventBuffer::GenPart_s> genPart = _ev->GenPart;      
-    std::vector<eventBuffer::Jet_s> jet = _ev->Jet;
-    std::vector<eventBuffer::Muon_s> muonT = _ev->Muon;
-    std::vector<eventBuffer::Electron_s> ele = _ev->Electron;
-    std::vector<eventBuffer::FatJet_s> boostedJet = _ev->FatJet;
+    // decoded once per entry in loop(), shared by the variations
+    const std::vector<eventBuffer::GenPart_s> & genPart = _ev->GenPart;      
+    const std::vector<eventBuffer::Jet_s> & jet = _ev->Jet;
+    const std::vector<eventBuffer::Muon_s> & muonT = _ev->Muon;
+    const std::vector<eventBuffer::Electron_s> & ele = _ev->Electron;
+    const std::vector<eventBuffer::FatJet_s> & boostedJet = _ev->FatJet;
     objectGenPart * currentGenPart; 
     objectBoostedJet * currentBoostedJet;
     objectJet * currentJet;
@@ -220,8 +260,8 @@ void ttHHanalyzer::createObjects(event * thisEvent, sysName sysType, bool up){
     objectLep * currentEle;
     int nVetoMuons = 0, nVetoEle = 0;
     objectMET * MET = new objectMET(_ev->PuppiMET_pt, 0, _ev->PuppiMET_phi, 0);
-    float e = 1., es  = 1., pe = 1., pes = 1.;
-    float me = 1., mes = 1., pme = 1.,  pmes = 1.;   
+    const bool bTagVariations = _sys && _bTagEffReady && sysType == noSys;
+    _bTagSF.clear();
     thisEvent->setMET(MET);
 
 
@@ -295,63 +335,26 @@ void ttHHanalyzer::createObjects(event * thisEvent, sysName sysType, bool up){
     thisEvent->orderLeptons();
 
     float dR = 0., deltaEta = 0., deltaPhi = 0.;
+    _nominalJets.assign(jet.size(), nullptr);
+    _nominalJetPass.assign(jet.size(), 0);
     for(int i=0; i < jet.size(); i++){
        	currentJet = new objectJet(jet[i].pt, jet[i].eta, jet[i].phi, jet[i].mass);
 	currentJet->bTagCSV = jet[i].btagDeepFlavB;
 	currentJet->jetID = jet[i].jetId;
 	currentJet->jetPUid = jet[i].puId;
-	if(_sys && sysType == kJES){
-	    if(jet[i].btagDeepFlavB > objectJet::valbTagMedium){  	       
-		currentJet->scale(getSysJES(_hbJES, currentJet->getp4()->Pt()), up);
-	    } else {
-		currentJet->scale(getSysJES(_hJES, currentJet->getp4()->Pt()), up);
-	    }
-	    if(up) thisEvent->getMET()->subtractp4(currentJet->getOffset());
-	    else thisEvent->getMET()->addp4(currentJet->getOffset());
-	}else if(_sys && sysType == kJER){
-	    if(up) currentJet->scale(getSysJER(0.03));
-	    else currentJet->scale(getSysJER(0.001));
-	    thisEvent->getMET()->subtractp4(currentJet->getOffset());
-	}
-	if(currentJet->getp4()->Pt() > cut["jetPt"] && fabs(currentJet->getp4()->Eta()) < abs(cut["jetEta"]) && currentJet->jetID >= cut["jetID"]){
-	    ////if((currentJet->getp4()->Pt() < cut["maxPt_PU"] && currentJet->jetPUid >= cut["jetPUid"]) || (currentJet->getp4()->Pt() >= cut["maxPt_PU"])){
-		if(jet[i].btagDeepFlavB <= objectJet::valbTagLoose){  	     
-		    thisEvent->selectLightJet(currentJet);
-		} else if(jet[i].btagDeepFlavB > objectJet::valbTagMedium){  	     
-		    thisEvent->selectbJet(currentJet);
-		    if(!_sys || sysType == noSys) _hbJetEff->Fill(currentJet->getp4()->Pt());
-		    if(_sys && sysType==kbTag){
-			e = _hbJetEff->GetBinContent(_hbJetEff->FindBin(currentJet->getp4()->Pt()));
-			if(e < cEps) e = cEps;
-			pe *= e; 
-			if(up)
-			    pes *= (1.+_hSysbTagM->GetBinContent(_hSysbTagM->FindBin(currentJet->getp4()->Pt())))*e;
-			else 
-			    pes *= (1.-_hSysbTagM->GetBinContent(_hSysbTagM->FindBin(currentJet->getp4()->Pt())))*e;
-		    }
-		} else {
-		    if(_sys && sysType==kbTag){
-			me = _hbJetEff->GetBinContent(_hbJetEff->FindBin(currentJet->getp4()->Pt()));
-			if(me < cEps) me = cEps;
-			else if(me == 1) me = 1 - cEps;
-			pme *= 1 - me;
-			if(up)
-			    pmes *= (1. - me * (1.+_hSysbTagM->GetBinContent(_hSysbTagM->FindBin(currentJet->getp4()->Pt()))));
-			else
-			    pmes *= (1. - me * (1.-_hSysbTagM->GetBinContent(_hSysbTagM->FindBin(currentJet->getp4()->Pt()))));
-		    }
-		}
-		thisEvent->selectJet(currentJet);
-		if(!_sys || sysType == noSys) _hJetEff->Fill(currentJet->getp4()->Pt());
-		if(jet[i].btagDeepFlavB > objectJet::valbTagLoose){       	   
-		    thisEvent->selectLoosebJet(currentJet);
-		}
-	}	    
+	_nominalJets[i] = currentJet;
+	_nominalJetPass[i] = categorizeJet(thisEvent, currentJet, jet[i], sysType == noSys);
     }
     thisEvent->orderJets();
 
-    if(_sys && sysType==kbTag) thisEvent->setbTagSys( pes*pmes/(pe*pme));
-    else thisEvent->setbTagSys(1.);
+    // all b-tag weights of the event in one pass over the jets, kept in the event.
+    // The nominal SF is a placeholder (bTagSFNominal), so only the up/down
+    // variations are used; the nominal weight stays 1.
+    thisEvent->setbTagSys(1.);
+    if(bTagVariations){
+	_bTagSF.compute();
+	thisEvent->setbTagSysVariations(_bTagSF.weight(BTagSFWeights::kUp), _bTagSF.weight(BTagSFWeights::kDown));
+    }
     
     //    thisEvent->setnVetoLepton( nVetoMuons + nVetoEle);
 
@@ -386,12 +389,90 @@ void ttHHanalyzer::createObjects(event * thisEvent, sysName sysType, bool up){
 
 
 
+// Jet selection, shared by the nominal and the varied jets. The b-tag
+// weights and the efficiency map are only filled for the nominal jets.
+bool ttHHanalyzer::categorizeJet(event * thisEvent, objectJet * currentJet, const eventBuffer::Jet_s & jet, bool nominal){
+    const bool bTagVariations = nominal && _sys && _bTagEffReady;
+    if(!(currentJet->getp4()->Pt() > cut["jetPt"] && fabs(currentJet->getp4()->Eta()) < abs(cut["jetEta"]) && currentJet->jetID >= cut["jetID"])) return false;
+    ////if((currentJet->getp4()->Pt() < cut["maxPt_PU"] && currentJet->jetPUid >= cut["jetPUid"]) || (currentJet->getp4()->Pt() >= cut["maxPt_PU"])){
+    if(jet.btagDeepFlavB <= objectJet::valbTagLoose){
+	thisEvent->selectLightJet(currentJet);
+    } else if(jet.btagDeepFlavB > objectJet::valbTagMedium){
+	thisEvent->selectbJet(currentJet);
+	if(bTagVariations)
+	    _bTagSF.add(_bTagEff.efficiency(currentJet->getp4()->Pt(), fabs(currentJet->getp4()->Eta()), BTagEffMap::fromHadronFlavour(jet.hadronFlavour)),
+			bTagSFNominal, _bTagSFUncTable.value(currentJet->getp4()->Pt()), true);
+    } else {
+	if(bTagVariations)
+	    _bTagSF.add(_bTagEff.efficiency(currentJet->getp4()->Pt(), fabs(currentJet->getp4()->Eta()), BTagEffMap::fromHadronFlavour(jet.hadronFlavour)),
+			bTagSFNominal, _bTagSFUncTable.value(currentJet->getp4()->Pt()), false);
+    }
+    thisEvent->selectJet(currentJet);
+    if(_bTagEffBuild && nominal)
+	_bTagEff.fill(currentJet->getp4()->Pt(), fabs(currentJet->getp4()->Eta()), BTagEffMap::fromHadronFlavour(jet.hadronFlavour), jet.btagDeepFlavB > objectJet::valbTagMedium);
+    if(jet.btagDeepFlavB > objectJet::valbTagLoose){
+	thisEvent->selectLoosebJet(currentJet);
+    }
+    return true;
+}
+
+// Changed jets of a JES/JER variation, from the nominal jets of the entry.
+void ttHHanalyzer::buildOverlay(sysName sysType, bool up){
+    const std::vector<eventBuffer::Jet_s> & jet = _ev->Jet;
+    _overlay.reset(jet.size());
+    if(cut["jetVariations"] == 1){
+	const JetVariationProvider::view * varied;
+	if(sysType == kJES) varied = &_jetVariations.get(up ? JetVariationProvider::kJESUp : JetVariationProvider::kJESDown);
+	else varied = &_jetVariations.get(up ? JetVariationProvider::kJERUp : JetVariationProvider::kJERDown);
+	for(int i=0; i < jet.size(); i++)
+	    _overlay.setJet(i, *_nominalJets[i]->getp4(), varied->pt[i], varied->mass[i]);
+	return;
+    }
+    if(sysType == kJES) getSysJES(jet, _jetJES);
+    for(int i=0; i < jet.size(); i++){
+	const CachedP4 & p4 = *_nominalJets[i]->getp4();
+	float scale;
+	if(sysType == kJES) scale = up ? 1. + _jetJES[i] : 1. - _jetJES[i];
+	else scale = 1. + getSysJER(up ? 0.03 : 0.001);
+	_overlay.setJet(i, p4, scale*p4.Pt(), scale*p4.M());
+    }
+}
+
+// JES/JER variation: the nominal event of the entry with the overlay applied.
+// Only the changed jets are rebuilt, into _variedJets (reused by the next
+// variation, once this one is processed); the unchanged ones are the nominal
+// objects, and those that failed the nominal selection are skipped.
+void ttHHanalyzer::createVariedObjects(event * thisEvent, sysName sysType, bool up){
+    const std::vector<eventBuffer::Jet_s> & jet = _ev->Jet;
+    buildOverlay(sysType, up);
+    thisEvent->shareUnvaried(*_nominalEvent);
+    _variedMET = *_nominalEvent->getMET();
+    // without changed jets the MET stays the nominal one, cached values included
+    if(!_overlay.getJets().empty()) _variedMET.subtractp4(_overlay.getJetsOffset());
+    thisEvent->setMET(&_variedMET);
+    _variedJets.resize(_overlay.getJets().size()); // no reallocation below
+    int nChanged = 0;
+    for(int i=0; i < jet.size(); i++){
+	const VariationOverlay::jetChange * change = _overlay.getJet(i);
+	if(!change){
+	    if(_nominalJetPass[i]) categorizeJet(thisEvent, _nominalJets[i], jet[i], false);
+	    continue;
+	}
+	objectJet * currentJet = &_variedJets[nChanged++];
+	*currentJet = *_nominalJets[i];
+	currentJet->vary(change->pt, change->mass);
+	categorizeJet(thisEvent, currentJet, jet[i], false);
+    }
+    thisEvent->orderJets();
+    thisEvent->setbTagSys(1.);
+}
+
+
+
 bool ttHHanalyzer::selectObjects(event *thisEvent){
 
 
-    cutflow["noCut"]+=1;
-    hCutFlow->Fill("noCut",1);
-    hCutFlow_w->Fill("noCut",_weight);
+    countCut("noCut");
 
     ////if(cut["trigger"] > 0 && thisEvent->getTriggerAccept() == false){
     ////    return false;
@@ -401,9 +482,8 @@ bool ttHHanalyzer::selectObjects(event *thisEvent){
     {
         return false;
     }
-    cutflow["MuonTrigger"]+=1;                 
-    hCutFlow->Fill("MuonTrigger",1);
-    hCutFlow_w->Fill("MuonTrigger",_weight);
+    countCut("MuonTrigger");
+    if(_cutScan && _variation == 0) scanCuts(thisEvent);
 
     ////if(cut["filter"] > 0 && thisEvent->getMETFilter() == false){
     ////    return false;
@@ -416,17 +496,13 @@ bool ttHHanalyzer::selectObjects(event *thisEvent){
     if(!(thisEvent->getnSelJet() >= cut["nJets"] )){
 	return false;
     }
-    cutflow["njets>=6"]+=1;                 
-    hCutFlow->Fill("njets>=6",1);
-    hCutFlow_w->Fill("njets>=6",_weight);
+    countCut("njets>=6");
 
 
     if(!(thisEvent->getnbJet() >= cut["nbJets"])){
 	    return false;
     }
-    cutflow["nbjets>=3"]+=1;                 
-    hCutFlow->Fill("nbjets>=3",1);
-    hCutFlow_w->Fill("nbjets>=3",_weight);
+    countCut("nbjets>=3");
     
     //    if(!(thisEvent->getnSelLepton()  == cut["nLeptons"])){
     ////if(thisEvent->getnSelLepton() < 1){
@@ -434,9 +510,7 @@ bool ttHHanalyzer::selectObjects(event *thisEvent){
     if(!(thisEvent->getSelJets()->at(5)->getp4()->Pt() > cut["6thJetsPT"])){
             return false;
     }
-    cutflow["6thJetsPT>40"]+=1;
-    hCutFlow->Fill("6thJetsPT>40",1);
-    hCutFlow_w->Fill("6thJetsPT>40",_weight);
+    countCut("6thJetsPT>40");
 
 
     ////if(!(thisEvent->getnSelLepton() == cut["nLeptons"])){
@@ -453,9 +527,7 @@ bool ttHHanalyzer::selectObjects(event *thisEvent){
     if(!(thisEvent->getSumSelJetScalarpT() > cut["HT"])){
         return false;
     }
-    cutflow["HT>500"]+=1;
-    hCutFlow->Fill("HT>500",1);
-    hCutFlow_w->Fill("HT>500",_weight);
+    countCut("HT>500");
 
  
     ////if(!(thisEvent->getnLightJet() >= cut["nlJets"])){
@@ -466,30 +538,21 @@ bool ttHHanalyzer::selectObjects(event *thisEvent){
     ////hCutFlow_w->Fill("nljets>=2",_weight);    
 
 
-    const float W_mass = 80.377f;
-    float closest_mass_difference = std::numeric_limits<float>::max();
     float closest_pair_mass_sum = 0.0f;
-    std::vector<float> jet_masses = thisEvent->getSelJetsMass();
-
-    for (size_t i = 0; i < jet_masses.size(); ++i) {
-        for (size_t j = i + 1; j < jet_masses.size(); ++j) {
-            float mass_sum = jet_masses[i] + jet_masses[j];
-            float mass_difference = std::fabs(mass_sum - W_mass);
-
-            if (mass_difference < closest_mass_difference) {
-                closest_mass_difference = mass_difference;
-                closest_pair_mass_sum = mass_sum;
-            }
-        }
+    if(cut["hadWInvMass"] > 0){
+	closest_pair_mass_sum = closestPairInvMass(*thisEvent->getSelLightJetsSoA(), cWMass);
+    } else {
+	closest_pair_mass_sum = closestPairSum(*thisEvent->getSelbJetsMass(), cWMass, _jetMassScratch);
+    }
+    _histos.fill(_hInvMassHadW, closest_pair_mass_sum, _weight, _variation);
+    for(unsigned v = 1; v < _variations.size() && _variation == 0; v++){
+	if(_variations[v].sys == kbTag) _histos.fill(_hInvMassHadW, closest_pair_mass_sum, _weight*getVariationWeight(thisEvent, v), v);
     }
-    hInvMassHadW->Fill( closest_pair_mass_sum, _weight);
 
     if( closest_pair_mass_sum > 250.0 || closest_pair_mass_sum < 30.0 ){
              return false;
     }
-    cutflow["30<ljetsM<250"]+=1;
-    hCutFlow->Fill("30<ljetsM<250",1);
-    hCutFlow_w->Fill("30<ljetsM<250",_weight);
+    countCut("30<ljetsM<250");
 
 
     ////if(thisEvent->getSelLeptons()->at(0)->charge == thisEvent->getSelLeptons()->at(1)->charge){
@@ -517,12 +580,10 @@ bool ttHHanalyzer::selectObjects(event *thisEvent){
 
     if(cut["trigger"] > 0 && thisEvent->getHadTriggerAccept() == true)
     {
-        cutflow["HadTrigger"]+=1;                 
-        hCutFlow->Fill("HadTrigger",1);
-        hCutFlow_w->Fill("HadTrigger",_weight);
+        countCut("HadTrigger");
     }
 
-    cutflow["nTotal"]+=1;
+    if(_variation == 0) cutflow["nTotal"]+=1;
 
     /*	std::cout << x.first  // string (key)
 		  << ':' 
@@ -535,31 +596,49 @@ bool ttHHanalyzer::selectObjects(event *thisEvent){
 }
 
 
-void ttHHanalyzer::motherReco(const TLorentzVector & dPar1p4,const TLorentzVector & dPar2p4, const float mother1mass, float & _minChi2,float & _bbMassMin1){
-    float bbMass1, chi2;
-    bbMass1 = (dPar1p4+dPar2p4).M();
-    chi2 = pow((bbMass1 - mother1mass),2)/pow((dPar1p4.Pt()+dPar2p4.Pt())/2.*0.02,0.5);
-    if(_minChi2 > chi2){
-	_minChi2      = chi2;
-	_bbMassMin1   = bbMass1;
-	_bpTHiggs1    = (dPar1p4+dPar2p4).Pt();
-    }
-} 
-
-
-void ttHHanalyzer::diMotherReco(const TLorentzVector & dPar1p4,const TLorentzVector & dPar2p4,const TLorentzVector & dPar3p4,const TLorentzVector & dPar4p4, const float mother1mass, const float  mother2mass, float & _minChi2,float & _bbMassMin1, float & _bbMassMin2){
-    float bbMass1, bbMass2, chi2;
-    bbMass1 = (dPar1p4+dPar2p4).M();
-    bbMass2 = (dPar3p4+dPar4p4).M();
-    chi2 = pow((bbMass1 - mother1mass),2)/pow((dPar1p4.Pt()+dPar2p4.Pt())/2.*0.2,0.5) + pow((bbMass2 - mother2mass),2)/pow((dPar3p4.Pt()+dPar4p4.Pt())/2.*0.02,0.5);
-    if(_minChi2 > chi2){
-	_minChi2      = chi2;
-	_bbMassMin1   = bbMass1;
-	_bbMassMin2   = bbMass2;
-	_bpTHiggs1    = (dPar1p4+dPar2p4).Pt();
-	_bpTHiggs2    = (dPar3p4+dPar4p4).Pt();
+// Boosted/resolved hybrid HH: Higgs-tagged fat jets are taken as Higgs
+// candidates, the b jets inside them (dR < 0.8) are removed and the
+// remaining Higgs, if any, is paired from the left-over b jets.
+void ttHHanalyzer::hybridHiggsReco(event *thisEvent){
+    std::vector<objectBoostedJet*>* higgsJets = thisEvent->getSelHadronicHiggses();
+    _hybridCategory = kResolved;
+    _hybridMassH1 = -1;
+    _hybridMassH2 = -1;
+    _hybridChi2 = cLargeValue;
+
+    if(higgsJets->size() == 0){
+	const PairingEngine::result & recoHH = _pairing.getResult(_hypHH);
+	if(recoHH.pair1 < 0) return;
+	_hybridMassH1 = recoHH.mass1;
+	_hybridMassH2 = recoHH.mass2;
+	_hybridChi2   = recoHH.chi2;
+	return;
+    }
+
+    _hybridMassH1 = higgsJets->at(0)->softDropMass;
+    if(higgsJets->size() > 1){
+	_hybridCategory = kBoosted;
+	_hybridMassH2 = higgsJets->at(1)->softDropMass;
+	return;
+    }
+
+    _hybridCategory = kSemiBoosted;
+    unsigned int overlapMask = 0;
+    _bJetOverlap.clear();
+    _bJetIndex.query(higgsJets->at(0)->getp4()->Eta(), higgsJets->at(0)->getp4()->Phi(), 0.8, _bJetOverlap);
+    for(const int ibjet: _bJetOverlap){
+	if(ibjet < PairingEngine::cMaxJets) overlapMask |= 1u << ibjet;
+    }
+    for(const auto & pair: _pairing.getPairs()){
+	if(pair.mask & overlapMask) continue;
+	const float chi2 = PairingEngine::chi2Term(pair, cHiggsMass, 0.02);
+	if(_hybridChi2 > chi2){
+	    _hybridChi2   = chi2;
+	    _hybridMassH2 = pair.mass;
+	}
     }
-} 
+}
+
 
 void ttHHanalyzer::analyze(event *thisEvent){
 
@@ -572,26 +651,31 @@ void ttHHanalyzer::analyze(event *thisEvent){
     for(int k = 0; k < jetsInv->size(); k++){
 	 vectorsJet.push_back(jetsInv->at(k)->getp4()->Vect());
     }
-    for(int m = 0; m < bJetsInv->size(); m++){
-	vectorsBjet.push_back(bJetsInv->at(m)->getp4()->Vect());
-	if(thisEvent->getnGenPart() < 1) continue;
-	bJetsInv->at(m)->matchedtoHiggs = false;	    	
-	for(auto genParticle: *thisEvent->getGenParts()){
-	    float dR = bJetsInv->at(m)->getp4()->DeltaR( *genParticle->getp4());
-	    if(genParticle->hasHiggsMother == true && dR < 0.8 && (fabs(bJetsInv->at(m)->getp4()->Pt() - (*genParticle->getp4()).Pt()) < bJetsInv->at(m)->getp4()->Pt()*0.4) ){
-	      if(dR > genParticle->dRmatched) {
-		  //std::cout << "this was matched to a closer particle before" << std::endl;
-	      }else if( genParticle->matched){
-		  //std::cout << "this was matched before" << std::endl;
-	      }
-	      bJetsInv->at(m)->matchedtoHiggs   = true;	
-	      bJetsInv->at(m)->matchedtoHiggsdR = dR;	
-	      genParticle->matched = true;
-	      genParticle->dRmatched = dR;
-	      break;
-	    }
-	} 
-	//	std::cout << bJetsInv->at(m)->matchedtoHiggsb << std::endl;  
+    _bJetIndex.clear();
+    for(auto bjet: *bJetsInv){
+	vectorsBjet.push_back(bjet->getp4()->Vect());
+	bjet->matchedtoHiggs = false;
+	_bJetIndex.add(bjet->getp4()->Eta(), bjet->getp4()->Phi());
+    }
+    _bJetIndex.build();
+    if(thisEvent->getnGenPart() > 0){
+	std::vector<objectGenPart*>* genParts = thisEvent->getGenParts();
+	_genPartIndex.clear();
+	for(auto genParticle: *genParts){
+	    _genPartIndex.add(genParticle->getp4()->Eta(), genParticle->getp4()->Phi());
+	}
+	_genPartIndex.build();
+	// one-to-one, closest dR first, b quarks from H with compatible pT
+	auto accept = [&](int ibjet, int igen){
+	    const float bjetPt = bJetsInv->at(ibjet)->getp4()->Pt();
+	    return genParts->at(igen)->hasHiggsMother && fabs(bjetPt - genParts->at(igen)->getp4()->Pt()) < bjetPt*0.4;
+	};
+	for(const auto & match: matchOneToOne(_bJetIndex, _genPartIndex, 0.8, accept)){
+	    bJetsInv->at(match.first)->matchedtoHiggs   = true;
+	    bJetsInv->at(match.first)->matchedtoHiggsdR = match.distance;
+	    genParts->at(match.second)->matched   = true;
+	    genParts->at(match.second)->dRmatched = match.distance;
+	}
     }
 
     _minChi2Higgs  = cLargeValue;
@@ -608,64 +692,81 @@ void ttHHanalyzer::analyze(event *thisEvent){
     _bbMassMinHH2Matched = -1;
     _bbMassMinHH2NotMatched = -1;
 
-    float tempminChi2 = cLargeValue, tmpMassMin1HiggsZ = 0., tmpMassMin2HiggsZ = 0.;
-    float tempMinChi2SHiggs = cLargeValue, tempMinChi2SHiggs_r = cLargeValue, tmpMassMinSHiggs = 0.;
-    float tempMinChi2SHiggsMatched = cLargeValue, tempMinChi2SHiggsMatched_r = cLargeValue, tmpMassMinSHiggsMatched = 0.;
-    float tempMinChi2SHiggsNotMatched = cLargeValue, tempMinChi2SHiggsNotMatched_r = cLargeValue, tmpMassMinSHiggsNotMatched = 0.;
+    // Pair table of the b jets, shared by the single H and the HH/ZZ/ZH reco
+    _pairing.setJets(bJetsInv, [](objectJet * jet){ return jet->matchedtoHiggs; });
+
     //extract H
-    for( int ibjet1 = 0; ibjet1 < bJetsInv->size(); ibjet1++){
-	tempMinChi2SHiggs = cLargeValue;
-	bJetsInv->at(ibjet1)->minChiHiggsIndex = -1;
-	for( int ibjet2 = 0; ibjet2 < bJetsInv->size(); ibjet2++){
-	    if( ibjet1 == ibjet2) continue;	   
-	    tempMinChi2SHiggs_r = tempMinChi2SHiggs;
-	    motherReco(*bJetsInv->at(ibjet1)->getp4(), *bJetsInv->at(ibjet2)->getp4(),cHiggsMass, tempMinChi2SHiggs, tmpMassMinSHiggs);
-	    if(tempMinChi2SHiggs_r > tempMinChi2SHiggs){
-		bJetsInv->at(ibjet1)->minChiHiggsIndex = ibjet2;
+    if(_treeMinChiHiggs){
+	for(auto bjet: *bJetsInv){
+	    bjet->minChiHiggs = cLargeValue;
+	    bjet->minChiHiggsIndex = -1;
+	}
+    }
+    for(const auto & pair: _pairing.getPairs()){
+	const float chi2 = PairingEngine::chi2Term(pair, cHiggsMass, 0.02);
+	if(_treeMinChiHiggs){
+	    objectJet * bjet1 = bJetsInv->at(pair.i);
+	    objectJet * bjet2 = bJetsInv->at(pair.j);
+	    if(bjet1->minChiHiggs > chi2){
+		bjet1->minChiHiggs = chi2;
+		bjet1->minChiHiggsIndex = pair.j;
 	    }
-	    if(bJetsInv->at(ibjet1)->matchedtoHiggs == true && bJetsInv->at(ibjet2)->matchedtoHiggs == true){
-		motherReco(*bJetsInv->at(ibjet1)->getp4(), *bJetsInv->at(ibjet2)->getp4(),cHiggsMass, _minChi2SHiggsMatched, _bbMassMinSHiggsMatched);		
-	    } else if (bJetsInv->at(ibjet1)->matchedtoHiggs == false && bJetsInv->at(ibjet2)->matchedtoHiggs == false){
-		motherReco(*bJetsInv->at(ibjet1)->getp4(), *bJetsInv->at(ibjet2)->getp4(),cHiggsMass, _minChi2SHiggsNotMatched, _bbMassMinSHiggsNotMatched);		
+	    if(bjet2->minChiHiggs > chi2){
+		bjet2->minChiHiggs = chi2;
+		bjet2->minChiHiggsIndex = pair.i;
 	    }
 	}
-	bJetsInv->at(ibjet1)->minChiHiggs = tempMinChi2SHiggs;
+	if(pair.matched && _minChi2SHiggsMatched > chi2){
+	    _minChi2SHiggsMatched = chi2;
+	    _bbMassMinSHiggsMatched = pair.mass;
+	} else if(pair.notMatched && _minChi2SHiggsNotMatched > chi2){
+	    _minChi2SHiggsNotMatched = chi2;
+	    _bbMassMinSHiggsNotMatched = pair.mass;
+	}
     }
 
 
-    // HH & ZZ reco : 4 medium b jet case
-
-    if(thisEvent->getnbJet() >  3){
-	for( int ibjet1 = 0; ibjet1 < bJetsInv->size(); ibjet1++){
-	    for( int ibjet2 = ibjet1+1; ibjet2 < bJetsInv->size(); ibjet2++){
-		if( ibjet1 == ibjet2) continue;
-		for( int ibjet3 = 1; ibjet3 < bJetsInv->size(); ibjet3++){
-		    if(ibjet1 == ibjet3 || ibjet2 == ibjet3) continue;
-		    for( int ibjet4 = ibjet3+1; ibjet4 < bJetsInv->size(); ibjet4++){
-			if(ibjet1 == ibjet4 || ibjet2 == ibjet4 || ibjet3 == ibjet4 ) continue;		
-			if(bJetsInv->at(ibjet1)->matchedtoHiggs == true && bJetsInv->at(ibjet2)->matchedtoHiggs == true && bJetsInv->at(ibjet3)->matchedtoHiggs == true && bJetsInv->at(ibjet4)->matchedtoHiggs == true){
-			    diMotherReco(*bJetsInv->at(ibjet1)->getp4(), *bJetsInv->at(ibjet2)->getp4()
-					 , *bJetsInv->at(ibjet3)->getp4(), *bJetsInv->at(ibjet4)->getp4() 
-					 , cHiggsMass, cHiggsMass, _minChi2HHMatched, _bbMassMinHH1Matched, _bbMassMinHH2Matched);
-			} else {
-			    diMotherReco(*bJetsInv->at(ibjet1)->getp4(), *bJetsInv->at(ibjet2)->getp4()
-					 , *bJetsInv->at(ibjet3)->getp4(), *bJetsInv->at(ibjet4)->getp4() 
-					 , cHiggsMass, cHiggsMass, _minChi2HHNotMatched, _bbMassMinHH1NotMatched, _bbMassMinHH2NotMatched);
-			}
-			diMotherReco(*bJetsInv->at(ibjet1)->getp4(), *bJetsInv->at(ibjet2)->getp4()
-				     , *bJetsInv->at(ibjet3)->getp4(), *bJetsInv->at(ibjet4)->getp4() 
-				     , cHiggsMass, cHiggsMass, _minChi2Higgs, _bbMassMin1Higgs, _bbMassMin2Higgs);
-			diMotherReco(*bJetsInv->at(ibjet1)->getp4(), *bJetsInv->at(ibjet2)->getp4()
-				     , *bJetsInv->at(ibjet3)->getp4(), *bJetsInv->at(ibjet4)->getp4()
-				     , cZMass, cZMass, _minChi2Z, _bbMassMin1Z, _bbMassMin2Z);  
-			diMotherReco(*bJetsInv->at(ibjet1)->getp4(), *bJetsInv->at(ibjet2)->getp4() //ZH 
-				     , *bJetsInv->at(ibjet3)->getp4(), *bJetsInv->at(ibjet4)->getp4()
-				     , cHiggsMass, cZMass, _minChi2HiggsZ, _bbMassMin1HiggsZ, _bbMassMin2HiggsZ); 
-		    }
-		}
-	    }
+    // HH & ZZ & ZH reco : 4 medium b jet case, all hypotheses in one pass
+    _pairing.solve();
+    const PairingEngine::result & recoHHMatched    = _pairing.getResult(_hypHHMatched);
+    const PairingEngine::result & recoHHNotMatched = _pairing.getResult(_hypHHNotMatched);
+    const PairingEngine::result & recoHH = _pairing.getResult(_hypHH);
+    const PairingEngine::result & recoZZ = _pairing.getResult(_hypZZ);
+    const PairingEngine::result & recoHZ = _pairing.getResult(_hypHZ);
+    _minChi2HHMatched    = recoHHMatched.chi2;
+    _bbMassMinHH1Matched = recoHHMatched.mass1;
+    _bbMassMinHH2Matched = recoHHMatched.mass2;
+    _minChi2HHNotMatched    = recoHHNotMatched.chi2;
+    _bbMassMinHH1NotMatched = recoHHNotMatched.mass1;
+    _bbMassMinHH2NotMatched = recoHHNotMatched.mass2;
+    if(recoHH.pair1 >= 0){
+	_minChi2Higgs    = recoHH.chi2;
+	_bbMassMin1Higgs = recoHH.mass1;
+	_bbMassMin2Higgs = recoHH.mass2;
+	_bpTHiggs1       = recoHH.pt1;
+	_bpTHiggs2       = recoHH.pt2;
+    }
+    if(recoZZ.pair1 >= 0){
+	_minChi2Z    = recoZZ.chi2;
+	_bbMassMin1Z = recoZZ.mass1;
+	_bbMassMin2Z = recoZZ.mass2;
+    }
+    if(recoHZ.pair1 >= 0){
+	_minChi2HiggsZ    = recoHZ.chi2;
+	_bbMassMin1HiggsZ = recoHZ.mass1;
+	_bbMassMin2HiggsZ = recoHZ.mass2;
+    }
+
+    hybridHiggsReco(thisEvent);
+
+    // HH + W reco (cut["recoHHW"]): branch and bound over the (up to 12) leading jets
+    if(cut["recoHHW"] == 1){
+	_minChi2HHW = cLargeValue;
+	_invMassHHW_W = -1;
+	if(_recoHHW.reconstruct(jetsInv) > 0){
+	    _minChi2HHW   = _recoHHW.getBest().front().chi2;
+	    _invMassHHW_W = _recoHHW.getBest().front().mass[2];
 	}
-	// HH & ZZ reco : 3 medium + 1 loose b jet case
     }
     ////else if(thisEvent->getnbJet() == 3 && thisEvent->getnbLooseJet() > 3){
     ////    for( int ibjet1 = 0; ibjet1 < lbJetsInv->size(); ibjet1++){
@@ -756,7 +857,50 @@ void ttHHanalyzer::process(event* thisEvent, sysName sysType, bool up){
     if(!selectObjects(thisEvent))  return;
     analyze(thisEvent);
     fillHistos(thisEvent);
-    fillTree(thisEvent);
+    if(_variation == 0){
+	_passSelection = true;
+	fillTree(thisEvent);
+    }
+}
+
+// Features of the event for the cut grid scan: number of jets, of b jets and
+// HT for every jet pT threshold and b-tag working point, from the selected
+// jets (pT > cut["jetPt"]).
+void ttHHanalyzer::scanCuts(event * thisEvent){
+    double features[3];
+    for(unsigned i = 0; i < _scanJetPt.size(); i++){
+	int nJets = 0;
+	float HT = 0;
+	for(const auto jet : *thisEvent->getSelJets()){
+	    float pt = jet->getp4()->Pt();
+	    if(pt <= _scanJetPt[i]) continue;
+	    nJets++;
+	    HT += pt;
+	}
+	for(unsigned j = 0; j < _scanbTagWP.size(); j++){
+	    int nbJets = 0;
+	    for(const auto jet : *thisEvent->getSelJets()){
+		if(jet->getp4()->Pt() > _scanJetPt[i] && jet->bTagCSV > _scanbTagWP[j]) nbJets++;
+	    }
+	    features[0] = nJets;
+	    features[1] = nbJets;
+	    features[2] = HT;
+	    _scan.fill(_scan.outerIndex({int(i), int(j)}), features, _weight);
+	}
+    }
+}
+
+// Cutflow counts the nominal only.
+void ttHHanalyzer::countCut(const std::string & name){
+    if(_variation != 0) return;
+    cutflow[name]+=1;
+    hCutFlow->Fill(name.c_str(),1);
+    hCutFlow_w->Fill(name.c_str(),_weight);
+    if(_nReplicas > 0){
+	const float bin = std::distance(cutflow.begin(), cutflow.find(name));
+	_cutflowBootstrap.fill(0, bin, 1, &_replicaWeights[0]);
+	_cutflowBootstrap.fill(1, bin, _weight, &_replicaWeights[0]);
+    }
 }
 
 
@@ -789,797 +933,44 @@ void ttHHanalyzer::fillHistos(event * thisEvent){
 
     //    std::cout << "Number of Hadronic Higgs: " << thisEvent->getnHadronicHiggs() << std::endl;
 
-    hjetNumber->Fill(thisEvent->getnSelJet(),_weight*thisEvent->getbTagSys());
-    hHadronicHiggsNumber->Fill(thisEvent->getnHadronicHiggs(),_weight*thisEvent->getbTagSys());
-    hBjetNumber->Fill(thisEvent->getnbJet(),_weight*thisEvent->getbTagSys());
-    hLightJetNumber->Fill(thisEvent->getnLightJet(),_weight*thisEvent->getbTagSys());
-
-    hjetAverageMass->Fill(thisEvent->getSumSelJetMass()/(float)thisEvent->getnSelJet(),_weight*thisEvent->getbTagSys());
-    hHadronicHiggsAverageMass->Fill(thisEvent->getSumSelHadronicHiggsMass()/(float)thisEvent->getnHadronicHiggs(),_weight*thisEvent->getbTagSys());
-    hBjetAverageMass->Fill(thisEvent->getSumSelbJetMass()/(float)thisEvent->getnbJet(),_weight*thisEvent->getbTagSys());
-    hLightJetAverageMass->Fill(thisEvent->getSumSelLightJetMass()/(float)thisEvent->getnLightJet(),_weight*thisEvent->getbTagSys());
-    hBjetAverageMassSqr->Fill((thisEvent->getSumSelbJetMass()*thisEvent->getSumSelbJetMass())/(float)thisEvent->getnbJet(), _weight*thisEvent->getbTagSys());
-
-    if(thisEvent->getnHadronicHiggs() > 0){ 
-	hHadronicHiggsSoftDropMass1->Fill(thisEvent->getSelHadronicHiggses()->at(0)->softDropMass,_weight*thisEvent->getbTagSys());
+    _histos.fill(thisEvent, _weight*thisEvent->getbTagSys(), _variation);
+    // weight-only variations: same event, other weight
+    for(unsigned v = 1; v < _variations.size() && _variation == 0; v++){
+	if(_variations[v].sys == kbTag) _histos.fill(thisEvent, _weight*getVariationWeight(thisEvent, v), v);
     }
-
-    if(thisEvent->getnHadronicHiggs() > 1){ 
-	hHadronicHiggsSoftDropMass2->Fill(thisEvent->getSelHadronicHiggses()->at(1)->softDropMass,_weight*thisEvent->getbTagSys());
-    }
-
-
-    hjetHT->Fill(thisEvent->getSumSelJetScalarpT(),_weight*thisEvent->getbTagSys());
-    hBjetHT->Fill(thisEvent->getSumSelbJetScalarpT(),_weight*thisEvent->getbTagSys());
-    hHadronicHiggsHT->Fill(thisEvent->getSumSelHadronicHiggsScalarpT(),_weight*thisEvent->getbTagSys());
-    hLightJetHT->Fill(thisEvent->getSumSelLightJetScalarpT(),_weight*thisEvent->getbTagSys());
-    hAvgDeltaRjj->Fill(jetStat.meandR,_weight*thisEvent->getbTagSys());
-    hAvgDeltaEtajj->Fill(jetStat.meandEta,_weight*thisEvent->getbTagSys());
-    hminDeltaRjj->Fill(jetStat.mindR,_weight*thisEvent->getbTagSys());
-    hminDeltaRMassjj->Fill(jetStat.mindRMass,_weight*thisEvent->getbTagSys());
-    hminDeltaRpTjj->Fill(jetStat.mindRpT,_weight*thisEvent->getbTagSys());
-    hAvgDeltaRbb->Fill(bjetStat.meandR,_weight*thisEvent->getbTagSys());
-    hAvgDeltaRbj->Fill(bjStat.meandR,_weight*thisEvent->getbTagSys());
-    hAvgDeltaEtabj->Fill(bjStat.meandEta,_weight*thisEvent->getbTagSys());
-    hminDeltaRbj->Fill(bjStat.mindR,_weight*thisEvent->getbTagSys());
-    hminDeltaRMassbj->Fill(bjStat.mindRMass,_weight*thisEvent->getbTagSys());
-    hminDeltaRpTbj->Fill(bjStat.mindRpT,_weight*thisEvent->getbTagSys());    
-    hAvgDeltaEtabb->Fill(bjetStat.meandEta,_weight*thisEvent->getbTagSys());
-    hminDeltaRbb->Fill(bjetStat.mindR,_weight*thisEvent->getbTagSys());
-    hminDeltaRMassbb->Fill(bjetStat.mindRMass,_weight*thisEvent->getbTagSys());
-    hminDeltaRpTbb->Fill(bjetStat.mindRpT,_weight*thisEvent->getbTagSys());
-    hmaxDeltaEtabb->Fill(bjetStat.maxdEta,_weight*thisEvent->getbTagSys());
-    hmaxDeltaEtajj->Fill(jetStat.maxdEta,_weight*thisEvent->getbTagSys());
-    hAvgDeltaEtabj->Fill(bjStat.meandEta,_weight*thisEvent->getbTagSys());
-    hmaxDeltaEtabj->Fill(bjStat.maxdEta,_weight*thisEvent->getbTagSys());
-    hmaxPTmassjbb->Fill(jbbMaxs.maxPTmass, _weight*thisEvent->getbTagSys());
-    hmaxPTmassjjj->Fill(jjjMaxs.maxPTmass, _weight*thisEvent->getbTagSys());
-
-    hInvMassHSingleMatched->Fill(_bbMassMinSHiggsMatched,_weight*thisEvent->getbTagSys());
-    hInvMassHSingleNotMatched->Fill(_bbMassMinSHiggsNotMatched,_weight*thisEvent->getbTagSys());
-    hChi2HiggsSingleMatched->Fill(_minChi2SHiggsMatched,_weight*thisEvent->getbTagSys());
-    hChi2HiggsSingleNotMatched->Fill(_minChi2SHiggsNotMatched,_weight*thisEvent->getbTagSys());
-
-    hInvMassHH1Matched->Fill(_bbMassMinHH1Matched,_weight*thisEvent->getbTagSys());
-    hInvMassHH1NotMatched->Fill(_bbMassMinHH1NotMatched,_weight*thisEvent->getbTagSys());
-    hInvMassHH2Matched->Fill(_bbMassMinHH2Matched,_weight*thisEvent->getbTagSys());
-    hInvMassHH2NotMatched->Fill(_bbMassMinHH2NotMatched,_weight*thisEvent->getbTagSys());
-    hChi2HHMatched->Fill(_minChi2HHMatched,_weight*thisEvent->getbTagSys());
-    hChi2HHNotMatched->Fill(_minChi2HHNotMatched,_weight*thisEvent->getbTagSys());
-
-
-    hInvMassH1->Fill(_bbMassMin1Higgs,_weight*thisEvent->getbTagSys());
-    hInvMassH2->Fill(_bbMassMin2Higgs,_weight*thisEvent->getbTagSys());
-    hInvMassH1_zoomIn->Fill(_bbMassMin1Higgs,_weight*thisEvent->getbTagSys());
-    hInvMassH2_zoomIn->Fill(_bbMassMin2Higgs,_weight*thisEvent->getbTagSys());
-    hPTH1->Fill(_bpTHiggs1,_weight*thisEvent->getbTagSys());
-    hPTH2->Fill(_bpTHiggs2,_weight*thisEvent->getbTagSys());
-    hInvMassZ1->Fill(_bbMassMin1Z,_weight*thisEvent->getbTagSys());
-    hInvMassZ2->Fill(_bbMassMin2Z,_weight*thisEvent->getbTagSys());
-    hInvMassZ1_zoomIn->Fill(_bbMassMin1Z,_weight*thisEvent->getbTagSys());
-    hInvMassZ2_zoomIn->Fill(_bbMassMin2Z,_weight*thisEvent->getbTagSys());
-    hInvMassHZ1->Fill(_bbMassMin1HiggsZ,_weight*thisEvent->getbTagSys());
-    hInvMassHZ2->Fill(_bbMassMin2HiggsZ,_weight*thisEvent->getbTagSys());
-    hInvMassHZ1_zoomIn->Fill(_bbMassMin1HiggsZ,_weight*thisEvent->getbTagSys());
-    hInvMassHZ2_zoomIn->Fill(_bbMassMin2HiggsZ,_weight*thisEvent->getbTagSys());
-
-    if(fabs(_bbMassMin1Higgs-cHiggsMass) < fabs(_bbMassMin2Higgs-cHiggsMass)){
-	hInvMassH1mChi->Fill(_bbMassMin1Higgs,_weight*thisEvent->getbTagSys());
-	hInvMassH2mChi->Fill(_bbMassMin2Higgs,_weight*thisEvent->getbTagSys());
-    } else  {
-	hInvMassH2mChi->Fill(_bbMassMin1Higgs,_weight*thisEvent->getbTagSys());
-	hInvMassH1mChi->Fill(_bbMassMin2Higgs,_weight*thisEvent->getbTagSys());
-    }
-    hChi2Higgs->Fill(_minChi2Higgs,_weight*thisEvent->getbTagSys());
-    hChi2Z->Fill(_minChi2Z,_weight*thisEvent->getbTagSys());
-    hChi2HiggsZ->Fill(_minChi2HiggsZ,_weight*thisEvent->getbTagSys());
-
-    
-    hmet->Fill(thisEvent->getMET()->getp4()->Pt(),_weight*thisEvent->getbTagSys());
-    //    hmetPhi->Fill(thisEvent->getMET()->getp4()->Phi(),_weight*thisEvent->getbTagSys());
-    // hmetEta->Fill(thisEvent->getMET()->getp4()->Eta(),_weight*thisEvent->getbTagSys());
-    
-    hAplanarity->Fill(thisEvent->eventShapeJet->getAplanarity(), _weight*thisEvent->getbTagSys());
-    hSphericity->Fill(thisEvent->eventShapeJet->getSphericity(), _weight*thisEvent->getbTagSys());
-    hTransSphericity->Fill(thisEvent->eventShapeJet->getTransSphericity(), _weight*thisEvent->getbTagSys());
-    hCvalue->Fill(thisEvent->eventShapeJet->getC(), _weight*thisEvent->getbTagSys());
-    hDvalue->Fill(thisEvent->eventShapeJet->getD(), _weight*thisEvent->getbTagSys());
-    hCentralityjb->Fill(jbjetCent.centrality, _weight*thisEvent->getbTagSys());    
-    hCentralityjl->Fill(jlepCent.centrality, _weight*thisEvent->getbTagSys());    
-
-    hH0->Fill(jetFoxWolfMom.h0, _weight*thisEvent->getbTagSys());
-    hH1->Fill(jetFoxWolfMom.h1, _weight*thisEvent->getbTagSys());
-    hH2->Fill(jetFoxWolfMom.h2, _weight*thisEvent->getbTagSys());
-    hH3->Fill(jetFoxWolfMom.h3, _weight*thisEvent->getbTagSys());
-    hH4->Fill(jetFoxWolfMom.h4, _weight*thisEvent->getbTagSys());
-    hR1->Fill(jetFoxWolfMom.r1, _weight*thisEvent->getbTagSys());
-    hR2->Fill(jetFoxWolfMom.r2, _weight*thisEvent->getbTagSys());
-    hR3->Fill(jetFoxWolfMom.r3, _weight*thisEvent->getbTagSys());
-    hR4->Fill(jetFoxWolfMom.r4, _weight*thisEvent->getbTagSys()); 
-
-
-    hBjetH0->Fill(bjetFoxWolfMom.h0, _weight*thisEvent->getbTagSys());
-    hBjetH1->Fill(bjetFoxWolfMom.h1, _weight*thisEvent->getbTagSys());
-    hBjetH2->Fill(bjetFoxWolfMom.h2, _weight*thisEvent->getbTagSys());
-    hBjetH3->Fill(bjetFoxWolfMom.h3, _weight*thisEvent->getbTagSys());
-    hBjetH4->Fill(bjetFoxWolfMom.h4, _weight*thisEvent->getbTagSys());
-    hBjetR1->Fill(bjetFoxWolfMom.r1, _weight*thisEvent->getbTagSys());
-    hBjetR2->Fill(bjetFoxWolfMom.r2, _weight*thisEvent->getbTagSys());
-    hBjetR3->Fill(bjetFoxWolfMom.r3, _weight*thisEvent->getbTagSys());
-    hBjetR4->Fill(bjetFoxWolfMom.r4, _weight*thisEvent->getbTagSys()); 
-
-
-    hBjetAplanarity->Fill(thisEvent->eventShapeBjet->getAplanarity(), _weight*thisEvent->getbTagSys());
-    hBjetSphericity->Fill(thisEvent->eventShapeBjet->getSphericity(), _weight*thisEvent->getbTagSys());
-    hBjetTransSphericity->Fill(thisEvent->eventShapeBjet->getTransSphericity(), _weight*thisEvent->getbTagSys());
-    hBjetCvalue->Fill(thisEvent->eventShapeBjet->getC(), _weight*thisEvent->getbTagSys());
-    hBjetDvalue->Fill(thisEvent->eventShapeBjet->getD(), _weight*thisEvent->getbTagSys());
-
-
-    for(int ih=0; ih < thisEvent->getnSelJet() && ih < nHistsJets; ih++){
-	hjetsPTs.at(ih)->Fill(thisEvent->getSelJets()->at(ih)->getp4()->Pt(),_weight*thisEvent->getbTagSys());
-	hjetsEtas.at(ih)->Fill(thisEvent->getSelJets()->at(ih)->getp4()->Eta(),_weight*thisEvent->getbTagSys());
-	hjetsBTagDisc.at(ih)->Fill(getJetCSV(thisEvent).at(ih),_weight*thisEvent->getbTagSys());
-    }
-
-    for(int ih=0; ih < thisEvent->getnbJet() && ih < nHistsbJets; ih++){
-	hbjetsPTs.at(ih)->Fill(thisEvent->getSelbJets()->at(ih)->getp4()->Pt(),_weight*thisEvent->getbTagSys());
-	hbjetsEtas.at(ih)->Fill(thisEvent->getSelbJets()->at(ih)->getp4()->Eta(),_weight*thisEvent->getbTagSys());
-	hbjetsBTagDisc.at(ih)->Fill(getbJetCSV(thisEvent).at(ih),_weight*thisEvent->getbTagSys());
-    }
-
-
-    for(int ih=0; ih < thisEvent->getnLightJet() && ih < nHistsLightJets; ih++){
-	hLightJetsPTs.at(ih)->Fill(thisEvent->getSelLightJets()->at(ih)->getp4()->Pt(),_weight*thisEvent->getbTagSys());
-	hLightJetsEtas.at(ih)->Fill(thisEvent->getSelLightJets()->at(ih)->getp4()->Eta(),_weight*thisEvent->getbTagSys());
-	hLightJetsBTagDisc.at(ih)->Fill(getlightJetCSV(thisEvent).at(ih),_weight*thisEvent->getbTagSys());
-    }
-
-    /*    hleptonNumber->Fill(thisEvent->getnSelLepton(),_weight*thisEvent->getbTagSys());
-
-
-    if(thisEvent->getnSelMuon() == 2){
-	hDiMuonMass->Fill(thisEvent->getSelMuonsMass(),_weight*thisEvent->getbTagSys());
-	hDiMuonPT->Fill(thisEvent->getSelMuonsPT(),_weight*thisEvent->getbTagSys());
-	hDiMuonEta->Fill(thisEvent->getSelMuonsEta(),_weight*thisEvent->getbTagSys());
-    }
-
-    if(thisEvent->getnSelElectron() == 2){
-	hDiElectronMass->Fill(thisEvent->getSelElectronsMass(),_weight*thisEvent->getbTagSys());
-	hDiElectronPT->Fill(thisEvent->getSelElectronsPT(),_weight*thisEvent->getbTagSys());
-	hDiElectronEta->Fill(thisEvent->getSelElectronsEta(),_weight*thisEvent->getbTagSys());
-    }
-
-    hleptonHT->Fill(thisEvent->getSelLeptonHT(),_weight*thisEvent->getbTagSys());
-    hST->Fill(thisEvent->getSelLeptonST(),_weight*thisEvent->getbTagSys());
-    hLeptonPT1->Fill(thisEvent->getSelLeptons()->at(0)->getp4()->Pt(), _weight*thisEvent->getbTagSys());
-    hLeptonEta1->Fill(thisEvent->getSelLeptons()->at(0)->getp4()->Eta(), _weight*thisEvent->getbTagSys());
-    hLeptonPT2->Fill(thisEvent->getSelLeptons()->at(1)->getp4()->Pt(), _weight*thisEvent->getbTagSys());
-    hLeptonEta2->Fill(thisEvent->getSelLeptons()->at(1)->getp4()->Eta(), _weight*thisEvent->getbTagSys());
-
-
-    if(thisEvent->getnSelMuon() > 0){
-	hMuonPT1->Fill(thisEvent->getSelMuons()->at(0)->getp4()->Pt(), _weight*thisEvent->getbTagSys());
-	hMuonEta1->Fill(thisEvent->getSelMuons()->at(0)->getp4()->Eta(), _weight*thisEvent->getbTagSys());
-    }
-    
-    if(thisEvent->getnSelElectron() > 0){
-	hElePT1->Fill(thisEvent->getSelElectrons()->at(0)->getp4()->Pt(), _weight*thisEvent->getbTagSys());
-	hEleEta1->Fill(thisEvent->getSelElectrons()->at(0)->getp4()->Eta(), _weight*thisEvent->getbTagSys());
-    }
-    
-    if(thisEvent->getnSelMuon() > 1){
-	hMuonPT2->Fill(thisEvent->getSelMuons()->at(1)->getp4()->Pt(), _weight*thisEvent->getbTagSys());
-	hMuonEta2->Fill(thisEvent->getSelMuons()->at(1)->getp4()->Eta(), _weight*thisEvent->getbTagSys());
-    }
-    
-    if(thisEvent->getnSelElectron() > 1){
-	hElePT2->Fill(thisEvent->getSelElectrons()->at(1)->getp4()->Pt(), _weight*thisEvent->getbTagSys());
-	hEleEta2->Fill(thisEvent->getSelElectrons()->at(1)->getp4()->Eta(), _weight*thisEvent->getbTagSys());
-    } 
-
-    hLepCharge1->Fill(thisEvent->getSelLeptons()->at(0)->charge, _weight*thisEvent->getbTagSys());
-    hLepCharge2->Fill(thisEvent->getSelLeptons()->at(1)->charge, _weight*thisEvent->getbTagSys());
-    */
 }
 
 
 
 void ttHHanalyzer::writeHistos(){
     _of->file->cd();
-    _histoDirs.at(0)->cd();
-    for(int ih=0; ih<nHistsJets; ih++){
-	hjetsPTs.at(ih)->Write();
-	hjetsEtas.at(ih)->Write();
-	hjetsBTagDisc.at(ih)->Write();
-    }
-    for(int ih=0; ih<nHistsbJets; ih++){
-	hbjetsPTs.at(ih)->Write();
-	hbjetsEtas.at(ih)->Write();
-	hbjetsBTagDisc.at(ih)->Write();
-    }
-
-    for(int ih=0; ih<nHistsLightJets; ih++){
-	hLightJetsPTs.at(ih)->Write();
-	hLightJetsEtas.at(ih)->Write();
-	hLightJetsBTagDisc.at(ih)->Write();
-    }
-
-    hInvMassHadW->Write();
-
-    hInvMassHSingleMatched->Write();
-    hInvMassHSingleNotMatched->Write();
-    hChi2HiggsSingleNotMatched->Write();
-    hChi2HiggsSingleMatched->Write();
-    hInvMassHH1Matched->Write();
-    hInvMassHH1NotMatched->Write();
-    hInvMassHH2Matched->Write();
-    hInvMassHH2NotMatched->Write();
-    hChi2HHNotMatched->Write();
-    hChi2HHMatched->Write();
-
-    hjetNumber->Write();
-    hBjetNumber->Write();
-    hHadronicHiggsNumber->Write();
-    hLightJetNumber->Write();
-    hjetAverageMass->Write();
-    hBjetAverageMass->Write();
-    hHadronicHiggsAverageMass->Write();
-    hLightJetAverageMass->Write();
-    hBjetAverageMassSqr->Write();
-    hHadronicHiggsSoftDropMass1->Write();
-    hHadronicHiggsSoftDropMass2->Write();
-    hjetHT->Write();
-    hBjetHT->Write();
-    hHadronicHiggsHT->Write();
-    hLightJetHT->Write();
-    hAvgDeltaRjj->Write();
-    hminDeltaRjj->Write();
-    hminDeltaRMassjj->Write();
-    hminDeltaRpTjj->Write();
-    hAvgDeltaRbb->Write();
-    hAvgDeltaEtajj->Write();
-    hAvgDeltaEtabb->Write();
-    hminDeltaRbb->Write();
-    hminDeltaRMassbb->Write();
-    hminDeltaRpTbb->Write();
-    hmaxDeltaEtabb->Write();
-    hmaxDeltaEtajj->Write();
-    hAvgDeltaRbj->Write();
-    hAvgDeltaEtabj->Write();
-    hminDeltaRbj->Write();
-    hminDeltaRMassbj->Write();
-    hminDeltaRpTbj->Write();
-    hmaxDeltaEtabj->Write();
-    hmaxPTmassjbb->Write();
-    hmaxPTmassjjj->Write();
-
-    hPTH1->Write();
-    hPTH2->Write();
-    hInvMassH1->Write();
-    hInvMassH2->Write();
-    hInvMassH1_zoomIn->Write();
-    hInvMassH2_zoomIn->Write();
-    hInvMassH1mChi->Write();
-    hInvMassH2mChi->Write();
-    hInvMassHZ1->Write();
-    hInvMassHZ2->Write();
-    hInvMassHZ1_zoomIn->Write();
-    hInvMassHZ2_zoomIn->Write();
-    hInvMassZ1->Write();
-    hInvMassZ2->Write();
-    hInvMassZ1_zoomIn->Write();
-    hInvMassZ2_zoomIn->Write();
-    hChi2Higgs->Write();
-    hChi2HiggsZ->Write();
-    hChi2Z->Write();
-
-
-    hmet->Write();
-    // hmetPhi->Write();
-    // hmetEta->Write();
-
-    hAplanarity->Write();
-    hSphericity->Write();
-    hTransSphericity->Write();
-    hCvalue->Write();
-    hDvalue->Write();
-    hCentralityjb->Write();
-    hCentralityjl->Write();
-
-    hH0->Write();
-    hH1->Write();
-    hH2->Write();
-    hH3->Write();
-    hH4->Write();
-    hR1->Write();
-    hR2->Write();
-    hR3->Write();
-    hR4->Write(); 
-
-    hBjetH0->Write();
-    hBjetH1->Write();
-    hBjetH2->Write();
-    hBjetH3->Write();
-    hBjetH4->Write();
-    hBjetR1->Write();
-    hBjetR2->Write();
-    hBjetR3->Write();
-    hBjetR4->Write(); 
-
-    hBjetAplanarity->Write();
-    hBjetSphericity->Write();
-    hBjetTransSphericity->Write();
-    hBjetCvalue->Write();
-    hBjetDvalue->Write();
-
-    _histoDirs.at(1)->cd();
-    
-    /*    hLepCharge1->Write();
-    hLepCharge2->Write();
-
-    hleptonNumber->Write();
-    hDiMuonMass->Write();
-    hDiElectronMass->Write();
-    hDiMuonPT->Write();
-    hDiElectronPT->Write();
-    hDiMuonEta->Write();
-    hDiElectronEta->Write();
-    hleptonHT->Write();
-    hST->Write();
-    hLeptonEta1->Write();
-    hLeptonPT1->Write();
-    hLeptonEta2->Write();
-    hLeptonPT2->Write();
-    
-    hMuonEta1->Write();
-    hMuonPT1->Write();
-    hEleEta1->Write();
-    hElePT1->Write();
-    hMuonEta2->Write();
-    hMuonPT2->Write();
-    hEleEta2->Write();
-    hElePT2->Write(); */
+    for(unsigned v = 0; v < _variations.size(); v++) _histos.write(_histoDirs[v], v);
 }
 void ttHHanalyzer::fillTree(event * thisEvent){
-
-////////////////////////////////////////////////////////////////////////////////////////
-    // For Trigger Path
-    passTrigger_HLT_IsoMu27 = _ev->HLT_IsoMu27; // Reference Muon Trigger
-    passTrigger_HLT_PFHT1050 = _ev->HLT_PFHT1050;
-    //passTrigger_HLT_PFHT450_SixPFJet36_PFBTagDeepCSV_1p59 = _ev->HLT_PFHT450_SixPFJet36_PFBTagDeepCSV_1p59;
-    //passTrigger_HLT_PFHT400_SixPFJet32_DoublePFBTagDeepCSV_2p94 = _ev->HLT_PFHT400_SixPFJet32_DoublePFBTagDeepCSV_2p94;
-    //passTrigger_HLT_PFHT330PT30_QuadPFJet_75_60_45_40_TriplePFBTagDeepCSV_4p5 = _ev->HLT_PFHT330PT30_QuadPFJet_75_60_45_40_TriplePFBTagDeepCSV_4p5;
-    passTrigger_6J1T_B    = _ev->HLT_PFHT430_SixJet40_BTagCSV_p080;
-    passTrigger_6J1T_CDEF = _ev->HLT_PFHT430_SixPFJet40_PFBTagCSV_1p5;
-    passTrigger_6J2T_B    = _ev->HLT_PFHT380_SixJet32_DoubleBTagCSV_p075;
-    passTrigger_6J2T_CDEF = _ev->HLT_PFHT380_SixPFJet32_DoublePFBTagCSV_2p2;
-    passTrigger_4J3T_B    = _ev->HLT_HT300PT30_QuadJet_75_60_45_40_TripeCSV_p07;
-    passTrigger_4J3T_CDEF = _ev->HLT_PFHT300PT30_QuadPFJet_75_60_45_40_TriplePFBTagCSV_3p0;
-
-    nMuons = thisEvent->getnSelMuon();
-    nJets = thisEvent->getnSelJet();
-    nbJets = thisEvent->getnbJet();
-    HT = thisEvent->getSumSelJetScalarpT();
-
-    // Fill the jet information [ It will fill the nJets && maximum 30th jets ]
-    for (int i = 0; i < nJets && i < 30; ++i) {
-        jetPt[i] = thisEvent->getSelJets()->at(i)->getp4()->Pt();
-        jetEta[i] = thisEvent->getSelJets()->at(i)->getp4()->Eta();
-        bTagScore[i] = thisEvent->getSelJets()->at(i)->bTagCSV;
-    } 
-    for (int i = nJets; i < 30; ++i) {
-        jetPt[i] = -999;
-        jetEta[i] = -999;
-        bTagScore[i] = -999;
-    }
-
-    eventNumber = _ev->event;
-    runNumber = _ev->run;
-
-////////////////////////////////////////////////////////////////////////////////////////
-   
-    bjetPT1 = thisEvent->getSelJets()->at(0)->getp4()->Pt();
-    bjetPT2 = thisEvent->getSelJets()->at(1)->getp4()->Pt();
-    bjetPT3 = thisEvent->getSelJets()->at(2)->getp4()->Pt();
-    bjetPT4 = thisEvent->getSelJets()->at(3)->getp4()->Pt();
-    bjetEta1 = thisEvent->getSelJets()->at(0)->getp4()->Eta();
-    bjetEta2 = thisEvent->getSelJets()->at(1)->getp4()->Eta();
-    bjetEta3 = thisEvent->getSelJets()->at(2)->getp4()->Eta();
-    bjetEta4 = thisEvent->getSelJets()->at(3)->getp4()->Eta();
-    bjetBTagDisc1 = getJetCSV(thisEvent).at(0);
-    bjetBTagDisc2 = getJetCSV(thisEvent).at(1);
-    bjetBTagDisc3 = getJetCSV(thisEvent).at(2);
-    bjetBTagDisc4 = getJetCSV(thisEvent).at(3);
-
-
-    bbjetPT1 = thisEvent->getSelbJets()->at(0)->getp4()->Pt();
-    bbjetPT2 = thisEvent->getSelbJets()->at(1)->getp4()->Pt();
-    bbjetPT3 = thisEvent->getSelbJets()->at(2)->getp4()->Pt();
-    bbjetEta1 = thisEvent->getSelbJets()->at(0)->getp4()->Eta();
-    bbjetEta2 = thisEvent->getSelbJets()->at(1)->getp4()->Eta();
-    bbjetEta3 = thisEvent->getSelbJets()->at(2)->getp4()->Eta();
-    bbjetPhi1 = thisEvent->getSelbJets()->at(0)->getp4()->Phi();
-    bbjetPhi2 = thisEvent->getSelbJets()->at(1)->getp4()->Phi();
-    bbjetPhi3 = thisEvent->getSelbJets()->at(2)->getp4()->Phi();
-    bbjetBTagDisc1 = getbJetCSV(thisEvent).at(0);
-    bbjetBTagDisc2 = getbJetCSV(thisEvent).at(1);
-    bbjetBTagDisc3 = getbJetCSV(thisEvent).at(2);
-    bbjetHiggsMatched1 = thisEvent->getSelbJets()->at(0)->matchedtoHiggs;
-    bbjetHiggsMatched2 = thisEvent->getSelbJets()->at(1)->matchedtoHiggs;
-    bbjetHiggsMatched3 = thisEvent->getSelbJets()->at(2)->matchedtoHiggs;
-    bbjetHiggsMatcheddR1 = thisEvent->getSelbJets()->at(0)->matchedtoHiggsdR;
-    bbjetHiggsMatcheddR2 = thisEvent->getSelbJets()->at(1)->matchedtoHiggsdR;
-    bbjetHiggsMatcheddR3 = thisEvent->getSelbJets()->at(2)->matchedtoHiggsdR;
-    bbjetMinChiHiggsIndex1 = thisEvent->getSelbJets()->at(0)->minChiHiggsIndex;
-    bbjetMinChiHiggsIndex2 = thisEvent->getSelbJets()->at(1)->minChiHiggsIndex;
-    bbjetMinChiHiggsIndex3 = thisEvent->getSelbJets()->at(2)->minChiHiggsIndex;
-
-
-    if(thisEvent->getnSelJet() > 4){
-    	bjetPT5 = thisEvent->getSelJets()->at(4)->getp4()->Pt();
-	bjetEta5 = thisEvent->getSelJets()->at(4)->getp4()->Eta();
-	bjetBTagDisc5 = getJetCSV(thisEvent).at(4);
-    } else{
-	bjetPT5 = -6;
-	bjetEta5 = -6;
-	bjetBTagDisc5 = -6;
-    }
-    
-    if(thisEvent->getnSelJet() > 5){
-	bjetPT6 = thisEvent->getSelJets()->at(5)->getp4()->Pt();
-	bjetEta6 = thisEvent->getSelJets()->at(5)->getp4()->Eta();
-	bjetBTagDisc6 = getJetCSV(thisEvent).at(5);
-    } else{
-	bjetPT6 = -6;
-	bjetEta6 = -6;
-	bjetBTagDisc6 = -6;
-    }
-
-
-    if(thisEvent->getnSelJet() > 6){
-	bjetPT7 = thisEvent->getSelJets()->at(6)->getp4()->Pt();
-	bjetEta7 = thisEvent->getSelJets()->at(6)->getp4()->Eta();
-	bjetBTagDisc7 = getJetCSV(thisEvent).at(6);
-    } else{
-	bjetPT7 = -6;
-	bjetEta7 = -6;
-	bjetBTagDisc7 = -6;
-    }
-
-    if(thisEvent->getnSelJet() > 7){
-	bjetPT8 = thisEvent->getSelJets()->at(7)->getp4()->Pt();
-	bjetEta8 = thisEvent->getSelJets()->at(7)->getp4()->Eta();
-	bjetBTagDisc8 = getJetCSV(thisEvent).at(7);
-    } else{
-	bjetPT8 = -6;
-	bjetEta8 = -6;
-	bjetBTagDisc8 = -6;
-    }
-
-    if(thisEvent->getnSelJet() > 8){
-	bjetPT9 = thisEvent->getSelJets()->at(8)->getp4()->Pt();
-	bjetEta9 = thisEvent->getSelJets()->at(8)->getp4()->Eta();
-	bjetBTagDisc9 = getJetCSV(thisEvent).at(8);
-    } else{
-	bjetPT9 = -6;
-	bjetEta9 = -6;
-	bjetBTagDisc9 = -6;
-    }
-
-    if(thisEvent->getnSelJet() > 9){
-	bjetPT10 = thisEvent->getSelJets()->at(9)->getp4()->Pt();
-	bjetEta10 = thisEvent->getSelJets()->at(9)->getp4()->Eta();
-	bjetBTagDisc10 = getJetCSV(thisEvent).at(9);
-    } else{
-	bjetPT10 = -6;
-	bjetEta10 = -6;
-	bjetBTagDisc10 = -6;
-    }
-
-    if(thisEvent->getnSelJet() > 10){
-	bjetPT11 = thisEvent->getSelJets()->at(10)->getp4()->Pt();
-	bjetEta11 = thisEvent->getSelJets()->at(10)->getp4()->Eta();
-	bjetBTagDisc11 = getJetCSV(thisEvent).at(10);
-    } else{
-	bjetPT11 = -6;
-	bjetEta11 = -6;
-	bjetBTagDisc11 = -6;
-    }
-
-    if(thisEvent->getnSelJet() > 11){
-	bjetPT12 = thisEvent->getSelJets()->at(11)->getp4()->Pt();
-	bjetEta12 = thisEvent->getSelJets()->at(11)->getp4()->Eta();
-	bjetBTagDisc12 = getJetCSV(thisEvent).at(11);
-    } else{
-	bjetPT12 = -6;
-	bjetEta12 = -6;
-	bjetBTagDisc12 = -6;
-    }
-
-    // # b-jet
-    if(thisEvent->getnbJet() > 3){
-	bbjetPT4 = thisEvent->getSelbJets()->at(3)->getp4()->Pt();
-	bbjetEta4 = thisEvent->getSelbJets()->at(3)->getp4()->Eta();
-	bbjetPhi4 = thisEvent->getSelbJets()->at(3)->getp4()->Phi();
-	bbjetBTagDisc4 = getbJetCSV(thisEvent).at(3);
-	bbjetHiggsMatched4 = thisEvent->getSelbJets()->at(3)->matchedtoHiggs;
-	bbjetHiggsMatcheddR4 = thisEvent->getSelbJets()->at(3)->matchedtoHiggsdR;
-	bbjetMinChiHiggsIndex4 = thisEvent->getSelbJets()->at(3)->minChiHiggsIndex;
-    } else {
-	bbjetPT4 = -6;
-	bbjetEta4 = -6;
-	bbjetPhi4 = -6;
-	bbjetBTagDisc4 = -6;
-	bbjetHiggsMatched4 = 0;
-	bbjetHiggsMatcheddR4 = -6;
-	bbjetMinChiHiggsIndex4 = -6;
-    }
-    
-    if(thisEvent->getnbJet() > 4){
-	bbjetPT5 = thisEvent->getSelbJets()->at(4)->getp4()->Pt();
-	bbjetEta5 = thisEvent->getSelbJets()->at(4)->getp4()->Eta();
-	bbjetPhi5 = thisEvent->getSelbJets()->at(4)->getp4()->Phi();
-	bbjetBTagDisc5 = getbJetCSV(thisEvent).at(4);
-	bbjetHiggsMatched5 = thisEvent->getSelbJets()->at(4)->matchedtoHiggs;
-	bbjetHiggsMatcheddR5 = thisEvent->getSelbJets()->at(4)->matchedtoHiggsdR;
-	bbjetMinChiHiggsIndex5 = thisEvent->getSelbJets()->at(4)->minChiHiggsIndex;
-    } else {
-	bbjetPT5 = -6;
-	bbjetEta5 = -6;
-	bbjetPhi5 = -6;
-	bbjetBTagDisc5 = -6;
-	bbjetHiggsMatched5 = 0;
-	bbjetHiggsMatcheddR5 = -6;
-	bbjetMinChiHiggsIndex5 = -6;
-    }
-
-    if(thisEvent->getnbJet() > 5){
-	bbjetPT6 = thisEvent->getSelbJets()->at(5)->getp4()->Pt();
-	bbjetEta6 = thisEvent->getSelbJets()->at(5)->getp4()->Eta();
-	bbjetPhi6 = thisEvent->getSelbJets()->at(5)->getp4()->Phi();
-	bbjetBTagDisc6 = getbJetCSV(thisEvent).at(5);
-	bbjetHiggsMatched6 = thisEvent->getSelbJets()->at(5)->matchedtoHiggs;
-	bbjetHiggsMatcheddR6 = thisEvent->getSelbJets()->at(5)->matchedtoHiggsdR;
-	bbjetMinChiHiggsIndex6 = thisEvent->getSelbJets()->at(5)->minChiHiggsIndex;
-    } else {
-	bbjetPT6 = -6;
-	bbjetEta6 = -6;
-	bbjetPhi6 = -6;
-	bbjetBTagDisc6 = -6;
-	bbjetHiggsMatched6 = 0;
-	bbjetHiggsMatcheddR6 = -6;
-	bbjetMinChiHiggsIndex6 = -6;
-    }
-
-    if(thisEvent->getnbJet() > 6){
-	bbjetPT7 = thisEvent->getSelbJets()->at(6)->getp4()->Pt();
-	bbjetEta7 = thisEvent->getSelbJets()->at(6)->getp4()->Eta();
-	bbjetPhi7 = thisEvent->getSelbJets()->at(6)->getp4()->Phi();
-	bbjetBTagDisc7 = getbJetCSV(thisEvent).at(6);
-	bbjetHiggsMatched7 = thisEvent->getSelbJets()->at(6)->matchedtoHiggs;
-	bbjetHiggsMatcheddR7 = thisEvent->getSelbJets()->at(6)->matchedtoHiggsdR;
-    } else {
-	bbjetPT7 = -6;
-	bbjetEta7 = -6;
-	bbjetPhi7 = -6;
-	bbjetBTagDisc7 = -6;
-	bbjetHiggsMatched7 = 0;
-	bbjetHiggsMatcheddR7 = -6;
-    }
-
-
-    if(thisEvent->getnbJet() > 7){
-	bbjetPT8 = thisEvent->getSelbJets()->at(7)->getp4()->Pt();
-	bbjetEta8 = thisEvent->getSelbJets()->at(7)->getp4()->Eta();
-	bbjetPhi8 = thisEvent->getSelbJets()->at(7)->getp4()->Phi();
-	bbjetBTagDisc8 = getbJetCSV(thisEvent).at(7);
-	bbjetHiggsMatched8 = thisEvent->getSelbJets()->at(7)->matchedtoHiggs;
-	bbjetHiggsMatcheddR8 = thisEvent->getSelbJets()->at(7)->matchedtoHiggsdR;
-    } else {
-	bbjetPT8 = -6;
-	bbjetEta8 = -6;
-	bbjetPhi8 = -6;
-	bbjetBTagDisc8 = -6;
-	bbjetHiggsMatched8 = 0;
-	bbjetHiggsMatcheddR8 = 0;
-    }
-
-
-    if(thisEvent->getnLightJet() > 0){
-    	blightjetPT1 = thisEvent->getSelLightJets()->at(0)->getp4()->Pt();
-	blightjetEta1 = thisEvent->getSelLightJets()->at(0)->getp4()->Eta();
-	blightjetBTagDisc1 = getlightJetCSV(thisEvent).at(0);
-    } else{
-	blightjetPT1 = -6;
-	blightjetEta1 = -6;
-	blightjetBTagDisc1 = -6;
-    }
-
-    if(thisEvent->getnLightJet() > 1){
-    	blightjetPT2 = thisEvent->getSelLightJets()->at(1)->getp4()->Pt();
-	blightjetEta2 = thisEvent->getSelLightJets()->at(1)->getp4()->Eta();
-	blightjetBTagDisc2 = getlightJetCSV(thisEvent).at(1);
-    } else{
-	blightjetPT2 = -6;
-	blightjetEta2 = -6;
-	blightjetBTagDisc2 = -6;
-    }
-
-    if(thisEvent->getnLightJet() > 2){
-    	blightjetPT3 = thisEvent->getSelLightJets()->at(2)->getp4()->Pt();
-	blightjetEta3 = thisEvent->getSelLightJets()->at(2)->getp4()->Eta();
-	blightjetBTagDisc3 = getlightJetCSV(thisEvent).at(2);
-    } else{
-	blightjetPT3 = -6;
-	blightjetEta3 = -6;
-	blightjetBTagDisc3 = -6;
-    }
-
-    if(thisEvent->getnLightJet() > 3){
-    	blightjetPT4 = thisEvent->getSelLightJets()->at(3)->getp4()->Pt();
-	blightjetEta4 = thisEvent->getSelLightJets()->at(3)->getp4()->Eta();
-	blightjetBTagDisc4 = getlightJetCSV(thisEvent).at(3);
-    } else{
-	blightjetPT4 = -6;
-	blightjetEta4 = -6;
-	blightjetBTagDisc4 = -6;
-    }
-
-    if(thisEvent->getnLightJet() > 4){
-    	blightjetPT5 = thisEvent->getSelLightJets()->at(4)->getp4()->Pt();
-	blightjetEta5 = thisEvent->getSelLightJets()->at(4)->getp4()->Eta();
-	blightjetBTagDisc5 = getlightJetCSV(thisEvent).at(4);
-    } else{
-	blightjetPT5 = -6;
-	blightjetEta5 = -6;
-	blightjetBTagDisc5 = -6;
-    }
-
-    if(thisEvent->getnLightJet() > 5){
-    	blightjetPT6 = thisEvent->getSelLightJets()->at(5)->getp4()->Pt();
-	blightjetEta6 = thisEvent->getSelLightJets()->at(5)->getp4()->Eta();
-	blightjetBTagDisc6 = getlightJetCSV(thisEvent).at(5);
-    } else{
-	blightjetPT6 = -6;
-	blightjetEta6 = -6;
-	blightjetBTagDisc6 = -6;
-    }
-
-
-    bweight= _weight;
-    bjetAverageMass = thisEvent->getSumSelJetMass()/thisEvent->getnSelJet();
-    bbJetAverageMass = thisEvent->getSumSelbJetMass()/thisEvent->getnbJet();
-    blightJetAverageMass = thisEvent->getSumSelLightJetMass()/thisEvent->getnLightJet();
-    bbJetAverageMassSqr = (thisEvent->getSumSelbJetMass()*thisEvent->getSumSelbJetMass())/thisEvent->getnbJet();
-    bmet = thisEvent->getMET()->getp4()->Pt();
-    baverageDeltaRjj = jetStat.meandR;
-    baverageDeltaRbb = bjetStat.meandR;
-    baverageDeltaRbj = bjStat.meandR;
-    baverageDeltaEtajj = jetStat.meandEta;
-    baverageDeltaEtabb = bjetStat.meandEta;
-    baverageDeltaEtabj = bjStat.meandEta;
-    bminDeltaRjj = jetStat.mindR;
-    bminDeltaRbb = bjetStat.mindR;
-    bminDeltaRbj = bjStat.mindR;
-    bmaxDeltaEtabb = bjetStat.maxdEta;
-    bmaxDeltaEtajj = jetStat.maxdEta;
-    bmaxDeltaEtabj = bjStat.maxdEta;
-    bminDeltaRMassjj = jetStat.mindRMass;
-    bminDeltaRMassbb = bjetStat.mindRMass;
-    bminDeltaRMassbj = bjStat.mindRMass;
-    bminDeltaRpTjj = jetStat.mindRpT;
-    bminDeltaRpTbb = bjetStat.mindRpT;
-    bminDeltaRpTbj = bjStat.mindRpT;
-    bmaxPTmassjjj = jjjMaxs.maxPTmass;
-    bmaxPTmassjbb = jbbMaxs.maxPTmass;
-    bH0 = jetFoxWolfMom.h0;
-    bH1 = jetFoxWolfMom.h1;
-    bH2 = jetFoxWolfMom.h2;
-    bH3 = jetFoxWolfMom.h3;
-    bH4 = jetFoxWolfMom.h4;
-    bbH0 = bjetFoxWolfMom.h0;
-    bbH1 = bjetFoxWolfMom.h1;
-    bbH2 = bjetFoxWolfMom.h2;
-    bbH3 = bjetFoxWolfMom.h3;
-    bbH4 = bjetFoxWolfMom.h4;
-    bR1 = jetFoxWolfMom.r1;
-    bR2 = jetFoxWolfMom.r2;
-    bR3 = jetFoxWolfMom.r3;
-    bR4 = jetFoxWolfMom.r4;
-    bbR1 = bjetFoxWolfMom.r1;
-    bbR2 = bjetFoxWolfMom.r2;
-    bbR3 = bjetFoxWolfMom.r3;
-    bbR4 = bjetFoxWolfMom.r4;
-
-    bjetHT = thisEvent->getSumSelJetScalarpT();  
-    bbjetHT = thisEvent->getSumSelbJetScalarpT();
-    blightjetHT = thisEvent->getSumSelLightJetScalarpT();
-    bjetNumber = thisEvent->getnSelJet();
-    bbjetNumber = thisEvent->getnbJet();
-    blightjetNumber = thisEvent->getnLightJet();
-    binvMassZ1 = _bbMassMin1Z; //ZZ
-    binvMassZ2 = _bbMassMin2Z;
-    bchi2Z = _minChi2Z;
-    binvMassH1 = _bbMassMin1Higgs; //HH
-    binvMassH2 = _bbMassMin2Higgs;
-    bchi2Higgs = _minChi2Higgs;
-    bchi2HiggsZ = _minChi2HiggsZ; //ZH
-    binvMassHiggsZ1 = _bbMassMin1HiggsZ;
-    binvMassHiggsZ2 = _bbMassMin2HiggsZ;
-    bPTH1 = _bpTHiggs1;
-    bPTH2 = _bpTHiggs2;
-
-
-    bcentralityjb = jbjetCent.centrality; 
-    bcentralityjl = jlepCent.centrality; 
-    baplanarity = thisEvent->eventShapeJet->getAplanarity();
-    bsphericity = thisEvent->eventShapeJet->getSphericity();
-    btransSphericity = thisEvent->eventShapeJet->getTransSphericity();
-    bcValue = thisEvent->eventShapeJet->getC();
-    bdValue = thisEvent->eventShapeJet->getD();
-    bbaplanarity = thisEvent->eventShapeBjet->getAplanarity();
-    bbsphericity = thisEvent->eventShapeBjet->getSphericity();
-    bbtransSphericity = thisEvent->eventShapeBjet->getTransSphericity();
-    bbcValue = thisEvent->eventShapeBjet->getC();
-    bbdValue = thisEvent->eventShapeBjet->getD();
-    ////passHadTrig = thisEvent->getHadTriggerAccept();
-
-    /*    bleptonPT1 = thisEvent->getSelLeptons()->at(0)->getp4()->Pt();
-    bleptonPT2 = thisEvent->getSelLeptons()->at(1)->getp4()->Pt();
-    bleptonEta1 = thisEvent->getSelLeptons()->at(0)->getp4()->Eta();
-    bleptonEta2 = thisEvent->getSelLeptons()->at(1)->getp4()->Eta();
-    bleptonCharge1 = thisEvent->getSelLeptons()->at(0)->charge;
-    bleptonCharge2 = thisEvent->getSelLeptons()->at(1)->charge;
-    bleptonHT = thisEvent->getSelLeptonHT();
-    bST = thisEvent->getSelLeptonST();
-
-
-    if(thisEvent->getnSelMuon() > 0){
-	bmuonPT1 = thisEvent->getSelMuons()->at(0)->getp4()->Pt();
-	bmuonEta1 = thisEvent->getSelMuons()->at(0)->getp4()->Eta();
-    } else {
-	bmuonPT1 = -6;
-	bmuonEta1 = -6;
-    }
-
-    if(thisEvent->getnSelMuon() > 1){
-	bmuonPT2 = thisEvent->getSelMuons()->at(1)->getp4()->Pt();
-	bmuonEta2 = thisEvent->getSelMuons()->at(1)->getp4()->Eta();
-	bdiMuonMass = thisEvent->getSelMuonsMass();
-    } else {
-	bmuonPT2 = -6;
-	bmuonEta2 = -6;
-	bdiMuonMass = -6;
-    } 
-
-    if(thisEvent->getnSelElectron() > 0){
-	belePT1 = thisEvent->getSelElectrons()->at(0)->getp4()->Pt();
-	beleEta1 = thisEvent->getSelElectrons()->at(0)->getp4()->Eta();
-    } else {
-	belePT1 = -6;
-	beleEta1 = -6;
-    }
-
-    if(thisEvent->getnSelElectron() > 1){
-	belePT2 = thisEvent->getSelElectrons()->at(1)->getp4()->Pt();
-	beleEta2 = thisEvent->getSelElectrons()->at(1)->getp4()->Eta();
-	bdiElectronMass = thisEvent->getSelElectronsMass();
-    } else {
-	belePT2 = -6;
-	beleEta2 = -6;
-	bdiElectronMass = -6;
-	} */
-
-    
+    if(_treeSchema.empty()) return;
+    // no event: an entry of the friend tree that failed the selection
+    if(thisEvent) _treeSchema.fill(thisEvent);
+    else _treeSchema.clear();
     _inputTree->Fill();
+    if(_columns){
+	_treeSchema.columnValues(&_columnRow[0], _columnObjects);
+	_columns->fill(&_columnRow[0]);
+    }
 }
 
 void ttHHanalyzer::writeTree(){
     _of->file->cd();
     _treeDirs.at(0)->cd();
+    // friendTree 2: lookup by input entry, tree->GetEntryWithIndex(entry)
+    if(_friendTree == 2) _inputTree->BuildIndex("inputEntry");
     _inputTree->Write();
     //    _inputTree->Delete();
+    if(_columns){
+	_columns->close();
+	std::cout << "columnExport: " << _columns->rows() << " rows, " << _columns->columns() << " columns" << std::endl;
+	delete _columns;
+	_columns = nullptr;
+    }
     
 }
 
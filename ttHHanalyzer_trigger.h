@@ -12,6 +12,21 @@
 #include <string>
 #include "EventShape/Class/src/EventShape.cc"
 #include <TLorentzVector.h>
+#include "include/CachedP4.h"
+#include "include/PairingEngine.h"
+#include "include/ResonanceReconstructor.h"
+#include "include/DeltaRIndex.h"
+#include "include/ClosestPair.h"
+#include "include/HistogramRegistry.h"
+#include "include/BootstrapHist.h"
+#include "include/CutGridScan.h"
+#include "include/TreeSchema.h"
+#include "include/ColumnExport.h"
+#include "include/BinnedLookup.h"
+#include "include/JetVariationProvider.h"
+#include "include/BTagEffMap.h"
+#include "include/BTagSFWeights.h"
+#include "include/VariationOverlay.h"
 #include "TRandom3.h"
 #include <unordered_map>
 //#include "thhHypothesisCombinatorics.h"
@@ -26,6 +41,7 @@ const float cLargeValue = 99999999999.;
 const float cEps = 0.000000001; 
 const float cHiggsMass = 125.38;
 const float cZMass = 91.;
+const float cWMass = 80.377;
 
 
 map<std::string, float> cut { 
@@ -46,6 +62,8 @@ map<std::string, float> cut {
     , {"boostedJetPt", 10} // boostedJet pT higher than
     , {"6thJetsPT", 40}
     , {"HT", 500}
+    , {"hadWInvMass", 0} // W candidate: 0 closest sum of b-jet masses, 1 closest light-jet dijet invariant mass
+    , {"recoHHW", 0} // 1: HH+W jet assignment (chi2HHW, invMass_HHW_W), 0 off
     , {"nlJets", 0} // light jet higher than
     , {"hadHiggsPt", 20} // hadronic Higgs pT higher than
     , {"jetEta", 2.4} // jet eta higher than
@@ -57,6 +75,15 @@ map<std::string, float> cut {
     , {"jetID", 6}   // pass tight and tightLepVeto ID
     , {"jetPUid", 4}   // pass loose cut fail tight and medium
     , {"bTagDisc", 0.80}
+    , {"cutScan", 0} // 1: yields over a grid of jet pT, b-tag WP, nJets, nbJets and HT cuts (see initCutScan)
+    , {"binningSketch", 0} // k of the quantile sketches for binning suggestions, 0 off
+    , {"bTagEff", 0} // b-tag efficiency map (MC): 1 build this job's partial map, 2 load the merged map (mergeBTagEff) and fill btag_up/down, 0 off
+    , {"theoryWeights", 0} // 1: LHE scale, PDF and PS weighted copies of the histograms (MC), 0 off
+    , {"bootstrapReplicas", 0} // Poisson bootstrap replicas per histogram and cutflow, 0 off
+    , {"columnExport", 0} // objects per collection in the float32 npy export of the tree, 0 off
+    , {"kinematicVariations", 0} // 1: JES/JER up/down histograms in the same pass (MC), 0 nominal only
+    , {"jetVariations", 0} // JES/JER variations: 0 JES histograms and Gaussian JER smearing, 1 NanoAOD Jet_pt/mass_jesTotal*, _jer* branches
+    , {"friendTree", 0} // 1: tree entry per input entry (passSelection flag), 2: selected entries with inputEntry, 0: normal tree
     , {"trigger", 1} // trigger
     , {"filter", -1} // MET filter
     , {"pv", 0}}; // primary vertex  
@@ -65,10 +92,10 @@ class objectPhysics {
  public:
     enum lFlavor{kNA, kEle, kMuon};
     explicit objectPhysics(const float pT, const float eta, const float phi, const float mass = 0){
-	_p4.SetPtEtaPhiM(pT, eta, phi, mass);
+	_p4.setPtEtaPhiM(pT, eta, phi, mass);
     }
     
-    TLorentzVector * getp4(){
+    const CachedP4 * getp4(){
 	return &_p4;
     }
     objectPhysics(){};
@@ -78,24 +105,33 @@ class objectPhysics {
 	_pzOffset = JES * _p4.Pz();
 	_EOffset  = JES * _p4.E();
 	if(up){
-	    _p4.SetPxPyPzE(_p4.Px()+_pxOffset,_p4.Py()+_pyOffset,_p4.Pz()+_pzOffset, _p4.E()+_EOffset);
+	    _p4.setPxPyPzE(_p4.Px()+_pxOffset,_p4.Py()+_pyOffset,_p4.Pz()+_pzOffset, _p4.E()+_EOffset);
 	} else {
-	    _p4.SetPxPyPzE(_p4.Px()-_pxOffset,_p4.Py()-_pyOffset,_p4.Pz()-_pzOffset, _p4.E()-_EOffset);
+	    _p4.setPxPyPzE(_p4.Px()-_pxOffset,_p4.Py()-_pyOffset,_p4.Pz()-_pzOffset, _p4.E()-_EOffset);
 	}
     }
     std::vector<float> getOffset(){
 	std::vector<float> offset = {_pxOffset,_pyOffset,_pzOffset,_EOffset};
 	return offset;
     }
+    // Replace pT and mass (a varied jet), the change is kept as the offset
+    void vary(float pT, float mass){
+	const CachedP4 varied = CachedP4::fromPtEtaPhiM(pT, _p4.Eta(), _p4.Phi(), mass);
+	_pxOffset = varied.Px() - _p4.Px();
+	_pyOffset = varied.Py() - _p4.Py();
+	_pzOffset = varied.Pz() - _p4.Pz();
+	_EOffset  = varied.E() - _p4.E();
+	_p4 = varied;
+    }
     void subtractp4(const std::vector<float>& offset){
-	_p4.SetPxPyPzE(_p4.Px()-offset[0],_p4.Py()-offset[1],_p4.Pz()-offset[2], _p4.E()-offset[3]);
+	_p4.setPxPyPzE(_p4.Px()-offset[0],_p4.Py()-offset[1],_p4.Pz()-offset[2], _p4.E()-offset[3]);
     }
     void addp4(const std::vector<float>& offset){
-	_p4.SetPxPyPzE(_p4.Px()+offset[0],_p4.Py()+offset[1],_p4.Pz()+offset[2], _p4.E()+offset[3]);
+	_p4.setPxPyPzE(_p4.Px()+offset[0],_p4.Py()+offset[1],_p4.Pz()+offset[2], _p4.E()+offset[3]);
     }
 
  private:
-    TLorentzVector _p4;
+    CachedP4 _p4;
     float _pxOffset = 0., _pyOffset = 0., _pzOffset = 0., _EOffset = 0.;
 };
 
@@ -261,7 +297,7 @@ class event{
 	_sumSelbJetScalarpT+=fabs(jet->getp4()->Pt());  
 	_sumSelbJetMass+=jet->getp4()->M();  
 	_sumSelbJetp4 += *jet->getp4();
-        _selectJetsMass.push_back(jet->getp4()->M());
+        _selectbJetsMass.push_back(jet->getp4()->M());
 	_selectbJets.push_back(jet);
     }
 
@@ -270,6 +306,7 @@ class event{
 	_sumSelLightJetMass+=jet->getp4()->M(); 
 	_sumLightJetp4 += *jet->getp4();
         _selectLightJetsMass.push_back(jet->getp4()->M());
+        _selectLightJetsSoA.add(*jet->getp4());
 	_selectLightJets.push_back(jet);
     }
 
@@ -286,6 +323,29 @@ class event{
 	_MET = met;
     }
 
+    // Start a variation of nominal: the same leptons, boosted jets and
+    // generator objects (shared, not copied; analyze() resets the per-event
+    // fields it sets on them), with the jets and the MET left to be selected
+    // again. The event does not own them: the caller sets the unchanged
+    // nominal jets and its own copies of the changed jets and the MET.
+    void shareUnvaried(const event & nominal){
+	*this = nominal;
+	_MET = nullptr;
+	_jets.clear();
+	_bjets.clear();
+	_selectJets.clear();
+	_selectbJets.clear();
+	_selectLightJets.clear();
+	_selectbJetsMass.clear();
+	_selectLightJetsMass.clear();
+	_selectLightJetsSoA.clear();
+	_loosebJets.clear();
+	_sumJetScalarpT = _sumSelJetScalarpT = _sumSelbJetScalarpT = _sumSelLightJetScalarpT = 0.;
+	_sumSelJetMass = _sumSelbJetMass = _sumSelLightJetMass = 0.;
+	_sumJetp4 = _sumSelJetp4 = _sumSelbJetp4 = _sumLightJetp4 = CachedP4();
+	_bTagSysW = _bTagSysUpW = _bTagSysDownW = 1.;
+    }
+
     void setnVetoLepton(int nVeto){
 	_nVetoLepton = nVeto;
     }
@@ -472,8 +532,8 @@ class event{
 	return &_selectJets;
     }
 
-    std::vector<float> getSelJetsMass(){
-        return _selectJetsMass;
+    const std::vector<float>* getSelbJetsMass(){
+        return &_selectbJetsMass;
     }
 
     std::vector<objectBoostedJet*>* getSelHadronicHiggses(){
@@ -492,8 +552,12 @@ class event{
     	return &_selectLightJets;
     }
 
-    std::vector<float> getSelLightJetsMass(){
-        return _selectLightJetsMass;
+    const std::vector<float>* getSelLightJetsMass(){
+        return &_selectLightJetsMass;
+    }
+
+    const jetSoA* getSelLightJetsSoA(){
+        return &_selectLightJetsSoA;
     }
 
     std::vector<objectJet*>* getLoosebJets(){
@@ -515,19 +579,18 @@ class event{
     // Centrality calculation //
     template <class object1, class object2>
 	void getCentrality(std::vector<object1*>* cont1, std::vector<object2*>* cont2, evShapes& cent) {
-	TLorentzVector obj1P4, obj2P4;
 	float sumPT = 0., sumP = 0., centrality = 0.;
 
 	if(cont1->size()  == 0 || cont2->size() == 0){
 	    ////std::cout << "WTF!!!!" << std::endl;
 	}
 	for(int oindex=0; oindex < cont1->size(); oindex++){
-	    obj1P4 = (*cont1->at(oindex)->getp4());
+	    const CachedP4 & obj1P4 = *cont1->at(oindex)->getp4();
 	    sumPT += obj1P4.Pt();
 	    sumP  += obj1P4.P();
 	}
 	for(int iindex = 0; iindex < cont2->size(); iindex++){
-	    obj2P4 = (*cont2->at(iindex)->getp4());
+	    const CachedP4 & obj2P4 = *cont2->at(iindex)->getp4();
 	    sumPT += obj2P4.Pt();
 	    sumP  += obj2P4.P();
 	}
@@ -541,7 +604,7 @@ class event{
     // Centrality calculation //                                                                                                                                                
     template <class object1, class object2>
 	void getCentralityV2(std::vector<object1*>* cont1, std::vector<object2*>* cont2, evShapes& cent) {
-        TLorentzVector obj1P4, obj2P4, sumP4;
+        CachedP4 sumP4;
         float  centrality = 0.;
 
         int nObject = 0.;
@@ -549,12 +612,10 @@ class event{
 	    ////std::cout << "WTF!!!!" << std::endl;
         }
         for(int oindex=0; oindex < cont1->size(); oindex++){
-            obj1P4 = (*cont1->at(oindex)->getp4());
-            sumP4 += obj1P4;
+            sumP4 += *cont1->at(oindex)->getp4();
         }
         for(int iindex = 0; iindex < cont2->size(); iindex++){
-            obj2P4 = (*cont2->at(iindex)->getp4());
-            sumP4 += obj2P4;
+            sumP4 += *cont2->at(iindex)->getp4();
         }
         centrality = sumP4.Pt()/sumP4.P();
         cent.objectPT = sumP4.Pt();
@@ -566,7 +627,7 @@ class event{
     template <class object1>
 	void getMaxPTSame(std::vector<object1*>* cont1,  maxObjects& xxxMaxs) {
 	float maxPT = 0., maxPTmass = 0., tmpPT = 0., tmpMass;
-	TLorentzVector tmpP4; 
+	CachedP4 tmpP4; 
 	int nObject = 0.;
 	if(cont1->size()  == 0){
 	    ////std::cout << "WTF!!!!" << std::endl;
@@ -595,7 +656,7 @@ class event{
     template <class object1, class object2>
 	void getMaxPTComb(std::vector<object1*>* cont1, std::vector<object2*>* cont2, maxObjects& xyyMaxs) {
 	float maxPT = 0., maxPTmass = 0., tmpPT = 0., tmpMass;
-	TLorentzVector tmpP4; 
+	CachedP4 tmpP4; 
 	int nObject = 0.;
 	if(cont1->size()  == 0 || cont2->size() == 0){
 	    ////std::cout << "WTF!!!!" << std::endl;
@@ -693,7 +754,7 @@ class event{
 
 	for(int oindex = 0; oindex < cont->size()-1; oindex++){
 	    for(int iindex = oindex+1; iindex < cont->size(); iindex++){
-		double costh = cos(cont->at(oindex)->getp4()->Angle(cont->at(iindex)->getp4()->Vect()));
+		double costh = cont->at(oindex)->getp4()->CosTheta(*cont->at(iindex)->getp4());
 		double p0 = 1.0;
 		double p1 = costh;
 		double p2 = 0.5*(3.0*costh*costh - 1.0);
@@ -795,6 +856,20 @@ class event{
 	_bTagSysW = bTagSysWeight;
     }
 
+    // b-tag up/down weights, computed with the nominal objects
+    float getbTagSysUp(){
+	return _bTagSysUpW;
+    }
+
+    float getbTagSysDown(){
+	return _bTagSysDownW;
+    }
+
+    void setbTagSysVariations(float up, float down){
+	_bTagSysUpW = up;
+	_bTagSysDownW = down;
+    }
+
     void setTrigger(bool accept){
 	_trigger = accept;
     }
@@ -848,12 +923,13 @@ class event{
     std::vector<objectLep*>               _muons;
     std::vector<objectLep*>           _electrons; 
     std::vector<objectJet*>          _selectJets;
-    std::vector<float>     _selectJetsMass;
     std::vector<objectJet*>         _selectbJets;
+    std::vector<float>          _selectbJetsMass;
     std::vector<objectBoostedJet*>   _selectHadronicHiggses;
     std::vector<objectBoostedJet*>   _selectBoostedJets;
     std::vector<objectJet*>     _selectLightJets;
     std::vector<float>     _selectLightJetsMass;
+    jetSoA                 _selectLightJetsSoA;
     std::vector<objectJet*>          _loosebJets;
     std::vector<objectLep*>     _selectElectrons; 
     std::vector<objectLep*>         _selectMuons; 
@@ -863,11 +939,11 @@ class event{
     bool _triggerMuon = false, _triggerHad = false;
     int _pv = -1;
 
-    float  _sumJetScalarpT=0., _sumSelJetScalarpT=0., _sumSelbJetScalarpT=0.,_sumSelHadronicHiggsScalarpT=0., _sumSelLightJetScalarpT=0., _sumSelMuonScalarpT=0., _sumSelElectronScalarpT=0., _sumSelJetMass=0., _sumSelbJetMass=0., _sumSelHadronicHiggsMass=0., _sumSelLightJetMass=0., _bTagSysW = 1. , _sumSelHadronicHiggsSoftDropMass=0;
+    float  _sumJetScalarpT=0., _sumSelJetScalarpT=0., _sumSelbJetScalarpT=0.,_sumSelHadronicHiggsScalarpT=0., _sumSelLightJetScalarpT=0., _sumSelMuonScalarpT=0., _sumSelElectronScalarpT=0., _sumSelJetMass=0., _sumSelbJetMass=0., _sumSelHadronicHiggsMass=0., _sumSelLightJetMass=0., _bTagSysW = 1. , _bTagSysUpW = 1., _bTagSysDownW = 1., _sumSelHadronicHiggsSoftDropMass=0;
 
     //    int nJet = 0, nbJet = 0, nSelJet = 0, nSelbJet = 0;
     int _nVetoLepton = 0;
-    TLorentzVector _sumJetp4, _sumSelJetp4, _sumSelbJetp4, _sumHadronicHiggsp4, _sumLightJetp4, _sumSelMuonp4, _sumSelElectronp4; 
+    CachedP4 _sumJetp4, _sumSelJetp4, _sumSelbJetp4, _sumHadronicHiggsp4, _sumLightJetp4, _sumSelMuonp4, _sumSelElectronp4; 
 };
 
 class ttHHanalyzer {
@@ -884,29 +960,31 @@ class ttHHanalyzer {
 	_DataOrMC = DataOrMC;
 	_sampleName = sampleName;
 
+	initbTagEff();
 	initHistograms();	
 	initTree();
 	initSys();
+	initPairing();
+	initCutScan();
        	std::string dummy = "";
 	HypoComb = new tthHypothesisCombinatorics(std::string("data/blrbdtweights_80X_V4/weights_64.xml"), std::string(""));
     }
     void createObjects(event*,sysName,bool);
+    void createVariedObjects(event*,sysName,bool);
+    void buildOverlay(sysName,bool);
+    bool categorizeJet(event*, objectJet*, const eventBuffer::Jet_s &, bool);
+    void setTheoryWeights(int);
     bool selectObjects(event*);
     void analyze(event*);
     void process(event*, sysName, bool);
+    void countCut(const std::string & name);
     void loop(sysName, bool);
     void performAnalysis();
     void fillHistos(event * thisevent);
     void writeHistos();
     void fillTree(event * thisevent);
     void writeTree();
-    TH1F * hmet,* hmetPhi, *hmetEta, *hAvgDeltaRjj, *hAvgDeltaRbb,*hAvgDeltaRbj, *hAvgDeltaEtajj, *hAvgDeltaEtabb, *hAvgDeltaEtabj, *hminDeltaRjj, *hminDeltaRbb, *hminDeltaRbj,  *hminDeltaRpTjj, *hminDeltaRpTbb, *hminDeltaRpTbj, *hminDeltaRMassjj, *hminDeltaRMassbb,*hminDeltaRMassbj, *hmaxDeltaEtajj, *hmaxDeltaEtabb, *hmaxDeltaEtabj, *hmaxPTmassjbb, *hmaxPTmassjjj, *hjetAverageMass, *hBjetAverageMass, *hHadronicHiggsAverageMass, *hLightJetAverageMass, *hBjetAverageMassSqr, *hHadronicHiggsSoftDropMass1, *hHadronicHiggsSoftDropMass2, *hjetHT, *hBjetHT, *hHadronicHiggsHT, *hLightJetHT, *hjetNumber, *hBjetNumber, *hHadronicHiggsNumber, *hLightJetNumber, *hInvMassHadW, *hInvMassZ1, *hInvMassZ2,*hInvMassZ1_zoomIn, *hInvMassZ2_zoomIn, *hInvMassHSingleMatched,*hInvMassHSingleNotMatched ,*hChi2HiggsSingleNotMatched, *hChi2HiggsSingleMatched , *hInvMassH1, *hInvMassH2,*hInvMassH1_zoomIn, *hInvMassH2_zoomIn, *hInvMassHZ1, *hInvMassHZ2, *hInvMassHZ1_zoomIn, *hInvMassHZ2_zoomIn, *hInvMassH1mChi, *hInvMassH2mChi,*hPTH1, *hPTH2, *hChi2Higgs, *hChi2HiggsZ, *hChi2HadW, *hChi2Z, *hAplanarity, *hSphericity, *hTransSphericity, *hCvalue, *hDvalue, *hBjetAplanarity, *hBjetSphericity, *hBjetTransSphericity ,*hBjetCvalue, *hBjetDvalue, *hCentralityjl, *hCentralityjb, *hleptonNumber, *hLeptonPT1, *hMuonPT1, *hElePT1, *hLeptonPhi1, *hMuonPhi1, *hElePhi1, *hLeptonEta1, *hMuonEta1, *hEleEta1, *hLeptonPT2, *hMuonPT2, *hElePT2, *hLeptonPhi2, *hMuonPhi2, *hElePhi2, *hLeptonEta2, *hMuonEta2, *hEleEta2, *hLepCharge1, *hLepCharge2, *hleptonHT, *hST, *hDiMuonMass, *hDiElectronMass, *hDiMuonPT, *hDiElectronPT, *hDiMuonEta, *hDiElectronEta, *hH0, *hH1, *hH2, *hH3, *hH4, *hR1, *hR2, * hR3, *hR4, *hBjetH0, *hBjetH1, *hBjetH2, *hBjetH3, *hBjetH4, *hBjetR1, *hBjetR2, * hBjetR3, *hBjetR4, *hCutFlow, *hCutFlow_w,
-	*hInvMassHH1Matched,
-	*hInvMassHH1NotMatched,
-	*hInvMassHH2Matched,
-        *hInvMassHH2NotMatched,
-        *hChi2HHNotMatched,
-        *hChi2HHMatched;
+    TH1F *hCutFlow, *hCutFlow_w;
 
 
     tthHypothesisCombinatorics * HypoComb; 
@@ -923,14 +1001,29 @@ class ttHHanalyzer {
     bool _sys;
     float _weight;
     std::string _DataOrMC, _runYear, _sampleName; 
-    TH1D * _hJES, * _hbJES, *_hbJetEff, *_hJetEff, *_hSysbTagM ;
+    TH1D * _hJES, * _hbJES, *_hSysbTagM ;
     TString _pathJES = "HL_YR_JEC.root";
+    BinnedLookup _JESTable, _bJESTable; // flat copies of _hJES and _hbJES
+    JetVariationProvider _jetVariations; // cut["jetVariations"] == 1
+    // Nominal objects of the entry, the base of the JES/JER overlays
+    event * _nominalEvent = nullptr;
+    std::vector<objectJet *> _nominalJets; // per entry of eventBuffer::Jet
+    std::vector<char> _nominalJetPass;     // passes the jet selection
+    VariationOverlay _overlay;
+    std::vector<objectJet> _variedJets; // changed jets of the variation being processed, reused
+    objectMET _variedMET;
+    std::vector<float> _jetJES;         // per jet of the current event
+    BinnedLookup _bTagSFUncTable;       // flat copy of _hSysbTagM
+    BTagSFWeights _bTagSF;              // b-tag SF weights of the current event
+    // Placeholder: there is no b-tag SF table in this analyzer, only the SF
+    // uncertainties of _hSysbTagM, so the nominal SF is taken as 1 (as the
+    // original per-jet products did) and the nominal weight is not applied.
+    static constexpr float bTagSFNominal = 1.;
     TString _nameJES = "TOTAL_DIJET_AntiKt4EMTopo_YR2018";
     TString _namebJES = "TOTAL_BJES_AntiKt4EMTopo_YR2018";
     static const int nHistsJets = 12; // ideal # of final state --> 10
     static const int nHistsbJets = 8; // ideal # of final state --> 6
     static const int nHistsLightJets = 6; // ideal # of final state --> 4
-    std::vector<TH1F*> hjetsPTs, hjetsEtas, hbjetsPTs, hbjetsEtas, hLightJetsPTs, hLightJetsEtas, hjetsBTagDisc, hbjetsBTagDisc, hLightJetsBTagDisc;
     event::evShapes jlepCent, jbjetCent;
     event::maxObjects jbbMaxs, jjjMaxs;
     event::statObjects jetStat, bjetStat, bjStat, ljetStat, lbjetStat, genPbjetStat; 
@@ -949,8 +1042,46 @@ class ttHHanalyzer {
     TRandom3 _rand;
 
 
-    void diMotherReco(const TLorentzVector & dPar1p4,const TLorentzVector & dPar2p4,const TLorentzVector & dPar3p4,const TLorentzVector & dPar4p4, const float mother1mass, const float  mother2mass, float & _minChi2,float & _bbMassMin1, float & _bbMassMin2);
-    void motherReco(const TLorentzVector & dPar1p4,const TLorentzVector & dPar2p4, const float mother1mass, float & _minChi2,float & _bbMassMin1);
+    PairingEngine _pairing;
+    int _hypHH, _hypHHMatched, _hypHHNotMatched, _hypZZ, _hypHZ;
+    // HH + hadronic W over all selected jets, resolutions in GeV
+    ResonanceReconstructor<3> _recoHHW{{{ {cHiggsMass, 15., 2}, {cHiggsMass, 15., 2}, {cWMass, 10., 2} }}};
+    float _minChi2HHW = cLargeValue, _invMassHHW_W = -1;
+    DeltaRIndex _bJetIndex, _genPartIndex;
+    std::vector<float> _jetMassScratch;
+    enum hybridCategory { kResolved, kSemiBoosted, kBoosted };
+    int _hybridCategory = kResolved;
+    float _hybridMassH1 = -1, _hybridMassH2 = -1, _hybridChi2 = cLargeValue;
+    std::vector<int> _bJetOverlap;
+    void hybridHiggsReco(event*);
+    // Cut grid scan: after the reference trigger, every event is evaluated
+    // once per (jet pT threshold, b-tag WP) and the nJets, nbJets and HT
+    // cuts ("feature >= value") are scanned with cumulative sums.
+    bool _cutScan = false;
+    CutGridScan _scan;
+    std::vector<double> _scanJetPt, _scanbTagWP;
+    void scanCuts(event*);
+    void initCutScan(){
+	_cutScan = cut["cutScan"] > 0;
+	if(!_cutScan) return;
+	_scanJetPt = {30, 35, 40, 45, 50};
+	_scanbTagWP = {objectJet::valbTagLoose, objectJet::valbTagMedium, objectJet::valbTagTight};
+	_scan.addObjectAxis("jetPt", _scanJetPt);
+	_scan.addObjectAxis("bTagWP", _scanbTagWP);
+	_scan.addCutAxis("nJets", {4, 5, 6, 7, 8});
+	_scan.addCutAxis("nbJets", {2, 3, 4, 5});
+	_scan.addCutAxis("HT", {300, 400, 500, 600, 700, 800});
+	_scan.book();
+    }
+
+    void initPairing(){
+	// mother 1 resolution 0.2, mother 2 resolution 0.02
+	_hypHH           = _pairing.addHypothesis(cHiggsMass, cHiggsMass, 0.2, 0.02);
+	_hypHHMatched    = _pairing.addHypothesis(cHiggsMass, cHiggsMass, 0.2, 0.02, PairingEngine::kAllMatched);
+	_hypHHNotMatched = _pairing.addHypothesis(cHiggsMass, cHiggsMass, 0.2, 0.02, PairingEngine::kNotAllMatched);
+	_hypZZ           = _pairing.addHypothesis(cZMass, cZMass, 0.2, 0.02);
+	_hypHZ           = _pairing.addHypothesis(cHiggsMass, cZMass, 0.2, 0.02);
+    }
 
     /*    std::vector<double> getJetCutFlow(event *thisevent){
 	int jetCounter = 0;
@@ -991,7 +1122,7 @@ class ttHHanalyzer {
 	std::vector<TLorentzVector> jetP4;
 	jetP4.reserve(thisevent->getnSelJet());
         for(const auto thisJet: *thisevent->getSelJets()){
-            jetP4.push_back(*thisJet->getp4());
+            jetP4.push_back(thisJet->getp4()->getTLorentzVector());
 	}
         return jetP4;
     }
@@ -1000,7 +1131,7 @@ class ttHHanalyzer {
 	std::vector<TLorentzVector> lepP4;
 	lepP4.reserve(thisevent->getnSelLepton());
         for(const auto thisLep: *thisevent->getSelLeptons()){
-            lepP4.push_back(*thisLep->getp4());
+            lepP4.push_back(thisLep->getp4()->getTLorentzVector());
 	}
         return lepP4;
     }
@@ -1025,8 +1156,14 @@ class ttHHanalyzer {
 	}*/
 
 
-    float getSysJES(TH1* hSys, float pT){
-	return hSys->GetBinContent(hSys->FindBin(pT));
+    // JES uncertainty of every jet of the event, from the b jet table for
+    // medium b-tagged jets
+    void getSysJES(const std::vector<eventBuffer::Jet_s> & jets, std::vector<float> & shifts){
+	shifts.resize(jets.size());
+	for(unsigned i = 0; i < jets.size(); i++){
+	    const BinnedLookup & table = jets[i].btagDeepFlavB > objectJet::valbTagMedium ? _bJESTable : _JESTable;
+	    shifts[i] = table.value(jets[i].pt);
+	}
     } 
 
     float getSysJER(float sigma){
@@ -1037,55 +1174,175 @@ class ttHHanalyzer {
 	TFile *_fJES = TFile::Open(_pathJES);
 	_hJES = (TH1D*)_fJES->Get(_nameJES);
 	_hbJES = (TH1D*)_fJES->Get(_namebJES);
+	_JESTable = BinnedLookup(_hJES);
+	_bJESTable = BinnedLookup(_hbJES);
 	int npTbin = 9;
 	float sysbTagM[] = {0.01, 0.01, 0.01, 0.01, 0.01, 0.016, 0.018, 0.023, 0.046 };
 	float pTBinEdges[] = { 30, 50, 70, 100, 140, 200, 300, 600, 1000, 3000 };
-	_hbJetEff = new TH1D("bjeteff","bjet efficiency", npTbin, pTBinEdges);
-	_hJetEff = new TH1D("jeteff","jet efficiency", npTbin, pTBinEdges);
 	_hSysbTagM = new TH1D("bTagMSys","btag medium systematics", npTbin, pTBinEdges);
 	int nbinsx = _hSysbTagM->GetXaxis()->GetNbins();
 	for(int bind = 1; bind < nbinsx+1; bind++){
 	    _hSysbTagM->SetBinContent(bind, sysbTagM[bind-1]);
 	}
+	_bTagSFUncTable = BinnedLookup(_hSysbTagM);
+    }
+
+    // b-tag efficiency map of the sample (MC), in two steps: with
+    // cut["bTagEff"] = 1 every job counts its jets into a partial map next to
+    // its output, which mergeBTagEff adds up into the cache file once all
+    // jobs are done; with cut["bTagEff"] = 2 the cache is required and the
+    // b-tag variations are filled. The histogram layout only depends on the
+    // switch, not on which files happen to exist.
+    BTagEffMap _bTagEff;
+    bool _bTagEffBuild = false;
+
+    std::string outputDir(){
+	const size_t slash = _cl.rfind('/');
+	return slash == std::string::npos ? "." : _cl.substr(0, slash);
+    }
+
+    // output file name without directory and extension, unique per job
+    std::string jobName(){
+	const size_t slash = _cl.rfind('/');
+	std::string name = slash == std::string::npos ? _cl : _cl.substr(slash+1);
+	const size_t dot = name.rfind(".root");
+	return dot == std::string::npos ? name : name.substr(0, dot);
+    }
+
+    void initbTagEff(){
+	const int mode = cut["bTagEff"];
+	if(_DataOrMC != "MC" || mode == 0) return;
+	const std::vector<double> ptEdges = { 30, 50, 70, 100, 140, 200, 300, 600, 1000, 3000 };
+	const std::vector<double> etaEdges = { 0, 0.8, 1.6, 2.5 };
+	_bTagEff = BTagEffMap(_sampleName, objectJet::valbTagMedium, ptEdges, etaEdges);
+	if(mode == 1){
+	    _bTagEffBuild = true;
+	    std::cout << "Building the partial b-tag efficiency map " << _bTagEff.partName(outputDir(), jobName())
+		      << ": no b-tag variations in this run, merge the maps of all jobs with mergeBTagEff and rerun with bTagEff = 2" << std::endl;
+	    return;
+	}
+	if(!_bTagEff.read(outputDir()))
+	    error("no b-tag efficiency map " + _bTagEff.fileName(outputDir())
+		  + ", run the jobs with bTagEff = 1 and merge their maps with mergeBTagEff first");
+	_bTagEffReady = true;
+	std::cout << "b-tag efficiency map loaded from " << _bTagEff.fileName(outputDir()) << std::endl;
     }
 
-    void getbJetEffMap(){
-	_hbJetEff->Divide(_hJetEff);
+    // Partial map of this job only: merging is a separate step, so that
+    // concurrent or resubmitted jobs neither race nor count twice.
+    void writebTagEff(){
+	if(!_bTagEffBuild) return;
+	_bTagEff.writePart(outputDir(), jobName());
     }
 
-    std::vector<TDirectory *> _histoDirs; 
+    enum histoDir { kJetDir, kLeptonDir };
+    std::vector<std::vector<TDirectory *> > _histoDirs; // per variation
     std::vector<TDirectory *> _treeDirs; 
+    HistogramRegistry<event> _histos;
+    int _hInvMassHadW;
+    bool _theoryWeights = false;
+    int _lheScaleSet, _lhePdfSet, _psSet;
+    long _nTheoryWeightMismatch = 0; // entries whose number of weights differs from the booking
+    // bootstrap replicas (cut["bootstrapReplicas"]), weights of the current event
+    int _nReplicas = 0;
+    std::vector<unsigned char> _replicaWeights;
+    BootstrapHist _cutflowBootstrap; // 0 counts, 1 weighted
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // Systematic variations, filled in the same pass as the nominal (index 0).
+    // Data only has the nominal. JES/JER (cut["kinematicVariations"]) change
+    // the jets: the objects are rebuilt from the event already in the buffer
+    // and selected again. b-tag only changes the weight: the nominal event is
+    // filled once more with the up/down weight, which needs the b-jet
+    // efficiency map (_bTagEffReady).
+    ////////////////////////////////////////////////////////////////////////////////
+    struct variation {
+	sysName sys;
+	bool up;
+	TString trail;
+    };
+    std::vector<variation> _variations;
+    int _variation = 0; // being processed
+    bool _bTagEffReady = false;
+
+    void initVariations(){
+	_variations.clear();
+	_variations.push_back({noSys, false, ""});
+	if(!_sys || _DataOrMC == "Data") return;
+	if(cut["kinematicVariations"] == 1){
+	    _variations.push_back({kJES, true, "JES_up"});
+	    _variations.push_back({kJES, false, "JES_down"});
+	    _variations.push_back({kJER, true, "JER_up"});
+	    _variations.push_back({kJER, false, "JER_down"});
+	}
+	if(!_bTagEffReady) return;
+	_variations.push_back({kbTag, true, "btag_up"});
+	_variations.push_back({kbTag, false, "btag_down"});
+    }
 
-    void initHistograms(sysName sysType = noSys, bool up = false){
-	hjetsPTs.resize(nHistsJets); hjetsEtas.resize(nHistsJets); hbjetsPTs.resize(nHistsbJets); hbjetsEtas.resize(nHistsbJets); hLightJetsPTs.resize(nHistsLightJets), hLightJetsEtas.resize(nHistsLightJets), hjetsBTagDisc.resize(nHistsJets), hbjetsBTagDisc.resize(nHistsbJets), hLightJetsBTagDisc.resize(nHistsLightJets);
-
+    float getVariationWeight(event * thisEvent, int v){
+	if(_variations[v].sys != kbTag) return thisEvent->getbTagSys();
+	return _variations[v].up ? thisEvent->getbTagSysUp() : thisEvent->getbTagSysDown();
+    }
 
+    void initHistograms(){
 
 	hCutFlow = new TH1F("cutflow", "N_{cutFlow}", cutflow.size(), 0, cutflow.size());
 	hCutFlow_w = new TH1F("cutflow_w", "N_{weighted}", cutflow.size(), 0, cutflow.size());
 
-	TString trail = "";
-	if(sysType == kbTag){
-	    if(up) trail += "btag_up";
-	    else trail += "btag_down";
-	} else if(sysType == kJES){
-	    if(up) trail += "JES_up";
-	    else trail += "JES_down";
-	}else if(sysType == kJER){
-	    if(up) trail += "JER_up";
-	    else trail += "JER_down";
+	initVariations();
+	std::vector<TString> trails;
+	_histoDirs.clear();
+	for(const auto & var : _variations){
+	    _of->file->cd();
+	    std::vector<TDirectory *> tmpDirs; 	
+	    tmpDirs.push_back(_of->file->mkdir("jet"+var.trail));
+	    _of->file->cd();
+	    tmpDirs.push_back(_of->file->mkdir("Lepton"+var.trail));
+	    _histoDirs.push_back(tmpDirs);
+	    trails.push_back(var.trail);
 	}
 
-	_of->file->cd();
-	std::vector<TDirectory *> tmpDirs; 	
-	TDirectory *jet = _of->file->mkdir("jet"+trail);
-	tmpDirs.push_back(jet); 
-	jet->cd();
-
-	hmet = new TH1F("met"+trail, "MET"+trail, 50, 0, 500);
-	hmetPhi = new TH1F("metPhi"+trail, "MET #phi"+trail, 50, -5, 5);
-	hmetEta = new TH1F("metEta"+trail, "MET #eta"+trail, 50, -5, 5);
+	// Histograms with a value are filled once per selected event in fillHistos()
+	// (weight _weight*getbTagSys()), in blocks of 64 events (buffers of all
+	// histograms stay in cache); a value is either an expression of the event or
+	// a variable updated before the fill. Without one, fill by handle.
+	// Each histogram has one copy per variation, written as name+trail.
+	_histos.clear();
+	_histos.setVariations(trails);
+	_histos.setBlockSize(64);
+	// theory uncertainties (MC, cut["theoryWeights"]): the nominal histograms
+	// are also filled with each LHE scale (muR x muF), LHE PDF and parton
+	// shower weight. The number of copies of each set is the number of
+	// weights of the first entry (the PDF set differs between samples).
+	_theoryWeights = _DataOrMC != "Data" && cut["theoryWeights"] == 1;
+	if(_theoryWeights){
+	    if(_ev->size() > 0) _ev->read(0);
+	    _lheScaleSet = _histos.addWeightSet("LHEScaleWeight", std::max<int>(_ev->LHEScaleWeight.size(), 1));
+	    _lhePdfSet = _histos.addWeightSet("LHEPdfWeight", std::max<int>(_ev->LHEPdfWeight.size(), 1));
+	    _psSet = _histos.addWeightSet("PSWeight", std::max<int>(_ev->PSWeight.size(), 1));
+	    std::cout << "Theory weights: " << _ev->LHEScaleWeight.size() << " LHE scale, " << _ev->LHEPdfWeight.size()
+		      << " LHE PDF, " << _ev->PSWeight.size() << " PS weights per event" << std::endl;
+	}
+	// statistical uncertainties of ratios (trigger efficiencies, cut
+	// efficiencies) from the spread over Poisson bootstrap replicas
+	// first pass for data-driven binnings: quantile sketch per histogram
+	if(cut["binningSketch"] > 0) _histos.setSketches(cut["binningSketch"]);
+	_nReplicas = cut["bootstrapReplicas"];
+	if(_nReplicas > 0){
+	    _replicaWeights.assign(_nReplicas, 1);
+	    _histos.setBootstrap(_nReplicas);
+	    _histos.setReplicaWeights(&_replicaWeights[0]);
+	    _cutflowBootstrap.clear();
+	    _cutflowBootstrap.book(cutflow.size(), 0, cutflow.size(), _nReplicas);
+	    _cutflowBootstrap.book(cutflow.size(), 0, cutflow.size(), _nReplicas);
+	}
+	auto book = [&](const TString & name, const TString & title, int nbins, double low, double high,
+			auto value, HistogramRegistry<event>::selectFunc select = nullptr){
+	    return _histos.book(kJetDir, name, title, nbins, low, high, value, select);
+	};
 
+	book("met", "MET", 50, 0, 500, [](event * thisEvent){ return thisEvent->getMET()->getp4()->Pt(); });
 
 	const int nBins = 50;
 	const std::pair<float, float> etaRange = {-3.2, 3.2};
@@ -1095,243 +1352,158 @@ class ttHHanalyzer {
             float MaxJetPtRange = MaxJetPtRanges[std::min(i, 7)]; // Use 7th array element for i >= 7
             // What is above comment meaning?
 	    // if i is bigger or equal to 7, MaxPtRange will be 300.0
-	
-            hjetsPTs.at(i)  = new TH1F(TString::Format("jetPT%d",(i+1))+trail, TString::Format("jet%d p_{T} [GeV]",i+1)+trail, nBins, 0.0, MaxJetPtRange);
-            hjetsEtas.at(i) = new TH1F(TString::Format("jetEta%d",(i+1))+trail, TString::Format("jet%d #eta",i+1)+trail, nBins, etaRange.first, etaRange.second);
+	    auto hasJet = [i](event * thisEvent){ return thisEvent->getnSelJet() > i; };
 
-	    hjetsBTagDisc.at(i)  = new TH1F(TString::Format("jetBTagDisc%d",(i+1))+trail, TString::Format("jet%d btagDisc" ,i+1)+trail, nBins, 0, 1);
+	    book(TString::Format("jetPT%d",(i+1)), TString::Format("jet%d p_{T} [GeV]",i+1), nBins, 0.0, MaxJetPtRange, [i](event * thisEvent){ return thisEvent->getSelJets()->at(i)->getp4()->Pt(); }, hasJet);
+	    book(TString::Format("jetEta%d",(i+1)), TString::Format("jet%d #eta",i+1), nBins, etaRange.first, etaRange.second, [i](event * thisEvent){ return thisEvent->getSelJets()->at(i)->getp4()->Eta(); }, hasJet);
+	    book(TString::Format("jetBTagDisc%d",(i+1)), TString::Format("jet%d btagDisc" ,i+1), nBins, 0, 1, [i](event * thisEvent){ return thisEvent->getSelJets()->at(i)->bTagCSV; }, hasJet);
 	}
 
 	const std::array<float , 8> MaxBJetPtRanges = { 2500.0, 2000.0, 1200.0, 700.0, 400.0, 250.0, 200.0, 100.0 };
 	for(int i=0; i < nHistsbJets; i++){
 
             float MaxBJetPtRange = MaxBJetPtRanges[std::min(i, 7)];
+	    auto hasbJet = [i](event * thisEvent){ return thisEvent->getnbJet() > i; };
 
-            hbjetsPTs.at(i) = new TH1F(TString::Format("bjetPT%d",(i+1))+trail, TString::Format("bjet%d p_{T} [GeV]",i+1)+trail, nBins, 0.0, MaxBJetPtRange);
-            hbjetsEtas.at(i) = new TH1F(TString::Format("bjetEta%d",(i+1))+trail, TString::Format("bjet%d #eta",i+1)+trail, nBins, etaRange.first, etaRange.second);
-	    hbjetsBTagDisc.at(i)  = new TH1F(TString::Format("bjetBTagDisc%d",(i+1))+trail, TString::Format("bjet%d btagDisc" ,i+1)+trail, nBins, 0, 1);
+	    book(TString::Format("bjetPT%d",(i+1)), TString::Format("bjet%d p_{T} [GeV]",i+1), nBins, 0.0, MaxBJetPtRange, [i](event * thisEvent){ return thisEvent->getSelbJets()->at(i)->getp4()->Pt(); }, hasbJet);
+	    book(TString::Format("bjetEta%d",(i+1)), TString::Format("bjet%d #eta",i+1), nBins, etaRange.first, etaRange.second, [i](event * thisEvent){ return thisEvent->getSelbJets()->at(i)->getp4()->Eta(); }, hasbJet);
+	    book(TString::Format("bjetBTagDisc%d",(i+1)), TString::Format("bjet%d btagDisc" ,i+1), nBins, 0, 1, [i](event * thisEvent){ return thisEvent->getSelbJets()->at(i)->bTagCSV; }, hasbJet);
 	}
 
         const std::array<float , 6> MaxLightJetPtRanges = { 2500.0, 1500.0, 800.0, 600.0, 400.0, 250.0 };
 	for(int i=0; i < nHistsLightJets; i++){
 
             float MaxLightJetPtRange = MaxLightJetPtRanges[std::min(i, 5)];
+	    auto hasLightJet = [i](event * thisEvent){ return thisEvent->getnLightJet() > i; };
 
-            hLightJetsPTs.at(i) = new TH1F(TString::Format("lightJetPT%d",(i+1))+trail, TString::Format("lightJet%d p_{T} [GeV]",i+1)+trail, nBins, 0.0, MaxLightJetPtRange);
-            hLightJetsEtas.at(i) = new TH1F(TString::Format("lightJetEta%d",(i+1))+trail, TString::Format("lightJet%d #eta",i+1)+trail, nBins, etaRange.first, etaRange.second);
-	    hLightJetsBTagDisc.at(i)  = new TH1F(TString::Format("lightJetBTagDisc%d",(i+1))+trail, TString::Format("lightJet%d btagDisc" ,i+1)+trail, nBins, 0, 1);
+	    book(TString::Format("lightJetPT%d",(i+1)), TString::Format("lightJet%d p_{T} [GeV]",i+1), nBins, 0.0, MaxLightJetPtRange, [i](event * thisEvent){ return thisEvent->getSelLightJets()->at(i)->getp4()->Pt(); }, hasLightJet);
+	    book(TString::Format("lightJetEta%d",(i+1)), TString::Format("lightJet%d #eta",i+1), nBins, etaRange.first, etaRange.second, [i](event * thisEvent){ return thisEvent->getSelLightJets()->at(i)->getp4()->Eta(); }, hasLightJet);
+	    book(TString::Format("lightJetBTagDisc%d",(i+1)), TString::Format("lightJet%d btagDisc" ,i+1), nBins, 0, 1, [i](event * thisEvent){ return thisEvent->getSelLightJets()->at(i)->bTagCSV; }, hasLightJet);
 	}
-   
-	hAvgDeltaRjj = new TH1F("deltaRavgjj"+trail, "#DeltaR_{jj}^{avg}"+trail, 50, 0, 5);
-	hAvgDeltaRbb = new TH1F("deltaRavgbb"+trail, "#DeltaR_{bb}^{avg}"+trail, 50, 0, 5.5);
-	hAvgDeltaRbj = new TH1F("deltaRavgbj"+trail, "#DeltaR_{bj}^{avg}"+trail, 50, 0, 5.5);
-	hAvgDeltaEtajj = new TH1F("deltaEtaavgjj"+trail, "#Delta#eta_{jj}^{avg}"+trail, 50, 0, 3);
-	hAvgDeltaEtabb = new TH1F("deltaEtaavgbb"+trail, "#Delta#eta_{bb}^{avg}"+trail, 50, 0, 3.5);
-	hAvgDeltaEtabj = new TH1F("deltaEtaavgbj"+trail, "#Delta#eta_{bj}^{avg}"+trail, 50, 0, 3.5);
-	hminDeltaRjj = new TH1F("deltaRminjj"+trail, "#DeltaR_{jj}^{min}"+trail, 50, 0, 2.5);
-	hminDeltaRbb = new TH1F("deltaRminbb"+trail, "#DeltaR_{bb}^{min}"+trail, 50, 0, 4);
-	hminDeltaRbj = new TH1F("deltaRminbj"+trail, "#DeltaR_{bj}^{min}"+trail, 50, 0, 4);
-	hminDeltaRpTjj = new TH1F("pTdeltaRminjj"+trail, "#DeltaR_{jj, p_{T}}^{min}"+trail, 50, 0, 2500);
-	hminDeltaRpTbb = new TH1F("pTdeltaRminbb"+trail, "#DeltaR_{bb, p_{T}}^{min}"+trail, 50, 0, 2500);
-	hminDeltaRpTbj = new TH1F("pTdeltaRminbj"+trail, "#DeltaR_{bj, p_{T}}^{min}"+trail, 50, 0, 5000);
-	hminDeltaRMassjj = new TH1F("massDeltaRminjj"+trail, "#DeltaR_{jj, mass}^{min}"+trail, 50, 0, 1000);
-	hminDeltaRMassbb = new TH1F("massDeltaRminbb"+trail, "#DeltaR_{bb, mass}^{min}"+trail, 50, 0, 2000);
-	hminDeltaRMassbj = new TH1F("massDeltaRminbj"+trail, "#DeltaR_{bj, mass}^{min}"+trail, 50, 0, 800);
-	hmaxDeltaEtabb = new TH1F("deltaEtamaxbb"+trail, "#Delta#eta_{bb}^{max}"+trail, 50, 0, 5);
-	hmaxDeltaEtajj = new TH1F("deltaEtamaxjj"+trail, "#Delta#eta_{jj}^{max}"+trail, 50, 0, 5);
-	hmaxDeltaEtabj = new TH1F("deltaEtamaxbj"+trail, "#Delta#eta_{bj}^{max}"+trail, 50, 0, 5);
-	hmaxPTmassjbb = new TH1F("maxPTmassjbb"+trail, "m_{jbb}^{max p_{T}}"+trail, 50, 0, 5000); 
-	hmaxPTmassjjj = new TH1F("maxPTmassjjj"+trail, "m_{jjj}^{max p_{T}}"+trail, 50, 0, 6000); 
-	hjetAverageMass = new TH1F("jetAvgMass"+trail, "m_{j}^{avg}"+trail, 50, 0, 100);
-	hBjetAverageMass = new TH1F("jetBAvgMass"+trail, "m_{b}^{avg}"+trail, 50, 0, 150);
-	hHadronicHiggsAverageMass = new TH1F("higgsHadAvgMass"+trail, "m_{H_{had}}^{avg}"+trail, 50, 0, 60);
-	hLightJetAverageMass = new TH1F("jetLightAvgMass"+trail, "m_{light}^{avg}"+trail, 50, 0, 100);
-	hBjetAverageMassSqr = new TH1F("jetBAvgMassSqr"+trail, "(m^{2})_{b}^{avg}"+trail, 50, 0, 80000);
-	hHadronicHiggsSoftDropMass1 = new TH1F("higgsHadSoftDropMass1"+trail, "msoftdrop_{H_{had}}"+trail, 50, 0, 400);
-	hHadronicHiggsSoftDropMass2 = new TH1F("higgsHadSoftDropMass2"+trail, "msoftdrop_{H_{had}}"+trail, 50, 0, 300);
-	hjetHT = new TH1F("jetHT"+trail, "H_{T} [GeV]"+trail, 50, 0, 6000);
-	hBjetHT = new TH1F("jetBHT"+trail, "H_{T}^{b} [GeV]"+trail, 50, 0, 4000); 
-	hHadronicHiggsHT = new TH1F("jetHadronicHiggsHT"+trail, "H_{T}^{H_{had}} [GeV]"+trail, 50, 0, 4000); 
-	hLightJetHT = new TH1F("jetLightHT"+trail, "H_{T}^{light} [GeV]"+trail, 50, 0, 3000); 
-	hjetNumber = new TH1F("jetNumber"+trail, "N_{jet}"+trail, 17, 5, 22);
-	hBjetNumber = new TH1F("jetBNumber"+trail, "N_{bjet}"+trail, 15, 3, 18); 
-	hHadronicHiggsNumber = new TH1F("jetHadronicHiggsNumber"+trail, "N_{H_{had}}"+trail, 8, 2, 10); 
-	hLightJetNumber = new TH1F("jetLightNumber"+trail, "N_{lightJet}"+trail, 15, 0, 15); 
-	hInvMassHadW = new TH1F("invMass_hadW"+trail, "m_{W,had}"+trail, 50, 0, 2000);
-	hInvMassZ1 = new TH1F("invMass_Z1"+trail, "m_{Z,1} [GeV]"+trail, 50, 0, 3000);
-	hInvMassZ2 = new TH1F("invMass_Z2"+trail, "m_{Z,2} [GeV]"+trail, 50, 0, 1500);
-        hInvMassZ1_zoomIn = new TH1F("invMass_zoomIn_Z1"+trail, "m_{Z,1} [GeV]"+trail, 100, 0, 500);
-        hInvMassZ2_zoomIn = new TH1F("invMass_zoomIn_Z2"+trail, "m_{Z,2} [GeV]"+trail, 100, 0, 500);
-	hInvMassH1 = new TH1F("invMass_Higgs1"+trail, "m_{H,1} [GeV]"+trail, 50, 0, 3000);
-	hInvMassH2 = new TH1F("invMass_Higgs2"+trail, "m_{H,2} [GeV]"+trail, 50, 0, 1500);
-	hInvMassH1_zoomIn = new TH1F("invMass_zoomIn_Higgs1"+trail, "m_{H,1} [GeV]"+trail, 100, 0, 500);
-	hInvMassH2_zoomIn = new TH1F("invMass_zoomIn_Higgs2"+trail, "m_{H,2} [GeV]"+trail, 100, 0, 500);
-	hInvMassH1mChi = new TH1F("invMass_Higgs1_mChi"+trail, "m_{H,1} min(#chi^{2})"+trail, 50, 0, 400000);
-	hInvMassH2mChi = new TH1F("invMass_Higgs2_mChi"+trail, "m_{H,2} min(#chi^{2})"+trail, 50, 0, 400000);
-
-	hPTH1 = new TH1F("pT_Higgs1"+trail, "p_{T(H,1)} [GeV]"+trail, 50, 0, 2500);
-	hPTH2 = new TH1F("pT_Higgs2"+trail, "p_{T(H,2)} [GeV]"+trail, 50, 0, 2500);
-	hInvMassHZ1 = new TH1F("invMass_HiggsZ1"+trail, "m^{Z}_{H,1} [GeV]"+trail, 50, 0, 3000);
-	hInvMassHZ2 = new TH1F("invMass_HiggsZ2"+trail, "m^{Z}_{H,2} [GeV]"+trail, 50, 0, 1500);
-        hInvMassHZ1_zoomIn = new TH1F("invMass_zoomIn_HiggsZ1"+trail, "m_{Z}_{H,1} [GeV]"+trail, 100, 0, 500);
-        hInvMassHZ2_zoomIn = new TH1F("invMass_zoomIn_HiggsZ2"+trail, "m_{Z}_{H,2} [GeV]"+trail, 100, 0, 500);
-	hChi2Higgs = new TH1F("chi2Higgs"+trail, "#chi^{2}_{HH}"+trail, 50, 0, 400000);
-	hChi2Z = new TH1F("chi2Z"+trail, "#chi^{2}_{ZZ}"+trail, 50, 0, 400000);
-	hChi2HiggsZ = new TH1F("chi2HiggsZ"+trail, "#chi^{2}_{HZ}"+trail, 50, 0, 400000);
-	//hChi2HadW = new TH1F("chi2HadW"+trail, "#chi^{2}_{W,had}"+trail, 50, 0, 400);  
-	hInvMassHSingleMatched = new TH1F("invMass_HiggsMatched"+trail, "m_{H,matched} [GeV]"+trail, 50, 0, 500); 
-        hInvMassHSingleNotMatched  = new TH1F("invMass_HiggsNotMatched"+trail, "m_{H,unmatched} [GeV]"+trail, 50, 0, 500); 
-        hChi2HiggsSingleNotMatched = new TH1F("chi2HiggsNotMatched"+trail, "#chi^{2}_{H,unmatched}"+trail, 50, 0, 10);
-        hChi2HiggsSingleMatched =new TH1F("chi2HiggsMatched"+trail, "#chi^{2}_{H,matched}"+trail, 50, 0, 10);
-
-	hInvMassHH1Matched = new TH1F("invMass_HH1Matched"+trail, "m_{H1,matched} [GeV]"+trail, 50, 0, 500); 
-        hInvMassHH1NotMatched  = new TH1F("invMass_HH1NotMatched"+trail, "m_{H1,unmatched} [GeV]"+trail, 50, 0, 500); 
-	hInvMassHH2Matched = new TH1F("invMass_HH2Matched"+trail, "m_{H2,matched} [GeV]"+trail, 50, 0, 500); 
-        hInvMassHH2NotMatched  = new TH1F("invMass_HH2NotMatched"+trail, "m_{H2,unmatched} [GeV]"+trail, 50, 0, 500); 
-        hChi2HHNotMatched = new TH1F("chi2HHNotMatched"+trail, "#chi^{2}_{H,unmatched}"+trail, 50, 0, 10);
-        hChi2HHMatched =new TH1F("chi2HHMatched"+trail, "#chi^{2}_{H,matched}"+trail, 50, 0, 10);
-
-
-	hAplanarity = new TH1F("aplanarity"+trail, "A"+trail, 50, 0, 0.5);  
-	hSphericity = new TH1F("sphericity"+trail, "S"+trail, 50, 0, 1);  
-	hTransSphericity = new TH1F("transSphericity"+trail, "S_{#perp}"+trail, 50, 0, 1);  
-	hCvalue = new TH1F("C"+trail, "C value"+trail, 50, 0, 1);
-	hDvalue = new TH1F("D"+trail, "D value"+trail, 50, 0, 1); 
-	hCentralityjb = new TH1F("centralityjb"+trail, "centrality_{jb}"+trail, 50, 0, 1); 
-	hCentralityjl = new TH1F("centralityjl"+trail, "centrality_{jl}"+trail, 50, 0, 1); 
-	
-	hH0 = new TH1F("H0"+trail, "H_{0}"+trail, 50, 0.2, 0.45); 
-	hH1 = new TH1F("H1"+trail, "H_{1}"+trail, 50, -0.2, 0.45); 
-	hH2 = new TH1F("H2"+trail, "H_{2}"+trail, 50, -0.2, 0.3); 
-	hH3 = new TH1F("H3"+trail, "H_{3}"+trail, 50, -0.2, 0.3); 
-	hH4 = new TH1F("H4"+trail, "H_{4}"+trail, 50, -0.2, 0.3); 
-
-	hR1 = new TH1F("R1"+trail, "R_{1}"+trail, 50, 0, 1); 
-	hR2 = new TH1F("R2"+trail, "R_{2}"+trail, 50, 0, 1); 
-	hR3 = new TH1F("R3"+trail, "R_{3}"+trail, 50, 0, 1); 
-	hR4 = new TH1F("R4"+trail, "R_{4}"+trail, 50, 0, 1); 
-
-	hBjetH0 = new TH1F("H0_bjet"+trail, "H_{0,bjet}"+trail, 50, -0.2, 0.45); 
-	hBjetH1 = new TH1F("H1_bjet"+trail, "H_{1,bjet}"+trail, 50, -0.2, 0.45); 
-	hBjetH2 = new TH1F("H2_bjet"+trail, "H_{2,bjet}"+trail, 50, -0.2, 0.3); 
-	hBjetH3 = new TH1F("H3_bjet"+trail, "H_{3,bjet}"+trail, 50, -0.2, 0.3); 
-	hBjetH4 = new TH1F("H4_bjet"+trail, "H_{4,bjet}"+trail, 50, -0.2, 0.3); 
-
-	hBjetR1 = new TH1F("R1_bjet"+trail, "R_{1,bjet}"+trail, 50, 0, 1); 
-	hBjetR2 = new TH1F("R2_bjet"+trail, "R_{2,bjet}"+trail, 50, 0, 1); 
-	hBjetR3 = new TH1F("R3_bjet"+trail, "R_{3,bjet}"+trail, 50, 0, 1); 
-	hBjetR4 = new TH1F("R4_bjet"+trail, "R_{4,bjet}"+trail, 50, 0, 1); 
-
-	hBjetAplanarity = new TH1F("aplanarity_bjet"+trail, "A_{bjet}"+trail, 50, 0, 0.5);  
-	hBjetSphericity = new TH1F("sphericity_bjet"+trail, "S_{bjet}"+trail, 50, 0, 1);  
-	hBjetTransSphericity = new TH1F("transSphericity_bjet"+trail, "S_{#perp, bjet}"+trail, 50, 0, 1);  
-	hBjetCvalue = new TH1F("C_bjet"+trail, "C value_{bjet}"+trail, 50, 0, 1);
-	hBjetDvalue = new TH1F("D_bjet"+trail, "D value_{bjet}"+trail, 50, 0, 1); 
-  
-	_of->file->cd();
-	TDirectory *lepton = _of->file->mkdir("Lepton"+trail);
-	tmpDirs.push_back(lepton);
-	lepton->cd();
-
-	hLepCharge1 = new TH1F("lepCharge1"+trail, "lepCh1"+trail, 4, -2, 2);
-	hLepCharge2 = new TH1F("lepCharge2"+trail, "lepCh2"+trail, 4, -2, 2);
-	    
-	hleptonNumber = new TH1F("lepNumber"+trail, "N_{lep}"+trail, 4, 0, 4);
-	hleptonHT = new TH1F("leptonHT"+trail, "H_{T}^{lep} [GeV]"+trail, 50, 0, 2000);
-	hST = new TH1F("ST"+trail, "S_{T} [GeV]"+trail, 50, 0, 2000);
-	hDiMuonMass = new TH1F("diMuonMass"+trail, "m_{#mu#mu} [GeV]"+trail, 50, 0, 200);
-	hDiElectronMass = new TH1F("diEleMass"+trail, "m_{ee} [GeV]"+trail, 50, 0, 200);
-	hDiMuonPT = new TH1F("diMuonPT"+trail, "p_{T, #mu#mu} [GeV]"+trail, 50, 0, 400);
-	hDiElectronPT = new TH1F("diElePT"+trail, "p_{T, ee} [GeV]"+trail, 50, 0, 400);
-	hDiMuonEta = new TH1F("diMuonEta"+trail, "#eta_{#mu#mu}"+trail, 50, -3, 3);
-	hDiElectronEta = new TH1F("diEleEta"+trail, "#eta_{ee}"+trail, 50, -3, 3);
-
-	hLeptonPT1 = new TH1F("leptonPT1"+trail, "lepton p_{T,1}"+trail, 50, 0, 400);
-	hMuonPT1 = new TH1F("muonPT1"+trail, "muon p_{T,1}"+trail, 50, 0, 400);
-	hElePT1 = new TH1F("elePT1"+trail, "ele p_{T,1}"+trail, 50, 0, 400);
-
-	hLeptonPhi1 = new TH1F("leptonPhi1"+trail, "lepton #phi_{1}"+trail, 50, -4, 4);
-	hMuonPhi1 = new TH1F("muonPhi1"+trail, "muon #phi_{1}"+trail, 50, -4, 4);
-	hElePhi1 = new TH1F("elePhi1"+trail, "ele #phi_{1}"+trail, 50, -4, 4);
-
-	hLeptonEta1 = new TH1F("leptonEta1"+trail, "lepton #eta_{1}"+trail, 50, -3, 3);
-	hMuonEta1 = new TH1F("muonEta1"+trail, "muon #eta_{1}"+trail, 50, -3, 3);
-	hEleEta1 = new TH1F("eleEta1"+trail, "ele #eta_{1}"+trail, 50, -3, 3); 
-
-	hLeptonPT2 = new TH1F("leptonPT2"+trail, "lepton p_{T,2}"+trail, 50, 0, 250);
-	hMuonPT2 = new TH1F("muonPT2"+trail, "muon p_{T,2}"+trail, 50, 0, 250);
-	hElePT2 = new TH1F("elePT2"+trail, "ele p_{T,2}"+trail, 50, 0, 250);
-	hLeptonPhi2 = new TH1F("leptonPhi2"+trail, "lepton #phi_{2}"+trail, 50, -4, 4);
-	hMuonPhi2 = new TH1F("muonPhi2"+trail, "muon #phi_{2}"+trail, 50, -4, 4);
-	hElePhi2 = new TH1F("elePhi2"+trail, "ele #phi_{2}"+trail, 50, -4, 4);
-	hLeptonEta2 = new TH1F("leptonEta2"+trail, "lepton #eta_{2}"+trail, 50, -3, 3);
-	hMuonEta2 = new TH1F("muonEta2"+trail, "muon #eta_{2}"+trail, 50, -3, 3);
-	hEleEta2 = new TH1F("eleEta2"+trail, "ele #eta_{2}"+trail, 50, -3, 3); 
-	
-	_histoDirs = tmpDirs;
+
+	book("deltaRavgjj", "#DeltaR_{jj}^{avg}", 50, 0, 5, &jetStat.meandR);
+	book("deltaRavgbb", "#DeltaR_{bb}^{avg}", 50, 0, 5.5, &bjetStat.meandR);
+	book("deltaRavgbj", "#DeltaR_{bj}^{avg}", 50, 0, 5.5, &bjStat.meandR);
+	book("deltaEtaavgjj", "#Delta#eta_{jj}^{avg}", 50, 0, 3, &jetStat.meandEta);
+	book("deltaEtaavgbb", "#Delta#eta_{bb}^{avg}", 50, 0, 3.5, &bjetStat.meandEta);
+	book("deltaEtaavgbj", "#Delta#eta_{bj}^{avg}", 50, 0, 3.5, &bjStat.meandEta);
+	book("deltaRminjj", "#DeltaR_{jj}^{min}", 50, 0, 2.5, &jetStat.mindR);
+	book("deltaRminbb", "#DeltaR_{bb}^{min}", 50, 0, 4, &bjetStat.mindR);
+	book("deltaRminbj", "#DeltaR_{bj}^{min}", 50, 0, 4, &bjStat.mindR);
+	book("pTdeltaRminjj", "#DeltaR_{jj, p_{T}}^{min}", 50, 0, 2500, &jetStat.mindRpT);
+	book("pTdeltaRminbb", "#DeltaR_{bb, p_{T}}^{min}", 50, 0, 2500, &bjetStat.mindRpT);
+	book("pTdeltaRminbj", "#DeltaR_{bj, p_{T}}^{min}", 50, 0, 5000, &bjStat.mindRpT);
+	book("massDeltaRminjj", "#DeltaR_{jj, mass}^{min}", 50, 0, 1000, &jetStat.mindRMass);
+	book("massDeltaRminbb", "#DeltaR_{bb, mass}^{min}", 50, 0, 2000, &bjetStat.mindRMass);
+	book("massDeltaRminbj", "#DeltaR_{bj, mass}^{min}", 50, 0, 800, &bjStat.mindRMass);
+	book("deltaEtamaxbb", "#Delta#eta_{bb}^{max}", 50, 0, 5, &bjetStat.maxdEta);
+	book("deltaEtamaxjj", "#Delta#eta_{jj}^{max}", 50, 0, 5, &jetStat.maxdEta);
+	book("deltaEtamaxbj", "#Delta#eta_{bj}^{max}", 50, 0, 5, &bjStat.maxdEta);
+	book("maxPTmassjbb", "m_{jbb}^{max p_{T}}", 50, 0, 5000, &jbbMaxs.maxPTmass);
+	book("maxPTmassjjj", "m_{jjj}^{max p_{T}}", 50, 0, 6000, &jjjMaxs.maxPTmass);
+	book("jetAvgMass", "m_{j}^{avg}", 50, 0, 100, [](event * thisEvent){ return thisEvent->getSumSelJetMass()/(float)thisEvent->getnSelJet(); });
+	book("jetBAvgMass", "m_{b}^{avg}", 50, 0, 150, [](event * thisEvent){ return thisEvent->getSumSelbJetMass()/(float)thisEvent->getnbJet(); });
+	book("higgsHadAvgMass", "m_{H_{had}}^{avg}", 50, 0, 60, [](event * thisEvent){ return thisEvent->getSumSelHadronicHiggsMass()/(float)thisEvent->getnHadronicHiggs(); });
+	book("jetLightAvgMass", "m_{light}^{avg}", 50, 0, 100, [](event * thisEvent){ return thisEvent->getSumSelLightJetMass()/(float)thisEvent->getnLightJet(); });
+	book("jetBAvgMassSqr", "(m^{2})_{b}^{avg}", 50, 0, 80000, [](event * thisEvent){ return (thisEvent->getSumSelbJetMass()*thisEvent->getSumSelbJetMass())/(float)thisEvent->getnbJet(); });
+	book("higgsHadSoftDropMass1", "msoftdrop_{H_{had}}", 50, 0, 400, [](event * thisEvent){ return thisEvent->getSelHadronicHiggses()->at(0)->softDropMass; },
+	     [](event * thisEvent){ return thisEvent->getnHadronicHiggs() > 0; });
+	book("higgsHadSoftDropMass2", "msoftdrop_{H_{had}}", 50, 0, 300, [](event * thisEvent){ return thisEvent->getSelHadronicHiggses()->at(1)->softDropMass; },
+	     [](event * thisEvent){ return thisEvent->getnHadronicHiggs() > 1; });
+	book("jetHT", "H_{T} [GeV]", 50, 0, 6000, [](event * thisEvent){ return thisEvent->getSumSelJetScalarpT(); });
+	book("jetBHT", "H_{T}^{b} [GeV]", 50, 0, 4000, [](event * thisEvent){ return thisEvent->getSumSelbJetScalarpT(); });
+	book("jetHadronicHiggsHT", "H_{T}^{H_{had}} [GeV]", 50, 0, 4000, [](event * thisEvent){ return thisEvent->getSumSelHadronicHiggsScalarpT(); });
+	book("jetLightHT", "H_{T}^{light} [GeV]", 50, 0, 3000, [](event * thisEvent){ return thisEvent->getSumSelLightJetScalarpT(); });
+	book("jetNumber", "N_{jet}", 17, 5, 22, [](event * thisEvent){ return thisEvent->getnSelJet(); });
+	book("jetBNumber", "N_{bjet}", 15, 3, 18, [](event * thisEvent){ return thisEvent->getnbJet(); });
+	book("jetHadronicHiggsNumber", "N_{H_{had}}", 8, 2, 10, [](event * thisEvent){ return thisEvent->getnHadronicHiggs(); });
+	book("jetLightNumber", "N_{lightJet}", 15, 0, 15, [](event * thisEvent){ return thisEvent->getnLightJet(); });
+	_hInvMassHadW = _histos.book(kJetDir, "invMass_hadW", "m_{W,had}", 50, 0, 2000);
+	book("invMass_Z1", "m_{Z,1} [GeV]", 50, 0, 3000, &_bbMassMin1Z);
+	book("invMass_Z2", "m_{Z,2} [GeV]", 50, 0, 1500, &_bbMassMin2Z);
+	book("invMass_zoomIn_Z1", "m_{Z,1} [GeV]", 100, 0, 500, &_bbMassMin1Z);
+	book("invMass_zoomIn_Z2", "m_{Z,2} [GeV]", 100, 0, 500, &_bbMassMin2Z);
+	book("invMass_Higgs1", "m_{H,1} [GeV]", 50, 0, 3000, &_bbMassMin1Higgs);
+	book("invMass_Higgs2", "m_{H,2} [GeV]", 50, 0, 1500, &_bbMassMin2Higgs);
+	book("invMass_zoomIn_Higgs1", "m_{H,1} [GeV]", 100, 0, 500, &_bbMassMin1Higgs);
+	book("invMass_zoomIn_Higgs2", "m_{H,2} [GeV]", 100, 0, 500, &_bbMassMin2Higgs);
+	book("invMass_Higgs1_mChi", "m_{H,1} min(#chi^{2})", 50, 0, 400000, [this](event *){ return fabs(_bbMassMin1Higgs-cHiggsMass) < fabs(_bbMassMin2Higgs-cHiggsMass) ? _bbMassMin1Higgs : _bbMassMin2Higgs; });
+	book("invMass_Higgs2_mChi", "m_{H,2} min(#chi^{2})", 50, 0, 400000, [this](event *){ return fabs(_bbMassMin1Higgs-cHiggsMass) < fabs(_bbMassMin2Higgs-cHiggsMass) ? _bbMassMin2Higgs : _bbMassMin1Higgs; });
+	book("pT_Higgs1", "p_{T(H,1)} [GeV]", 50, 0, 2500, &_bpTHiggs1);
+	book("pT_Higgs2", "p_{T(H,2)} [GeV]", 50, 0, 2500, &_bpTHiggs2);
+	book("invMass_HiggsZ1", "m^{Z}_{H,1} [GeV]", 50, 0, 3000, &_bbMassMin1HiggsZ);
+	book("invMass_HiggsZ2", "m^{Z}_{H,2} [GeV]", 50, 0, 1500, &_bbMassMin2HiggsZ);
+	book("invMass_zoomIn_HiggsZ1", "m_{Z}_{H,1} [GeV]", 100, 0, 500, &_bbMassMin1HiggsZ);
+	book("invMass_zoomIn_HiggsZ2", "m_{Z}_{H,2} [GeV]", 100, 0, 500, &_bbMassMin2HiggsZ);
+	book("chi2Higgs", "#chi^{2}_{HH}", 50, 0, 400000, &_minChi2Higgs);
+	book("chi2Z", "#chi^{2}_{ZZ}", 50, 0, 400000, &_minChi2Z);
+	book("chi2HiggsZ", "#chi^{2}_{HZ}", 50, 0, 400000, &_minChi2HiggsZ);
+	if(cut["recoHHW"] == 1){
+	    book("chi2HHW", "#chi^{2}_{HHW}", 50, 0, 100, &_minChi2HHW);
+	    book("invMass_HHW_W", "m^{HHW}_{W} [GeV]", 50, 0, 500, &_invMassHHW_W);
+	}
+	book("hybridCategory", "HH category (resolved, semi-boosted, boosted)", 3, -0.5, 2.5, &_hybridCategory);
+	book("invMass_HybridH1", "m^{hybrid}_{H,1} [GeV]", 50, 0, 500, &_hybridMassH1);
+	book("invMass_HybridH2", "m^{hybrid}_{H,2} [GeV]", 50, 0, 500, &_hybridMassH2);
+	book("invMass_HiggsMatched", "m_{H,matched} [GeV]", 50, 0, 500, &_bbMassMinSHiggsMatched);
+	book("invMass_HiggsNotMatched", "m_{H,unmatched} [GeV]", 50, 0, 500, &_bbMassMinSHiggsNotMatched);
+	book("chi2HiggsNotMatched", "#chi^{2}_{H,unmatched}", 50, 0, 10, &_minChi2SHiggsNotMatched);
+	book("chi2HiggsMatched", "#chi^{2}_{H,matched}", 50, 0, 10, &_minChi2SHiggsMatched);
+	book("invMass_HH1Matched", "m_{H1,matched} [GeV]", 50, 0, 500, &_bbMassMinHH1Matched);
+	book("invMass_HH1NotMatched", "m_{H1,unmatched} [GeV]", 50, 0, 500, &_bbMassMinHH1NotMatched);
+	book("invMass_HH2Matched", "m_{H2,matched} [GeV]", 50, 0, 500, &_bbMassMinHH2Matched);
+	book("invMass_HH2NotMatched", "m_{H2,unmatched} [GeV]", 50, 0, 500, &_bbMassMinHH2NotMatched);
+	book("chi2HHNotMatched", "#chi^{2}_{H,unmatched}", 50, 0, 10, &_minChi2HHNotMatched);
+	book("chi2HHMatched", "#chi^{2}_{H,matched}", 50, 0, 10, &_minChi2HHMatched);
+	book("aplanarity", "A", 50, 0, 0.5, [](event * thisEvent){ return thisEvent->eventShapeJet->getAplanarity(); });
+	book("sphericity", "S", 50, 0, 1, [](event * thisEvent){ return thisEvent->eventShapeJet->getSphericity(); });
+	book("transSphericity", "S_{#perp}", 50, 0, 1, [](event * thisEvent){ return thisEvent->eventShapeJet->getTransSphericity(); });
+	book("C", "C value", 50, 0, 1, [](event * thisEvent){ return thisEvent->eventShapeJet->getC(); });
+	book("D", "D value", 50, 0, 1, [](event * thisEvent){ return thisEvent->eventShapeJet->getD(); });
+	book("centralityjb", "centrality_{jb}", 50, 0, 1, &jbjetCent.centrality);
+	book("centralityjl", "centrality_{jl}", 50, 0, 1, &jlepCent.centrality);
+	book("H0", "H_{0}", 50, 0.2, 0.45, &jetFoxWolfMom.h0);
+	book("H1", "H_{1}", 50, -0.2, 0.45, &jetFoxWolfMom.h1);
+	book("H2", "H_{2}", 50, -0.2, 0.3, &jetFoxWolfMom.h2);
+	book("H3", "H_{3}", 50, -0.2, 0.3, &jetFoxWolfMom.h3);
+	book("H4", "H_{4}", 50, -0.2, 0.3, &jetFoxWolfMom.h4);
+	book("R1", "R_{1}", 50, 0, 1, &jetFoxWolfMom.r1);
+	book("R2", "R_{2}", 50, 0, 1, &jetFoxWolfMom.r2);
+	book("R3", "R_{3}", 50, 0, 1, &jetFoxWolfMom.r3);
+	book("R4", "R_{4}", 50, 0, 1, &jetFoxWolfMom.r4);
+	book("H0_bjet", "H_{0,bjet}", 50, -0.2, 0.45, &bjetFoxWolfMom.h0);
+	book("H1_bjet", "H_{1,bjet}", 50, -0.2, 0.45, &bjetFoxWolfMom.h1);
+	book("H2_bjet", "H_{2,bjet}", 50, -0.2, 0.3, &bjetFoxWolfMom.h2);
+	book("H3_bjet", "H_{3,bjet}", 50, -0.2, 0.3, &bjetFoxWolfMom.h3);
+	book("H4_bjet", "H_{4,bjet}", 50, -0.2, 0.3, &bjetFoxWolfMom.h4);
+	book("R1_bjet", "R_{1,bjet}", 50, 0, 1, &bjetFoxWolfMom.r1);
+	book("R2_bjet", "R_{2,bjet}", 50, 0, 1, &bjetFoxWolfMom.r2);
+	book("R3_bjet", "R_{3,bjet}", 50, 0, 1, &bjetFoxWolfMom.r3);
+	book("R4_bjet", "R_{4,bjet}", 50, 0, 1, &bjetFoxWolfMom.r4);
+	book("aplanarity_bjet", "A_{bjet}", 50, 0, 0.5, [](event * thisEvent){ return thisEvent->eventShapeBjet->getAplanarity(); });
+	book("sphericity_bjet", "S_{bjet}", 50, 0, 1, [](event * thisEvent){ return thisEvent->eventShapeBjet->getSphericity(); });
+	book("transSphericity_bjet", "S_{#perp, bjet}", 50, 0, 1, [](event * thisEvent){ return thisEvent->eventShapeBjet->getTransSphericity(); });
+	book("C_bjet", "C value_{bjet}", 50, 0, 1, [](event * thisEvent){ return thisEvent->eventShapeBjet->getC(); });
+	book("D_bjet", "D value_{bjet}", 50, 0, 1, [](event * thisEvent){ return thisEvent->eventShapeBjet->getD(); });
     }
 
     
     TTree * _inputTree;
-    float bjetPT1, bjetPT2, bjetPT3, bjetPT4, bjetPT5, bjetPT6, bjetPT7, bjetPT8, bjetPT9, bjetPT10, bjetPT11, bjetPT12;
-    float bbjetPT1, bbjetPT2, bbjetPT3, bbjetPT4, bbjetPT5, bbjetPT6, bbjetPT7, bbjetPT8;
-    float bjetEta1, bjetEta2, bjetEta3, bjetEta4, bjetEta5, bjetEta6, bjetEta7, bjetEta8, bjetEta9, bjetEta10, bjetEta11, bjetEta12;
-    float bbjetEta1, bbjetEta2, bbjetEta3, bbjetEta4, bbjetEta5, bbjetEta6, bbjetEta7, bbjetEta8;
-    float bbjetPhi1, bbjetPhi2, bbjetPhi3, bbjetPhi4, bbjetPhi5, bbjetPhi6, bbjetPhi7, bbjetPhi8;
-    float blightjetPT1, blightjetPT2, blightjetPT3, blightjetPT4, blightjetPT5, blightjetPT6;
-    float blightjetEta1, blightjetEta2, blightjetEta3, blightjetEta4, blightjetEta5, blightjetEta6;
-    float bjetBTagDisc1, bjetBTagDisc2, bjetBTagDisc3, bjetBTagDisc4, bjetBTagDisc5, bjetBTagDisc6, bjetBTagDisc7, bjetBTagDisc8, bjetBTagDisc9, bjetBTagDisc10, bjetBTagDisc11, bjetBTagDisc12; 
-    
-    float bbjetBTagDisc1,bbjetBTagDisc2, bbjetBTagDisc3, bbjetBTagDisc4, bbjetBTagDisc5, bbjetBTagDisc6, bbjetBTagDisc7, bbjetBTagDisc8;
-    float blightjetBTagDisc1, blightjetBTagDisc2, blightjetBTagDisc3, blightjetBTagDisc4, blightjetBTagDisc5, blightjetBTagDisc6;
-    float bmet, bmetPhi, bmetEta;
-    float baverageDeltaRjj, baverageDeltaRbb, baverageDeltaEtajj, baverageDeltaEtabb, bminDeltaRjj, bminDeltaRbb, bmaxDeltaEtajj, bmaxDeltaEtabb;
-    float bjetAverageMass, bbJetAverageMass, blightJetAverageMass, bbJetAverageMassSqr;
-    float bjetHT, bbjetHT, blightjetHT;
-    float binvMassHadW, binvMassZ1, binvMassZ2, binvMassH1, binvMassH2, bchi2Higgs, bchi2HiggsZ, bchi2HadW, bchi2Z, binvMassHiggsZ1, binvMassHiggsZ2;
-    float bPTH1, bPTH2, bweight;
-    float baplanarity, bsphericity, btransSphericity, bcValue, bdValue, bbaplanarity, bcentralityjb, bcentralityjl, bbsphericity, bbtransSphericity, bbcValue, bbdValue;
-    float bleptonEta1, bmuonEta1, beleEta1, bleptonPT1, bmuonPT1, belePT1, bleptonEta2, bmuonEta2, beleEta2, bleptonPT2, bmuonPT2, belePT2;
-    float bdiElectronMass, bdiMuonMass, bleptonHT, bST, bleptonCharge1, bleptonCharge2;
-    float bH0, bH1, bH2, bH3, bH4, bbH0, bbH1, bbH2, bbH3, bbH4;
-    float bR1, bR2, bR3, bR4, bbR1, bbR2, bbR3, bbR4;
-    float bmaxPTmassjbb, bmaxPTmassjjj, bminDeltaRpTbb, bminDeltaRpTjj, bminDeltaRpTbj, bminDeltaRMassjj, bminDeltaRMassbj, bminDeltaRMassbb, baverageDeltaRbj,  baverageDeltaEtabj, bminDeltaRbj, bmaxDeltaEtabj;
-    float bbjetHiggsMatched1, bbjetHiggsMatched2, bbjetHiggsMatched3, bbjetHiggsMatched4, bbjetHiggsMatched5, bbjetHiggsMatched6,  bbjetHiggsMatched7, bbjetHiggsMatched8;
-    float bbjetHiggsMatcheddR1, bbjetHiggsMatcheddR2, bbjetHiggsMatcheddR3, bbjetHiggsMatcheddR4, bbjetHiggsMatcheddR5, bbjetHiggsMatcheddR6,  bbjetHiggsMatcheddR7,  bbjetHiggsMatcheddR8; 
-    float bbjetMinChiHiggsIndex1, bbjetMinChiHiggsIndex2, bbjetMinChiHiggsIndex3, bbjetMinChiHiggsIndex4, bbjetMinChiHiggsIndex5, bbjetMinChiHiggsIndex6, bbjetMinChiHiggsIndex7, bbjetMinChiHiggsIndex8;
- 
+    TreeSchema<event> _treeSchema;
+    // friend tree mode (cut["friendTree"]): only derived branches, keyed to
+    // the entry number in the input chain. In mode 1 an entry that failed
+    // the selection is written cleared (TreeSchema::clear: zeros, no
+    // objects) with passSelection false, the only way to tell it apart.
+    int _friendTree = 0;
+    bool _passSelection = false;
+    Long64_t _inputEntry = 0;
+    // per b jet min chi2 Higgs partner, only needed for bJet_minChiHiggsIndex
+    bool _treeMinChiHiggs = true;
+    // npy columns next to the output file (cut["columnExport"])
+    ColumnExporter * _columns = nullptr;
+    int _columnObjects = 0;
+    std::vector<float> _columnRow;
 
-////////////////////////////////////////////////////////////////////////////////////////    
-    // Variables for Trigger Path                                                        
-    ////bool passHadTrig;                                                               
-    bool passTrigger_HLT_IsoMu27; // Reference Muon Trigger to Calculate efficiency & SFs
-    bool passTrigger_HLT_PFHT1050;                                                      
-    //bool passTrigger_HLT_PFHT450_SixPFJet36_PFBTagDeepCSV_1p59;                          
-    //bool passTrigger_HLT_PFHT400_SixPFJet32_DoublePFBTagDeepCSV_2p94;                   
-    //bool passTrigger_HLT_PFHT330PT30_QuadPFJet_75_60_45_40_TriplePFBTagDeepCSV_4p5;     
-    bool passTrigger_6J1T_B;
-    bool passTrigger_6J1T_CDEF;
-    bool passTrigger_6J2T_B;
-    bool passTrigger_6J2T_CDEF;
-    bool passTrigger_4J3T_B;
-    bool passTrigger_4J3T_CDEF;
-
-    int nMuons;                                                                          
-    int nElecs;
-    int nJets;                                                                          
-    int nbJets;                                                                         
-    float HT;                                                                           
-    float jetPt[30];                                                                    
-    float jetEta[30];                                                                   
-    float bTagScore[30];                                                                
-
-    unsigned int eventNumber;
-    unsigned int runNumber;
-                                                                                        
-////////////////////////////////////////////////////////////////////////////////////////    
-
-
-    int bjetNumber, bbjetNumber, blightjetNumber; 
     void initTree(sysName sysType = noSys, bool up = false){
 	_of->file->cd();
 	std::vector<TDirectory*> tmpDirs;
@@ -1352,242 +1524,136 @@ class ttHHanalyzer {
 	tmpDirs.push_back(tree);
 	
         _inputTree = new  TTree("Tree","tree for dnn inputs");
-
-	_inputTree->Branch("bjetPT1", &bjetPT1, "bjetPT1/f");
-	_inputTree->Branch("bjetPT2", &bjetPT2, "bjetPT2/f");	  
-	_inputTree->Branch("bjetPT3", &bjetPT3, "bjetPT3/f");
-	_inputTree->Branch("bjetPT4", &bjetPT4, "bjetPT4/f");	 
-	_inputTree->Branch("bjetPT5", &bjetPT5, "bjetPT5/f");
-	_inputTree->Branch("bjetPT6", &bjetPT6, "bjetPT6/f");	
-	_inputTree->Branch("bjetPT7", &bjetPT7, "bjetPT7/f");	
-	_inputTree->Branch("bjetPT8", &bjetPT8, "bjetPT8/f");	
-	_inputTree->Branch("bjetPT9", &bjetPT9, "bjetPT5/f");
-	_inputTree->Branch("bjetPT10", &bjetPT10, "bjetPT10/f");	
-	_inputTree->Branch("bjetPT11", &bjetPT11, "bjetPT11/f");	
-	_inputTree->Branch("bjetPT12", &bjetPT12, "bjetPT12/f");	
-	_inputTree->Branch("bbjetPT1", &bbjetPT1, "bbjetPT1/f"); 
-	_inputTree->Branch("bbjetPT2", &bbjetPT2, "bbjetPT2/f");
-	_inputTree->Branch("bbjetPT3", &bbjetPT3, "bbjetPT3/f");	
-	_inputTree->Branch("bbjetPT4", &bbjetPT4, "bbjetPT4/f");	 
-	_inputTree->Branch("bbjetPT5", &bbjetPT5, "bbjetPT5/f");
-	_inputTree->Branch("bbjetPT6", &bbjetPT6, "bbjetPT6/f");
-	_inputTree->Branch("bbjetPT7", &bbjetPT7, "bbjetPT7/f");
-	_inputTree->Branch("bbjetPT8", &bbjetPT8, "bbjetPT8/f");
-	_inputTree->Branch("blightjetPT1", &blightjetPT1, "blightjetPT1/f");
-	_inputTree->Branch("blightjetPT2", &blightjetPT2, "blightjetPT2/f");	  
-	_inputTree->Branch("blightjetPT3", &blightjetPT3, "blightjetPT3/f");	
-	_inputTree->Branch("blightjetPT4", &blightjetPT4, "blightjetPT4/f");
-	_inputTree->Branch("blightjetPT5", &blightjetPT5, "blightjetPT5/f");	  
-	_inputTree->Branch("blightjetPT6", &blightjetPT6, "blightjetPT6/f");	
-	_inputTree->Branch("bjetEta1", &bjetEta1, "bjetEta1/f");  
-	_inputTree->Branch("bjetEta2", &bjetEta2, "bjetEta2/f");
-	_inputTree->Branch("bjetEta3", &bjetEta3, "bjetEta3/f");	
-	_inputTree->Branch("bjetEta4", &bjetEta4, "bjetEta4/f");	  
-	_inputTree->Branch("bjetEta5", &bjetEta5, "bjetEta5/f");	
-	_inputTree->Branch("bjetEta6", &bjetEta6, "bjetEta6/f");
-	_inputTree->Branch("bjetEta7", &bjetEta7, "bjetEta7/f");
-	_inputTree->Branch("bjetEta8", &bjetEta8, "bjetEta8/f");
-	_inputTree->Branch("bjetEta9", &bjetEta9, "bjetEta9/f");	
-	_inputTree->Branch("bjetEta10", &bjetEta10, "bjetEta10/f");
-	_inputTree->Branch("bjetEta11", &bjetEta11, "bjetEta11/f");
-	_inputTree->Branch("bjetEta12", &bjetEta12, "bjetEta12/f");
-	_inputTree->Branch("bbjetEta1", &bbjetEta1, "bbjetEta1/f");	 
-	_inputTree->Branch("bbjetEta2", &bbjetEta2, "bbjetEta2/f");	
-	_inputTree->Branch("bbjetEta3", &bbjetEta3, "bbjetEta3/f");	  
-	_inputTree->Branch("bbjetEta4", &bbjetEta4, "bbjetEta4/f");	  
-	_inputTree->Branch("bbjetEta5", &bbjetEta5, "bbjetEta5/f");	
-	_inputTree->Branch("bbjetEta6", &bbjetEta6, "bbjetEta6/f");  
-	_inputTree->Branch("bbjetEta7", &bbjetEta7, "bbjetEta7/f");  
-	_inputTree->Branch("bbjetEta8", &bbjetEta8, "bbjetEta8/f");  
-	_inputTree->Branch("bbjetPhi1", &bbjetPhi1, "bbjetPhi1/f");  
-	_inputTree->Branch("bbjetPhi2", &bbjetPhi2, "bbjetPhi2/f");
-	_inputTree->Branch("bbjetPhi3", &bbjetPhi3, "bbjetPhi3/f");	
-	_inputTree->Branch("bbjetPhi4", &bbjetPhi4, "bbjetPhi4/f");	  
-	_inputTree->Branch("bbjetPhi5", &bbjetPhi5, "bbjetPhi5/f");	
-	_inputTree->Branch("bbjetPhi6", &bbjetPhi6, "bbjetPhi6/f");
-	_inputTree->Branch("bbjetPhi7", &bbjetPhi7, "bbjetPhi7/f");
-	_inputTree->Branch("bbjetPhi8", &bbjetPhi8, "bbjetPhi8/f");
-	_inputTree->Branch("blightjetEta1", &blightjetEta1, "blightjetEta1/f");
-	_inputTree->Branch("blightjetEta2", &blightjetEta2, "blightjetEta2/f");	  
-	_inputTree->Branch("blightjetEta3", &blightjetEta3, "blightjetEta3/f");	
-	_inputTree->Branch("blightjetEta4", &blightjetEta4, "blightjetEta4/f");
-	_inputTree->Branch("blightjetEta5", &blightjetEta5, "blightjetEta5/f");	  
-	_inputTree->Branch("blightjetEta6", &blightjetEta6, "blightjetEta6/f");	
-	_inputTree->Branch("bjetBTagDisc1", &bjetBTagDisc1, "bjetBTagDisc1/f");  
-	_inputTree->Branch("bjetBTagDisc2", &bjetBTagDisc2, "bjetBTagDisc2/f");  
-	_inputTree->Branch("bjetBTagDisc3", &bjetBTagDisc3, "bjetBTagDisc3/f");  
-	_inputTree->Branch("bjetBTagDisc4", &bjetBTagDisc4, "bjetBTagDisc4/f");  
-	_inputTree->Branch("bjetBTagDisc5", &bjetBTagDisc5, "bjetBTagDisc5/f");  
-	_inputTree->Branch("bjetBTagDisc6", &bjetBTagDisc6, "bjetBTagDisc6/f");  
-	_inputTree->Branch("bjetBTagDisc7", &bjetBTagDisc7, "bjetBTagDisc7/f");  
-	_inputTree->Branch("bjetBTagDisc8", &bjetBTagDisc8, "bjetBTagDisc8/f");  
-	_inputTree->Branch("bjetBTagDisc9", &bjetBTagDisc9, "bjetBTagDisc9/f");  
-	_inputTree->Branch("bjetBTagDisc10", &bjetBTagDisc10, "bjetBTagDisc10/f");  
-	_inputTree->Branch("bjetBTagDisc11", &bjetBTagDisc11, "bjetBTagDisc11/f");  
-	_inputTree->Branch("bjetBTagDisc12", &bjetBTagDisc12, "bjetBTagDisc12/f");  
-	_inputTree->Branch("bbjetBTagDisc1", &bbjetBTagDisc1, "bbjetBTagDisc1/f");  
-	_inputTree->Branch("bbjetBTagDisc2", &bbjetBTagDisc2, "bbjetBTagDisc2/f");  
-	_inputTree->Branch("bbjetBTagDisc3", &bbjetBTagDisc3, "bbjetBTagDisc3/f");  
-	_inputTree->Branch("bbjetBTagDisc4", &bbjetBTagDisc4, "bbjetBTagDisc4/f");  
-	_inputTree->Branch("bbjetBTagDisc5", &bbjetBTagDisc5, "bbjetBTagDisc5/f");  
-	_inputTree->Branch("bbjetBTagDisc6", &bbjetBTagDisc6, "bbjetBTagDisc6/f");  
-	_inputTree->Branch("bbjetBTagDisc7", &bbjetBTagDisc7, "bbjetBTagDisc7/f");  
-	_inputTree->Branch("bbjetBTagDisc8", &bbjetBTagDisc8, "bbjetBTagDisc8/f");  
-	_inputTree->Branch("blightjetBTagDisc1", &blightjetBTagDisc1, "blightjetBTagDisc1/f");  
-	_inputTree->Branch("blightjetBTagDisc2", &blightjetBTagDisc2, "blightjetBTagDisc2/f");  
-	_inputTree->Branch("blightjetBTagDisc3", &blightjetBTagDisc3, "blightjetBTagDisc3/f");  
-	_inputTree->Branch("blightjetBTagDisc4", &blightjetBTagDisc4, "blightjetBTagDisc4/f");  
-	_inputTree->Branch("blightjetBTagDisc5", &blightjetBTagDisc5, "blightjetBTagDisc5/f");  
-	_inputTree->Branch("blightjetBTagDisc6", &blightjetBTagDisc6, "blightjetBTagDisc6/f");  
-	_inputTree->Branch("bmet", &bmet, "bmet/f");    
-	_inputTree->Branch("bmetPhi", &bmetPhi, "bmetPhi/f");    
-	_inputTree->Branch("baverageDeltaRjj", &baverageDeltaRjj, "baverageDeltaRjj/f"); 
-	_inputTree->Branch("baverageDeltaRbb", &baverageDeltaRbb, "baverageDeltaRbb/f"); 
-	_inputTree->Branch("baverageDeltaEtajj", &baverageDeltaEtajj, "baverageDeltaEtajj/f"); 
-	_inputTree->Branch("baverageDeltaEtabb", &baverageDeltaEtabb, "baverageDeltaEtabb/f"); 
-	_inputTree->Branch("bminDeltaRjj", &bminDeltaRjj, "bminDeltaRjj/f"); 
-	_inputTree->Branch("bminDeltaRbb", &bminDeltaRbb, "bminDeltaRbb/f"); 
-	_inputTree->Branch("bmaxDeltaEtabb", &bmaxDeltaEtabb, "bmaxDeltaEtabb/f"); 
-	_inputTree->Branch("bmaxDeltaEtajj", &bmaxDeltaEtajj, "bmaxDeltaEtajj/f"); 
-	_inputTree->Branch("bmaxDeltaEtabj", &bmaxDeltaEtabj, "bmaxDeltaEtabj/f"); 
-	_inputTree->Branch("bminDeltaRbj", &bminDeltaRbj, "bminDeltaRbj/f"); 
-	_inputTree->Branch("baverageDeltaEtabj", &baverageDeltaEtabj, "baverageDeltaEtabj/f"); 
-	_inputTree->Branch("baverageDeltaRbj", &baverageDeltaRbj, "baverageDeltaRbj/f"); 
-	_inputTree->Branch("bminDeltaRMassjj", &bminDeltaRMassjj, "bminDeltaRMassjj/f"); 
-	_inputTree->Branch("bminDeltaRMassbb", &bminDeltaRMassbb, "bminDeltaRMassbb/f"); 
-	_inputTree->Branch("bminDeltaRMassbj", &bminDeltaRMassbj, "bminDeltaRMassbj/f"); 
-	_inputTree->Branch("bminDeltaRpTjj", &bminDeltaRpTjj, "bminDeltaRpTjj/f"); 
-	_inputTree->Branch("bminDeltaRpTbb", &bminDeltaRpTbb, "bminDeltaRpTbb/f"); 
-	_inputTree->Branch("bminDeltaRpTbj", &bminDeltaRpTbj, "bminDeltaRpTbj/f"); 
-	_inputTree->Branch("bmaxPTmassjjj", &bmaxPTmassjjj, "bmaxPTmassjjj/f"); 
-	_inputTree->Branch("bmaxPTmassjbb", &bmaxPTmassjbb, "bmaxPTmassjbb/f"); 
-	_inputTree->Branch("bH0", &bH0, "bH0/f");
-	_inputTree->Branch("bH1", &bH1, "bH1/f");
-	_inputTree->Branch("bH2", &bH2, "bH2/f");
-	_inputTree->Branch("bH3", &bH3, "bH3/f");
-	_inputTree->Branch("bH4", &bH4, "bH4/f");
-	_inputTree->Branch("bbH0", &bbH0, "bbH0/f");
-	_inputTree->Branch("bbH1", &bbH1, "bbH1/f");
-	_inputTree->Branch("bbH2", &bbH2, "bbH2/f");
-	_inputTree->Branch("bbH3", &bbH3, "bbH3/f");
-	_inputTree->Branch("bbH4", &bbH4, "bbH4/f");
-	_inputTree->Branch("bR1", &bR1, "bR1/f");
-	_inputTree->Branch("bR2", &bR2, "bR2/f");
-	_inputTree->Branch("bR3", &bR3, "bR3/f");
-	_inputTree->Branch("bR4", &bR4, "bR4/f");
-	_inputTree->Branch("bbR1", &bbR1, "bbR1/f");
-	_inputTree->Branch("bbR2", &bbR2, "bbR2/f");
-	_inputTree->Branch("bbR3", &bbR3, "bbR3/f");
-	_inputTree->Branch("bbR4", &bbR4, "bbR4/f");
-	_inputTree->Branch("bjetAverageMass", &bjetAverageMass, "bjetAverageMass/f");
-	_inputTree->Branch("bbJetAverageMass", &bbJetAverageMass, "bbJetAverageMass/f");
-	_inputTree->Branch("bbJetAverageMassSqr", &bbJetAverageMassSqr, "bbJetAverageMassSqr/f");
-	_inputTree->Branch("bjetHT", &bjetHT, "bjetHT/f");
-	_inputTree->Branch("bbjetHT", &bbjetHT, "bbjetHT/f");
-	_inputTree->Branch("blightjetHT", &blightjetHT, "blightjetHT/f");
-	_inputTree->Branch("bjetNumber", &bjetNumber, "bjetNumber/i");
-	_inputTree->Branch("bbjetNumber", &bbjetNumber, "bbjetNumber/i");
-	_inputTree->Branch("blightjetNumber", &blightjetNumber, "blightjetNumber/i");
-	_inputTree->Branch("binvMassZ1", &binvMassZ1, "binvMassZ1/f");
-	_inputTree->Branch("binvMassZ2", &binvMassZ2, "binvMassZ2/f");
-	_inputTree->Branch("binvMassH1", &binvMassH1, "binvMassH1/f");
-	_inputTree->Branch("binvMassH2", &binvMassH2, "binvMassH2/f");
-	_inputTree->Branch("bchi2Higgs", &bchi2Higgs, "bchi2Higgs/f");
-	_inputTree->Branch("bchi2HadW", &bchi2HadW, "bchi2HadW/f");
-	_inputTree->Branch("bchi2Z", &bchi2Z, "bchi2Z/f");
-	_inputTree->Branch("bchi2HiggsZ", &bchi2HiggsZ, "bchi2HiggsZ/f");
-	_inputTree->Branch("binvMassHiggsZ1", &binvMassHiggsZ1, "binvMassHiggsZ1/f");
-	_inputTree->Branch("binvMassHiggsZ2", &binvMassHiggsZ2, "binvMassHiggsZ2/f");
-	_inputTree->Branch("bPTH1", &bPTH1, "bPTH1/f");
-	_inputTree->Branch("bPTH2", &bPTH2, "bPTH2/f");
-
-
-	_inputTree->Branch("bcentralityjl", &bcentralityjl, "bcentralityjl/f");
-	_inputTree->Branch("bcentralityjb", &bcentralityjb, "bcentralityjb/f");
-	_inputTree->Branch("baplanarity", &baplanarity, "baplanarity/f");
-	_inputTree->Branch("bsphericity", &bsphericity, "bsphericity/f");
-	_inputTree->Branch("btransSphericity", &btransSphericity, "btransSphericity/f");
-	_inputTree->Branch("bcValue", &bcValue, "bcValue/f");
-	_inputTree->Branch("bdValue", &bdValue, "bdValue/f");
-	_inputTree->Branch("bbaplanarity", &bbaplanarity, "bbaplanarity/f");
-	_inputTree->Branch("bbsphericity", &bbsphericity, "bbsphericity/f");
-	_inputTree->Branch("bbtransSphericity", &bbtransSphericity, "bbtransSphericity/f");
-	_inputTree->Branch("bbcValue", &bbcValue, "bbcValue/f");
-	_inputTree->Branch("bbdValue", &bbdValue, "bbdValue/f");
-	////_inputTree->Branch("passHadTrig", &passHadTrig, "passHadTrig/O");
-
-	_inputTree->Branch("bweight", &bweight, "bweight/f");
-
-	_inputTree->Branch("bleptonPT1", &bleptonPT1, "bleptonPT1/f");
-	_inputTree->Branch("bmuonPT1", &bmuonPT1, "bmuonPT1/f");
-	_inputTree->Branch("belePT1", &belePT1, "belePT1/f");
-	_inputTree->Branch("bleptonEta1", &bleptonEta1, "bleptonEta1/f");
-	_inputTree->Branch("bmuonEta1", &bmuonEta1, "bmuonEta1/f");
-	_inputTree->Branch("beleEta1", &beleEta1, "beleEta1/f");
-	_inputTree->Branch("bleptonPT2", &bleptonPT2, "bleptonPT2/f");
-	_inputTree->Branch("bmuonPT2", &bmuonPT2, "bmuonPT2/f");
-	_inputTree->Branch("belePT2", &belePT2, "belePT2/f");
-	_inputTree->Branch("bleptonEta2", &bleptonEta2, "bleptonEta2/f");
-	_inputTree->Branch("bmuonEta2", &bmuonEta2, "bmuonEta2/f");
-	_inputTree->Branch("beleEta2", &beleEta2, "beleEta2/f");
-	_inputTree->Branch("bdiElectronMass", &bdiElectronMass, "bdiElectronMass/f");
-	_inputTree->Branch("bdiMuonMass", &bdiMuonMass, "bdiMuonMass/f");
-	_inputTree->Branch("bleptonHT", &bleptonHT, "bleptonHT/f");
-	_inputTree->Branch("bST", &bST, "bST/f");
-	_inputTree->Branch("bleptonCharge1", &bleptonCharge1, "bleptonCharge1/f");
-	_inputTree->Branch("bleptonCharge2", &bleptonCharge2, "bleptonCharge2/f");
-
-	_inputTree->Branch("bbjetHiggsMatched1", &bbjetHiggsMatched1, "bbjetHiggsMatched1/f");
-	_inputTree->Branch("bbjetHiggsMatched2", &bbjetHiggsMatched2, "bbjetHiggsMatched2/f");
-	_inputTree->Branch("bbjetHiggsMatched3", &bbjetHiggsMatched3, "bbjetHiggsMatched3/f");
-	_inputTree->Branch("bbjetHiggsMatched4", &bbjetHiggsMatched4, "bbjetHiggsMatched4/f");
-	_inputTree->Branch("bbjetHiggsMatched5", &bbjetHiggsMatched5, "bbjetHiggsMatched5/f");
-	_inputTree->Branch("bbjetHiggsMatched6", &bbjetHiggsMatched6, "bbjetHiggsMatched6/f");
-	_inputTree->Branch("bbjetHiggsMatched7", &bbjetHiggsMatched7, "bbjetHiggsMatched7/f");
-	_inputTree->Branch("bbjetHiggsMatched8", &bbjetHiggsMatched8, "bbjetHiggsMatched8/f");
-
-	_inputTree->Branch("bbjetHiggsMatcheddR1", &bbjetHiggsMatcheddR1, "bbjetHiggsMatcheddR1/f");
-	_inputTree->Branch("bbjetHiggsMatcheddR2", &bbjetHiggsMatcheddR2, "bbjetHiggsMatcheddR2/f");
-	_inputTree->Branch("bbjetHiggsMatcheddR3", &bbjetHiggsMatcheddR3, "bbjetHiggsMatcheddR3/f");
-	_inputTree->Branch("bbjetHiggsMatcheddR4", &bbjetHiggsMatcheddR4, "bbjetHiggsMatcheddR4/f");
-	_inputTree->Branch("bbjetHiggsMatcheddR5", &bbjetHiggsMatcheddR5, "bbjetHiggsMatcheddR5/f");
-	_inputTree->Branch("bbjetHiggsMatcheddR6", &bbjetHiggsMatcheddR6, "bbjetHiggsMatcheddR6/f");
-	_inputTree->Branch("bbjetHiggsMatcheddR7", &bbjetHiggsMatcheddR7, "bbjetHiggsMatcheddR7/f");
-	_inputTree->Branch("bbjetHiggsMatcheddR8", &bbjetHiggsMatcheddR8, "bbjetHiggsMatcheddR8/f");
-
-	_inputTree->Branch("bbjetMinChiHiggsIndex1", &bbjetMinChiHiggsIndex1, "bbjetMinChiHiggsIndex1/f");
-	_inputTree->Branch("bbjetMinChiHiggsIndex2", &bbjetMinChiHiggsIndex2, "bbjetMinChiHiggsIndex2/f");
-	_inputTree->Branch("bbjetMinChiHiggsIndex3", &bbjetMinChiHiggsIndex3, "bbjetMinChiHiggsIndex3/f");
-	_inputTree->Branch("bbjetMinChiHiggsIndex4", &bbjetMinChiHiggsIndex4, "bbjetMinChiHiggsIndex4/f");
-	_inputTree->Branch("bbjetMinChiHiggsIndex5", &bbjetMinChiHiggsIndex5, "bbjetMinChiHiggsIndex5/f");
-	_inputTree->Branch("bbjetMinChiHiggsIndex6", &bbjetMinChiHiggsIndex6, "bbjetMinChiHiggsIndex6/f");
-	_inputTree->Branch("bbjetMinChiHiggsIndex7", &bbjetMinChiHiggsIndex7, "bbjetMinChiHiggsIndex7/f");
-	_inputTree->Branch("bbjetMinChiHiggsIndex8", &bbjetMinChiHiggsIndex8, "bbjetMinChiHiggsIndex8/f");
+	_friendTree = cut["friendTree"];
+
+	typedef TreeSchema<event>::field<objectJet> jetField;
+	const jetField pt = {"pt", [](objectJet * jet){ return (float)jet->getp4()->Pt(); }};
+	const jetField eta = {"eta", [](objectJet * jet){ return (float)jet->getp4()->Eta(); }};
+	const jetField phi = {"phi", [](objectJet * jet){ return (float)jet->getp4()->Phi(); }};
+	const jetField btag = {"btag", [](objectJet * jet){ return jet->bTagCSV; }};
+
+	// Jet_*[nJet], bJet_*[nbJet], LightJet_*[nLightJet]
+	_treeSchema.collection<objectJet>("Jet", 30, [](event * thisEvent){ return thisEvent->getSelJets(); }, {pt, eta, btag});
+	_treeSchema.collection<objectJet>("bJet", 12, [](event * thisEvent){ return thisEvent->getSelbJets(); },
+					  {pt, eta, phi, btag,
+					   {"higgsMatched", [](objectJet * jet){ return (float)jet->matchedtoHiggs; }},
+					   {"higgsMatcheddR", [](objectJet * jet){ return jet->matchedtoHiggsdR; }},
+					   {"minChiHiggsIndex", [](objectJet * jet){ return (float)jet->minChiHiggsIndex; }}});
+	_treeSchema.collection<objectJet>("LightJet", 12, [](event * thisEvent){ return thisEvent->getSelLightJets(); }, {pt, eta, btag});
+
+	_treeSchema.scalar("bmet", 'f', [](event * thisEvent){ return thisEvent->getMET()->getp4()->Pt(); });
+	_treeSchema.scalar("bweight", 'f', &_weight);
+	_treeSchema.scalar("baverageDeltaRjj", 'f', &jetStat.meandR);
+	_treeSchema.scalar("baverageDeltaRbb", 'f', &bjetStat.meandR);
+	_treeSchema.scalar("baverageDeltaRbj", 'f', &bjStat.meandR);
+	_treeSchema.scalar("baverageDeltaEtajj", 'f', &jetStat.meandEta);
+	_treeSchema.scalar("baverageDeltaEtabb", 'f', &bjetStat.meandEta);
+	_treeSchema.scalar("baverageDeltaEtabj", 'f', &bjStat.meandEta);
+	_treeSchema.scalar("bminDeltaRjj", 'f', &jetStat.mindR);
+	_treeSchema.scalar("bminDeltaRbb", 'f', &bjetStat.mindR);
+	_treeSchema.scalar("bminDeltaRbj", 'f', &bjStat.mindR);
+	_treeSchema.scalar("bmaxDeltaEtajj", 'f', &jetStat.maxdEta);
+	_treeSchema.scalar("bmaxDeltaEtabb", 'f', &bjetStat.maxdEta);
+	_treeSchema.scalar("bmaxDeltaEtabj", 'f', &bjStat.maxdEta);
+	_treeSchema.scalar("bminDeltaRMassjj", 'f', &jetStat.mindRMass);
+	_treeSchema.scalar("bminDeltaRMassbb", 'f', &bjetStat.mindRMass);
+	_treeSchema.scalar("bminDeltaRMassbj", 'f', &bjStat.mindRMass);
+	_treeSchema.scalar("bminDeltaRpTjj", 'f', &jetStat.mindRpT);
+	_treeSchema.scalar("bminDeltaRpTbb", 'f', &bjetStat.mindRpT);
+	_treeSchema.scalar("bminDeltaRpTbj", 'f', &bjStat.mindRpT);
+	_treeSchema.scalar("bmaxPTmassjjj", 'f', &jjjMaxs.maxPTmass);
+	_treeSchema.scalar("bmaxPTmassjbb", 'f', &jbbMaxs.maxPTmass);
+	_treeSchema.scalar("bH0", 'f', &jetFoxWolfMom.h0);
+	_treeSchema.scalar("bH1", 'f', &jetFoxWolfMom.h1);
+	_treeSchema.scalar("bH2", 'f', &jetFoxWolfMom.h2);
+	_treeSchema.scalar("bH3", 'f', &jetFoxWolfMom.h3);
+	_treeSchema.scalar("bH4", 'f', &jetFoxWolfMom.h4);
+	_treeSchema.scalar("bbH0", 'f', &bjetFoxWolfMom.h0);
+	_treeSchema.scalar("bbH1", 'f', &bjetFoxWolfMom.h1);
+	_treeSchema.scalar("bbH2", 'f', &bjetFoxWolfMom.h2);
+	_treeSchema.scalar("bbH3", 'f', &bjetFoxWolfMom.h3);
+	_treeSchema.scalar("bbH4", 'f', &bjetFoxWolfMom.h4);
+	_treeSchema.scalar("bR1", 'f', &jetFoxWolfMom.r1);
+	_treeSchema.scalar("bR2", 'f', &jetFoxWolfMom.r2);
+	_treeSchema.scalar("bR3", 'f', &jetFoxWolfMom.r3);
+	_treeSchema.scalar("bR4", 'f', &jetFoxWolfMom.r4);
+	_treeSchema.scalar("bbR1", 'f', &bjetFoxWolfMom.r1);
+	_treeSchema.scalar("bbR2", 'f', &bjetFoxWolfMom.r2);
+	_treeSchema.scalar("bbR3", 'f', &bjetFoxWolfMom.r3);
+	_treeSchema.scalar("bbR4", 'f', &bjetFoxWolfMom.r4);
+	_treeSchema.scalar("bjetAverageMass", 'f', [](event * thisEvent){ return thisEvent->getSumSelJetMass()/thisEvent->getnSelJet(); });
+	_treeSchema.scalar("bbJetAverageMass", 'f', [](event * thisEvent){ return thisEvent->getSumSelbJetMass()/thisEvent->getnbJet(); });
+	_treeSchema.scalar("bbJetAverageMassSqr", 'f', [](event * thisEvent){ return (thisEvent->getSumSelbJetMass()*thisEvent->getSumSelbJetMass())/thisEvent->getnbJet(); });
+	_treeSchema.scalar("bjetHT", 'f', [](event * thisEvent){ return thisEvent->getSumSelJetScalarpT(); });
+	_treeSchema.scalar("bbjetHT", 'f', [](event * thisEvent){ return thisEvent->getSumSelbJetScalarpT(); });
+	_treeSchema.scalar("blightjetHT", 'f', [](event * thisEvent){ return thisEvent->getSumSelLightJetScalarpT(); });
+	_treeSchema.scalar("binvMassZ1", 'f', &_bbMassMin1Z);
+	_treeSchema.scalar("binvMassZ2", 'f', &_bbMassMin2Z);
+	_treeSchema.scalar("binvMassH1", 'f', &_bbMassMin1Higgs);
+	_treeSchema.scalar("binvMassH2", 'f', &_bbMassMin2Higgs);
+	_treeSchema.scalar("bchi2Higgs", 'f', &_minChi2Higgs);
+	_treeSchema.scalar("bchi2Z", 'f', &_minChi2Z);
+	_treeSchema.scalar("bchi2HiggsZ", 'f', &_minChi2HiggsZ);
+	_treeSchema.scalar("binvMassHiggsZ1", 'f', &_bbMassMin1HiggsZ);
+	_treeSchema.scalar("binvMassHiggsZ2", 'f', &_bbMassMin2HiggsZ);
+	_treeSchema.scalar("bPTH1", 'f', &_bpTHiggs1);
+	_treeSchema.scalar("bPTH2", 'f', &_bpTHiggs2);
+	_treeSchema.scalar("bcentralityjl", 'f', &jlepCent.centrality);
+	_treeSchema.scalar("bcentralityjb", 'f', &jbjetCent.centrality);
+	_treeSchema.scalar("baplanarity", 'f', [](event * thisEvent){ return thisEvent->eventShapeJet->getAplanarity(); });
+	_treeSchema.scalar("bsphericity", 'f', [](event * thisEvent){ return thisEvent->eventShapeJet->getSphericity(); });
+	_treeSchema.scalar("btransSphericity", 'f', [](event * thisEvent){ return thisEvent->eventShapeJet->getTransSphericity(); });
+	_treeSchema.scalar("bcValue", 'f', [](event * thisEvent){ return thisEvent->eventShapeJet->getC(); });
+	_treeSchema.scalar("bdValue", 'f', [](event * thisEvent){ return thisEvent->eventShapeJet->getD(); });
+	_treeSchema.scalar("bbaplanarity", 'f', [](event * thisEvent){ return thisEvent->eventShapeBjet->getAplanarity(); });
+	_treeSchema.scalar("bbsphericity", 'f', [](event * thisEvent){ return thisEvent->eventShapeBjet->getSphericity(); });
+	_treeSchema.scalar("bbtransSphericity", 'f', [](event * thisEvent){ return thisEvent->eventShapeBjet->getTransSphericity(); });
+	_treeSchema.scalar("bbcValue", 'f', [](event * thisEvent){ return thisEvent->eventShapeBjet->getC(); });
+	_treeSchema.scalar("bbdValue", 'f', [](event * thisEvent){ return thisEvent->eventShapeBjet->getD(); });
 
 ////////////////////////////////////////////////////////////////////////////////////////    
         // Branch for Trigger Path                                                        
-        _inputTree->Branch("passTrigger_HLT_IsoMu27", &passTrigger_HLT_IsoMu27, "passTrigger_HLT_IsoMu27/O");
-        _inputTree->Branch("passTrigger_HLT_PFHT1050", &passTrigger_HLT_PFHT1050, "passTrigger_HLT_PFHT1050/O");
-        _inputTree->Branch("passTrigger_6J1T_B", &passTrigger_6J1T_B, "passTrigger_6J1T_B/O");
-        _inputTree->Branch("passTrigger_6J1T_CDEF", &passTrigger_6J1T_CDEF, "passTrigger_6J1T_CDEF/O");
-        _inputTree->Branch("passTrigger_6J2T_B", &passTrigger_6J2T_B, "passTrigger_6J2T_B/O");
-        _inputTree->Branch("passTrigger_6J2T_CDEF", &passTrigger_6J2T_CDEF, "passTrigger_6J2T_CDEF/O");
-        _inputTree->Branch("passTrigger_4J3T_B", &passTrigger_4J3T_B, "passTrigger_4J3T_B/O");
-        _inputTree->Branch("passTrigger_4J3T_CDEF", &passTrigger_4J3T_CDEF, "passTrigger_4J3T_CDEF/O");
-
-        _inputTree->Branch("nMuons", &nMuons, "nMuons/I");
-        _inputTree->Branch("nElecs", &nElecs, "nElecs/I");
-        _inputTree->Branch("nJets", &nJets, "nJets/I");
-        _inputTree->Branch("nbJets", &nbJets, "nbJets/I");
-        _inputTree->Branch("HT", &HT, "HT/F");
-        _inputTree->Branch("jetPt", jetPt, "jetPt[nJets]/F");
-        _inputTree->Branch("jetEta", jetEta, "jetEta[nJets]/F");
-        _inputTree->Branch("bTagScore", bTagScore, "bTagScore[nJets]/F");
-
-	_inputTree->Branch("eventNumber", &eventNumber, "eventNumber/i");
-        _inputTree->Branch("runNumber", &runNumber, "runNumber/i");
+	// (copies of input branches, not needed next to the input in a friend tree)
+	if(!_friendTree){
+	    _treeSchema.scalar("passTrigger_HLT_IsoMu27", 'O', [this](event *){ return _ev->HLT_IsoMu27; }); // Reference Muon Trigger
+	    _treeSchema.scalar("passTrigger_HLT_PFHT1050", 'O', [this](event *){ return _ev->HLT_PFHT1050; });
+	    _treeSchema.scalar("passTrigger_6J1T_B", 'O', [this](event *){ return _ev->HLT_PFHT430_SixJet40_BTagCSV_p080; });
+	    _treeSchema.scalar("passTrigger_6J1T_CDEF", 'O', [this](event *){ return _ev->HLT_PFHT430_SixPFJet40_PFBTagCSV_1p5; });
+	    _treeSchema.scalar("passTrigger_6J2T_B", 'O', [this](event *){ return _ev->HLT_PFHT380_SixJet32_DoubleBTagCSV_p075; });
+	    _treeSchema.scalar("passTrigger_6J2T_CDEF", 'O', [this](event *){ return _ev->HLT_PFHT380_SixPFJet32_DoublePFBTagCSV_2p2; });
+	    _treeSchema.scalar("passTrigger_4J3T_B", 'O', [this](event *){ return _ev->HLT_HT300PT30_QuadJet_75_60_45_40_TripeCSV_p07; });
+	    _treeSchema.scalar("passTrigger_4J3T_CDEF", 'O', [this](event *){ return _ev->HLT_PFHT300PT30_QuadPFJet_75_60_45_40_TriplePFBTagCSV_3p0; });
+	}
 
+	_treeSchema.scalar("nMuons", 'I', [](event * thisEvent){ return thisEvent->getnSelMuon(); });
+	_treeSchema.scalar("nElecs", 'I', [](event * thisEvent){ return thisEvent->getnSelElectron(); });
+	_treeSchema.scalar("HT", 'F', [](event * thisEvent){ return thisEvent->getSumSelJetScalarpT(); });
+	if(!_friendTree){
+	    _treeSchema.scalar("eventNumber", 'i', [this](event *){ return _ev->event; });
+	    _treeSchema.scalar("runNumber", 'i', [this](event *){ return _ev->run; });
+	}
+
+	// optional branch list, glob patterns; without it every branch is written
+	std::vector<std::string> patterns;
+	if(TreeSchema<event>::readPatterns("AnalyzerConfig/TreeBranches.txt", patterns) && !patterns.empty()){
+	    _treeSchema.select(patterns);
+	    std::cout << "Tree branches from AnalyzerConfig/TreeBranches.txt: " << _treeSchema.nScalars() << " scalars, " << _treeSchema.nCollections() << " collections" << std::endl;
+	}
+	_treeMinChiHiggs = _treeSchema.has("bJet_minChiHiggsIndex");
+	// join keys, whatever the branch list
+	if(_friendTree == 1) _treeSchema.scalar("passSelection", 'O', &_passSelection);
+	if(_friendTree == 2) _treeSchema.scalar("inputEntry", 'L', &_inputEntry);
+	_treeSchema.branch(_inputTree);
 	_treeDirs = tmpDirs;
+
+	_columnObjects = cut["columnExport"];
+	if(_columnObjects > 0 && !_treeSchema.empty()){
+	    std::string prefix = _cl;
+	    if(prefix.size() > 5 && prefix.substr(prefix.size()-5) == ".root") prefix.resize(prefix.size()-5);
+	    std::vector<std::string> names = _treeSchema.columnNames(_columnObjects);
+	    _columnRow.resize(names.size());
+	    _columns = new ColumnExporter(prefix, names);
+	}
     }
 };	
 #endif